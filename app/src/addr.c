@@ -21,6 +21,7 @@
 #include "zxformat.h"
 #include "app_mode.h"
 #include "crypto.h"
+#include "profile.h"
 
 #if defined(LEDGER_SPECIFIC)
 zxerr_t addr_getNumItems(uint8_t *num_items) {
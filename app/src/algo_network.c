@@ -0,0 +1,46 @@
+#include "algo_network.h"
+#include <string.h>
+
+#define ARRAY_SIZE(__arr)   (sizeof(__arr) / sizeof(__arr[0]))
+
+#define ALGO_NETWORK(__name, __id, ...) { \
+        .genesisHash = { __VA_ARGS__ }, \
+        .genesisID   = __id, \
+        .name        = __name, \
+    }
+
+// Private networks (LocalNet, sandboxes) get a fresh genesis on every deployment, so they
+// cannot be listed and keep showing their hash
+static const algo_network_info_t algo_networks[] = {
+    ALGO_NETWORK("MainNet", "mainnet-v1.0",
+                 0xc0, 0x61, 0xc4, 0xd8, 0xfc, 0x1d, 0xbd, 0xde, 0xd2, 0xd7, 0x60, 0x4b, 0xe4, 0x56, 0x8e, 0x3f,
+                 0x6d, 0x04, 0x19, 0x87, 0xac, 0x37, 0xbd, 0xe4, 0xb6, 0x20, 0xb5, 0xab, 0x39, 0x24, 0x8a, 0xdf),
+    ALGO_NETWORK("TestNet", "testnet-v1.0",
+                 0x48, 0x63, 0xb5, 0x18, 0xa4, 0xb3, 0xc8, 0x4e, 0xc8, 0x10, 0xf2, 0x2d, 0x4f, 0x10, 0x81, 0xcb,
+                 0x0f, 0x71, 0xf0, 0x59, 0xa7, 0xac, 0x20, 0xde, 0xc6, 0x2f, 0x7f, 0x70, 0xe5, 0x09, 0x3a, 0x22),
+    ALGO_NETWORK("BetaNet", "betanet-v1.0",
+                 0x98, 0x58, 0x1a, 0xcc, 0x5f, 0xb6, 0xb9, 0x14, 0xb5, 0xb4, 0xc8, 0x8b, 0xf5, 0xdb, 0x23, 0xd3,
+                 0x58, 0x49, 0x1b, 0x24, 0x84, 0x98, 0xf3, 0x76, 0xf0, 0x1f, 0xd3, 0x8e, 0x3b, 0xe9, 0x55, 0x6d),
+    ALGO_NETWORK("Voi MainNet", "voimain-v1.0",
+                 0xaf, 0x6d, 0x1f, 0x49, 0x02, 0x3c, 0x81, 0x67, 0xbf, 0x90, 0x56, 0x73, 0x88, 0xda, 0x27, 0x48,
+                 0xf0, 0x97, 0x2f, 0x07, 0x10, 0x98, 0x7f, 0xe7, 0xc5, 0x13, 0xaf, 0x9e, 0x7b, 0x9e, 0x58, 0xe9),
+};
+
+
+const algo_network_info_t *
+algo_network_get(const uint8_t *genesisHash)
+{
+    const algo_network_info_t *p;
+    const algo_network_info_t *endp = algo_networks + ARRAY_SIZE(algo_networks);
+
+    if (genesisHash == NULL) {
+        return NULL;
+    }
+
+    for (p = algo_networks; p < endp; p++) {
+        if (memcmp(p->genesisHash, genesisHash, GENESIS_HASH_LEN) == 0) {
+            return p;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,17 @@
+#ifndef __ALGO_NETWORK_H__
+#define __ALGO_NETWORK_H__
+
+#include <stdint.h>
+
+#define GENESIS_HASH_LEN 32
+
+typedef struct {
+    uint8_t         genesisHash[GENESIS_HASH_LEN];
+    const char      genesisID[16];
+    const char      name[16];
+} algo_network_info_t;
+
+
+const algo_network_info_t *algo_network_get(const uint8_t *genesisHash);
+
+#endif
@@ -28,17 +28,25 @@
 #include "tx.h"
 #include "addr.h"
 #include "crypto.h"
+#include "key_cache.h"
+#include "trace.h"
+#include "parser_group.h"
 #include "coin.h"
 #include "common/parser.h"
 #include "zxmacros.h"
 
 #define SERIALIZED_HDPATH_LENGTH (sizeof(uint32_t) * HDPATH_LEN_DEFAULT)
+#define PUBLIC_KEYS_REQUEST_LENGTH (ACCOUNT_ID_LENGTH + 1)
+#define PUBLIC_KEYS_PER_APDU ((IO_APDU_BUFFER_SIZE - 3) / PK_LEN_25519)
+#define VALIDATE_SUMMARY_LEN (1 + 2 + 1 + 1 + TXID_LEN)
 
 static bool tx_initialized = false;
+static bool group_initialized = false;
 static const unsigned char tmpBuff[] = {'T', 'X'};
 
 void extractHDPath(uint32_t rx, uint32_t offset) {
     tx_initialized = false;
+    group_initialized = false;
 
     if ((rx - offset) < SERIALIZED_HDPATH_LENGTH) {
         THROW(APDU_CODE_WRONG_LENGTH);
@@ -87,6 +95,7 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
     if (rx < OFFSET_DATA) {
         THROW(APDU_CODE_WRONG_LENGTH);
     }
+    TRACE_EVENT(TRACE_CHUNK, rx - OFFSET_DATA);
 
     uint32_t added;
     switch (p1) {
@@ -121,78 +130,108 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
     THROW(APDU_CODE_INVALIDP1P2);
 }
 
+// Appends a chunk of INS_SIGN_MSGPACK payload, decoding it first in delta mode
+__Z_INLINE uint16_t append_legacy_chunk(uint8_t *data, uint32_t length)
+{
+    if (!tx_delta_active()) {
+        return tx_append(data, length) == length ? APDU_CODE_OK : APDU_CODE_OUTPUT_BUFFER_TOO_SMALL;
+    }
+    const zxerr_t err = tx_delta_append(data, length);
+    if (err != zxerr_ok) {
+        return err == zxerr_buffer_too_small ? APDU_CODE_OUTPUT_BUFFER_TOO_SMALL : APDU_CODE_DATA_INVALID;
+    }
+    return APDU_CODE_OK;
+}
+
+__Z_INLINE uint16_t finish_legacy_chunks()
+{
+    if (tx_delta_active() && tx_delta_finish() != zxerr_ok) {
+        return APDU_CODE_DATA_INVALID;
+    }
+    return APDU_CODE_OK;
+}
+
+// With P1_DELTA the first chunk carries reference length (2) | reference txid (32) before the
+// delta operations. Returns the offset of the operations.
+__Z_INLINE uint32_t start_delta(uint32_t offset, uint32_t rx)
+{
+    if (rx < offset + DELTA_REFERENCE_LEN) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+    const uint16_t referenceLen = (uint16_t) ((G_io_apdu_buffer[offset] << 8) | G_io_apdu_buffer[offset + 1]);
+    if (tx_delta_init(referenceLen, &G_io_apdu_buffer[offset + 2]) != zxerr_ok) {
+        // The previous transaction is gone or is not the one the host expects
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+    return offset + DELTA_REFERENCE_LEN;
+}
+
 __Z_INLINE bool process_chunk_legacy(__Z_UNUSED volatile uint32_t *tx, uint32_t rx)
 {
-    const uint8_t P1 = G_io_apdu_buffer[OFFSET_P1];
+    const uint8_t rawP1 = G_io_apdu_buffer[OFFSET_P1];
+    // Options are only carried by the first chunk
+    const uint8_t P1 = (rawP1 & P1_MORE) ? rawP1 : (uint8_t) (rawP1 & ~(P1_RETURN_TXID | P1_DELTA));
     const uint8_t P2 = G_io_apdu_buffer[OFFSET_P2];
     const uint8_t payloadType = convertP1P2(P1, P2);
 
     if (rx < OFFSET_DATA) {
         THROW(APDU_CODE_WRONG_LENGTH);
     }
+    TRACE_EVENT(TRACE_CHUNK, rx - OFFSET_DATA);
 
-    uint32_t added;
+    uint16_t sw;
+    uint32_t dataOffset;
     uint8_t accountIdSize = 0;
     uint8_t hdPathSize = 0;
 
     switch (payloadType) {
         case P1_INIT:
+        case P1_SINGLE_CHUNK:
             tx_initialize();
             tx_reset();
+            action_returnTxid = (rawP1 & P1_RETURN_TXID) != 0;
             if (P1 == P1_FIRST_ACCOUNT_ID) {
                 extract_accountId_into_HDpath();
                 accountIdSize = ACCOUNT_ID_LENGTH;
-            } 
-            tx_initialized = true;
-            tx_append((unsigned char*)tmpBuff, 2);
+            }
 
-            if (rx < (OFFSET_DATA + accountIdSize + hdPathSize)) {
+            dataOffset = OFFSET_DATA + accountIdSize + hdPathSize;
+            if (rx < dataOffset) {
                 THROW(APDU_CODE_WRONG_LENGTH);
             }
-
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA + accountIdSize + hdPathSize]), rx - (OFFSET_DATA + accountIdSize + hdPathSize));
-            if (added != rx - (OFFSET_DATA + accountIdSize + hdPathSize)) {
-                tx_initialized = false;
-                THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
+            if (rawP1 & P1_DELTA) {
+                dataOffset = start_delta(dataOffset, rx);
             }
-            return false;
 
-        case P1_ADD:
-            if (!tx_initialized) {
-                THROW(APDU_CODE_TX_NOT_INITIALIZED);
+            tx_initialized = payloadType == P1_INIT;
+            tx_append((unsigned char*)tmpBuff, 2);
+
+            sw = append_legacy_chunk(&(G_io_apdu_buffer[dataOffset]), rx - dataOffset);
+            if (sw == APDU_CODE_OK && payloadType == P1_SINGLE_CHUNK) {
+                sw = finish_legacy_chunks();
             }
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
-            if (added != rx - OFFSET_DATA) {
+            if (sw != APDU_CODE_OK) {
                 tx_initialized = false;
-                THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
+                THROW(sw);
             }
-            return false;
+            return payloadType == P1_SINGLE_CHUNK;
 
+        case P1_ADD:
         case P1_LAST:
             if (!tx_initialized) {
                 THROW(APDU_CODE_TX_NOT_INITIALIZED);
             }
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
-            tx_initialized = false;
-            if (added != rx - OFFSET_DATA) {
-                THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
+            sw = append_legacy_chunk(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
+            if (sw == APDU_CODE_OK && payloadType == P1_LAST) {
+                sw = finish_legacy_chunks();
             }
-            return true;
-
-        case P1_SINGLE_CHUNK:
-            tx_initialize();
-            tx_reset();
-            if (P1 == P1_FIRST_ACCOUNT_ID) {
-                extract_accountId_into_HDpath();
-                accountIdSize = ACCOUNT_ID_LENGTH;
+            if (sw != APDU_CODE_OK || payloadType == P1_LAST) {
+                tx_initialized = false;
             }
-            tx_append((unsigned char*)tmpBuff, 2);
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA + accountIdSize + hdPathSize]), rx - (OFFSET_DATA + accountIdSize + hdPathSize));
-            tx_initialized = false;
-            if (added != rx - (OFFSET_DATA + accountIdSize + hdPathSize)) {
-                THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
+            if (sw != APDU_CODE_OK) {
+                THROW(sw);
             }
-            return true;
+            return payloadType == P1_LAST;
     }
 
     THROW(APDU_CODE_INVALIDP1P2);
@@ -231,6 +270,157 @@ __Z_INLINE void handle_sign(volatile uint32_t *flags, volatile uint32_t *tx, uin
     *flags |= IO_ASYNCH_REPLY;
 }
 
+// Same chunks as INS_SIGN_MSGPACK, but the last one is answered right away with the parser
+// verdict instead of a review: error (1) | offset (2) | items (1) | type (1) | txid (32)
+__Z_INLINE void handle_validate_msgpack(volatile uint32_t *tx, uint32_t rx)
+{
+    if (!process_chunk_legacy(tx, rx)) {
+        THROW(APDU_CODE_OK);
+    }
+
+    const parser_error_t error = tx_parse(MsgPack);
+    CHECK_APP_CANARY()
+
+    const parser_context_t *ctx = tx_get_parser_context();
+    const uint8_t *message = tx_get_buffer();
+    const uint16_t messageLength = (uint16_t) tx_get_buffer_length();
+
+    uint8_t numItems = 0;
+    if (error == parser_ok && tx_getNumItems(&numItems) != zxerr_ok) {
+        numItems = 0;
+    }
+
+    MEMZERO(G_io_apdu_buffer, VALIDATE_SUMMARY_LEN);
+    G_io_apdu_buffer[0] = (uint8_t) error;
+    G_io_apdu_buffer[1] = (uint8_t) (ctx->offset >> 8);
+    G_io_apdu_buffer[2] = (uint8_t) ctx->offset;
+    G_io_apdu_buffer[3] = numItems;
+    G_io_apdu_buffer[4] = error == parser_ok ? (uint8_t) ctx->parser_tx_obj->type : TX_UNKNOWN;
+    if (crypto_txid(message, messageLength, G_io_apdu_buffer + 5, TXID_LEN) != zxerr_ok) {
+        THROW(APDU_CODE_EXECUTION_ERROR);
+    }
+
+    // Only the parse state is dropped: the transaction stays the reference for a P1_DELTA chunk
+    tx_parse_reset();
+    *tx = VALIDATE_SUMMARY_LEN;
+    THROW(APDU_CODE_OK);
+}
+
+// P1_INIT: hdPath + number of transactions in the group. P1_ADD / P1_LAST: group entries,
+// see parser_group.h. After approval, P1_GET_SIGNATURES + index returns the rest.
+__Z_INLINE void handle_sign_group(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx)
+{
+    const uint8_t p1 = G_io_apdu_buffer[OFFSET_P1];
+
+    if (rx < OFFSET_DATA) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    switch (p1) {
+        case P1_INIT: {
+            tx_initialize();
+            tx_reset();
+            group_initialized = false;
+            extractHDPath(rx, OFFSET_DATA);
+            if (rx < OFFSET_DATA + SERIALIZED_HDPATH_LENGTH + 1) {
+                THROW(APDU_CODE_WRONG_LENGTH);
+            }
+            const uint8_t txnCount = G_io_apdu_buffer[OFFSET_DATA + SERIALIZED_HDPATH_LENGTH];
+            if (txnCount == 0 || txnCount > GROUP_MAX_TXNS) {
+                THROW(APDU_CODE_DATA_INVALID);
+            }
+            tx_group_init(txnCount);
+            group_initialized = true;
+            THROW(APDU_CODE_OK);
+        }
+
+        case P1_ADD:
+        case P1_LAST: {
+            if (!group_initialized) {
+                THROW(APDU_CODE_TX_NOT_INITIALIZED);
+            }
+            const zxerr_t err = tx_group_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
+            if (err != zxerr_ok) {
+                group_initialized = false;
+                THROW(err == zxerr_buffer_too_small ? APDU_CODE_OUTPUT_BUFFER_TOO_SMALL : APDU_CODE_DATA_INVALID);
+            }
+            if (p1 == P1_ADD) {
+                THROW(APDU_CODE_OK);
+            }
+            group_initialized = false;
+            break;
+        }
+
+        case P1_GET_SIGNATURES: {
+            if (rx < OFFSET_DATA + 1) {
+                THROW(APDU_CODE_WRONG_LENGTH);
+            }
+            uint16_t replyLen = 0;
+            if (app_fill_group_signatures(G_io_apdu_buffer[OFFSET_DATA], &replyLen) != zxerr_ok) {
+                THROW(APDU_CODE_DATA_INVALID);
+            }
+            *tx = replyLen;
+            THROW(APDU_CODE_OK);
+        }
+
+        default:
+            THROW(APDU_CODE_INVALIDP1P2);
+    }
+
+    parser_error_t error = tx_group_parse();
+    const char *error_msg = parser_getErrorDescription(error);
+    CHECK_APP_CANARY()
+
+    if (error != parser_ok) {
+        int error_msg_length = strlen(error_msg);
+        memcpy(G_io_apdu_buffer, error_msg, error_msg_length);
+        *tx += (error_msg_length);
+        THROW(parser_mapParserErrorToSW(error));
+    }
+
+    view_review_init(tx_group_getItem, tx_group_getNumItems, app_sign_group);
+    view_review_show(REVIEW_TXN);
+
+    *flags |= IO_ASYNCH_REPLY;
+}
+
+// Same chunking as INS_SIGN_DATA (P1_INIT carries the hdPath). After approval,
+// P1_GET_SIGNATURES + index returns the signatures that did not fit in the first reply.
+__Z_INLINE void handle_sign_data_batch(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx)
+{
+    if (rx >= OFFSET_DATA && G_io_apdu_buffer[OFFSET_P1] == P1_GET_SIGNATURES) {
+        if (rx < OFFSET_DATA + 1) {
+            THROW(APDU_CODE_WRONG_LENGTH);
+        }
+        uint16_t replyLen = 0;
+        if (app_fill_arbitrary_batch_signatures(G_io_apdu_buffer[OFFSET_DATA], &replyLen) != zxerr_ok) {
+            THROW(APDU_CODE_DATA_INVALID);
+        }
+        *tx = replyLen;
+        THROW(APDU_CODE_OK);
+    }
+
+    if (!process_chunk(tx, rx)) {
+        THROW(APDU_CODE_OK);
+    }
+
+    parser_error_t error = tx_parse(ArbitraryDataBatch);
+    const char *error_msg = parser_getErrorDescription(error);
+    CHECK_APP_CANARY()
+
+    if (error != parser_ok) {
+        int error_msg_length = strlen(error_msg);
+        memcpy(G_io_apdu_buffer, error_msg, error_msg_length);
+        *tx += (error_msg_length);
+        THROW(parser_mapParserErrorToSW(error));
+    }
+
+    view_review_init(tx_getItem, tx_getNumItems, app_sign_arbitrary_batch);
+    view_review_show(REVIEW_TXN);
+
+    *flags |= IO_ASYNCH_REPLY;
+}
+
 __Z_INLINE void handle_get_public_key(volatile uint32_t *flags, volatile uint32_t *tx, __Z_UNUSED uint32_t rx)
 {
     const uint8_t requireConfirmation = G_io_apdu_buffer[OFFSET_P1];
@@ -258,6 +448,42 @@ __Z_INLINE void handle_get_public_key(volatile uint32_t *flags, volatile uint32_
     THROW(APDU_CODE_OK);
 }
 
+// Payload: first account (4 bytes, big endian) + number of accounts requested (1 byte).
+// Replies with the number of keys returned followed by that many public keys; the host asks
+// again from firstAccount + returned for the rest. Nothing is shown, so P1 must be 0.
+__Z_INLINE void handle_get_public_keys(__Z_UNUSED volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx)
+{
+    if (G_io_apdu_buffer[OFFSET_P1] != 0) {
+        THROW(APDU_CODE_COMMAND_NOT_ALLOWED);
+    }
+
+    if (rx < OFFSET_DATA + PUBLIC_KEYS_REQUEST_LENGTH ||
+        G_io_apdu_buffer[OFFSET_DATA_LEN] != PUBLIC_KEYS_REQUEST_LENGTH) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    const uint32_t firstAccount = U4BE(G_io_apdu_buffer, OFFSET_DATA);
+    uint8_t count = G_io_apdu_buffer[OFFSET_DATA + ACCOUNT_ID_LENGTH];
+    if (count == 0) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+    if (count > PUBLIC_KEYS_PER_APDU) {
+        count = PUBLIC_KEYS_PER_APDU;
+    }
+
+    const zxerr_t err = crypto_extractPublicKeys(firstAccount, count, G_io_apdu_buffer + 1, IO_APDU_BUFFER_SIZE - 3);
+    if (err == zxerr_invalid_crypto_settings) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+    if (err != zxerr_ok) {
+        THROW(APDU_CODE_UNKNOWN);
+    }
+
+    G_io_apdu_buffer[0] = count;
+    *tx = 1 + (uint32_t) count * PK_LEN_25519;
+    THROW(APDU_CODE_OK);
+}
+
 __Z_INLINE void handle_getversion(__Z_UNUSED volatile uint32_t *flags, volatile uint32_t *tx)
 {
     G_io_apdu_buffer[0] = 0;
@@ -286,6 +512,41 @@ __Z_INLINE void handle_getversion(__Z_UNUSED volatile uint32_t *flags, volatile
     THROW(APDU_CODE_OK);
 }
 
+#if defined(APP_TESTING)
+// P1 = 0x01 clears the counters after reading them
+__Z_INLINE void handle_get_key_cache_stats(__Z_UNUSED volatile uint32_t *flags, volatile uint32_t *tx)
+{
+    key_cache_stats_t stats;
+    key_cache_get_stats(&stats);
+
+    const uint32_t counters[] = {stats.hits, stats.misses, stats.evictions, stats.resets};
+    for (uint8_t i = 0; i < sizeof(counters) / sizeof(counters[0]); i++) {
+        G_io_apdu_buffer[4 * i] = (counters[i] >> 24) & 0xFF;
+        G_io_apdu_buffer[4 * i + 1] = (counters[i] >> 16) & 0xFF;
+        G_io_apdu_buffer[4 * i + 2] = (counters[i] >> 8) & 0xFF;
+        G_io_apdu_buffer[4 * i + 3] = (counters[i] >> 0) & 0xFF;
+    }
+    G_io_apdu_buffer[16] = KEY_CACHE_ENTRIES;
+
+    if (G_io_apdu_buffer[OFFSET_P1] == 0x01) {
+        key_cache_clear_stats();
+    }
+
+    *tx += 17;
+    THROW(APDU_CODE_OK);
+}
+
+// Each reply carries as many of the oldest trace records as fit; drain until none are returned
+__Z_INLINE void handle_get_trace(__Z_UNUSED volatile uint32_t *flags, volatile uint32_t *tx)
+{
+    if (G_io_apdu_buffer[OFFSET_P1] != 0) {
+        THROW(APDU_CODE_COMMAND_NOT_ALLOWED);
+    }
+    *tx = trace_drain(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 2);
+    THROW(APDU_CODE_OK);
+}
+#endif
+
 void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
     uint16_t sw = 0;
 
@@ -301,7 +562,17 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                 THROW(APDU_CODE_WRONG_LENGTH);
             }
 
+            // Derived keys must not outlive the unlocked session (lock or auto-lock timeout)
+            if (os_global_pin_is_validated() != BOLOS_UX_OK) {
+                key_cache_reset();
+            }
+
             const uint8_t ins = G_io_apdu_buffer[OFFSET_INS];
+            // Draining the trace must not refill it
+            if (ins != INS_GET_TRACE) {
+                TRACE_EXCHANGE();
+                TRACE_EVENT(TRACE_APDU, ins);
+            }
             switch (ins) {
                 case INS_SIGN_MSGPACK: {
                     CHECK_PIN_VALIDATED()
@@ -309,12 +580,30 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                     break;
                 }
 
+                case INS_VALIDATE_MSGPACK: {
+                    CHECK_PIN_VALIDATED()
+                    handle_validate_msgpack(tx, rx);
+                    break;
+                }
+
                 case INS_SIGN_DATA: {
                     CHECK_PIN_VALIDATED()
                     handle_sign(flags, tx, rx, ArbitraryData);
                     break;
                 }
 
+                case INS_SIGN_GROUP: {
+                    CHECK_PIN_VALIDATED()
+                    handle_sign_group(flags, tx, rx);
+                    break;
+                }
+
+                case INS_SIGN_DATA_BATCH: {
+                    CHECK_PIN_VALIDATED()
+                    handle_sign_data_batch(flags, tx, rx);
+                    break;
+                }
+
 
                 case INS_GET_ADDRESS:
                 case INS_GET_PUBLIC_KEY: {
@@ -323,6 +612,26 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                     break;
                 }
 
+                case INS_GET_PUBLIC_KEYS: {
+                    CHECK_PIN_VALIDATED()
+                    handle_get_public_keys(flags, tx, rx);
+                    break;
+                }
+
+#if defined(APP_TESTING)
+                case INS_GET_KEY_CACHE_STATS: {
+                    CHECK_PIN_VALIDATED()
+                    handle_get_key_cache_stats(flags, tx);
+                    break;
+                }
+
+                case INS_GET_TRACE: {
+                    CHECK_PIN_VALIDATED()
+                    handle_get_trace(flags, tx);
+                    break;
+                }
+#endif
+
                 case INS_GET_VERSION: {
                     handle_getversion(flags, tx);
                     THROW(APDU_CODE_OK);
@@ -335,6 +644,7 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
         }
         CATCH(EXCEPTION_IO_RESET)
         {
+            key_cache_reset();
             THROW(EXCEPTION_IO_RESET);
         }
         CATCH_OTHER(e)
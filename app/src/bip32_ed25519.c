@@ -0,0 +1,147 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bip32_ed25519.h"
+#include "zxmacros.h"
+#include <string.h>
+
+#define HMAC_SHA512_LEN 64u
+
+#if defined(LEDGER_SPECIFIC)
+#include "cx.h"
+
+static zxerr_t hmac_sha512(const uint8_t *key, uint16_t keyLen,
+                           const uint8_t *data, uint16_t dataLen,
+                           uint8_t out[HMAC_SHA512_LEN]) {
+    cx_hmac_sha512_t hmac;
+    zxerr_t error = zxerr_unknown;
+
+    CATCH_CXERROR(cx_hmac_sha512_init_no_throw(&hmac, key, keyLen));
+    CATCH_CXERROR(cx_hmac_no_throw((cx_hmac_t *) &hmac, CX_LAST, data, dataLen, out, HMAC_SHA512_LEN));
+    error = zxerr_ok;
+
+catch_cx_error:
+    MEMZERO(&hmac, sizeof(hmac));
+    return error;
+}
+
+// Compressed kL * B, with kL taken as a little endian scalar (no hashing or clamping)
+static zxerr_t scalarmult_base(uint8_t out[PK_LEN_25519], const uint8_t scalar[SCALAR_LEN_ED25519]) {
+    uint8_t point[1 + 2 * PK_LEN_25519] = {0};
+    uint8_t scalarBE[SCALAR_LEN_ED25519] = {0};
+    zxerr_t error = zxerr_unknown;
+
+    for (uint8_t i = 0; i < SCALAR_LEN_ED25519; i++) {
+        scalarBE[i] = scalar[SCALAR_LEN_ED25519 - 1 - i];
+    }
+
+    point[0] = 0x04;
+    CATCH_CXERROR(cx_ecdomain_generator(CX_CURVE_Ed25519, point + 1, point + 1 + PK_LEN_25519, PK_LEN_25519));
+    CATCH_CXERROR(cx_ecfp_scalar_mult_no_throw(CX_CURVE_Ed25519, point, scalarBE, sizeof(scalarBE)));
+
+    for (unsigned int i = 0; i < PK_LEN_25519; i++) {
+        out[i] = point[64 - i];
+    }
+    if ((point[PK_LEN_25519] & 1) != 0) {
+        out[31] |= 0x80;
+    }
+    error = zxerr_ok;
+
+catch_cx_error:
+    MEMZERO(scalarBE, sizeof(scalarBE));
+    return error;
+}
+#else
+#include "crypto_host.h"
+#include "ed25519.h"
+
+static zxerr_t hmac_sha512(const uint8_t *key, uint16_t keyLen,
+                           const uint8_t *data, uint16_t dataLen,
+                           uint8_t out[HMAC_SHA512_LEN]) {
+    crypto_host_hmac_sha512(key, keyLen, data, dataLen, out);
+    return zxerr_ok;
+}
+
+static zxerr_t scalarmult_base(uint8_t out[PK_LEN_25519], const uint8_t scalar[SCALAR_LEN_ED25519]) {
+    ed25519_scalarmult_base(out, scalar);
+    return zxerr_ok;
+}
+#endif
+
+// kL' = kL + 8 * trunc28(ZL), kR' = kR + ZR (mod 2^256), both little endian
+static void add_child_tweak(uint8_t key[SK_LEN_25519], const uint8_t z[HMAC_SHA512_LEN]) {
+    uint16_t carry = 0;
+    for (uint8_t i = 0; i < 32; i++) {
+        const uint8_t lo = i < 28 ? (uint8_t) (z[i] << 3) : 0;
+        const uint8_t hi = (i > 0 && i <= 28) ? (uint8_t) (z[i - 1] >> 5) : 0;
+        carry += (uint16_t) key[i] + (uint8_t) (lo | hi);
+        key[i] = (uint8_t) carry;
+        carry >>= 8;
+    }
+
+    carry = 0;
+    for (uint8_t i = 0; i < 32; i++) {
+        carry += (uint16_t) key[32 + i] + z[32 + i];
+        key[32 + i] = (uint8_t) carry;
+        carry >>= 8;
+    }
+}
+
+zxerr_t bip32_ed25519_derive_child(bip32_ed25519_node_t *node, uint32_t index) {
+    if (node == NULL) {
+        return zxerr_unknown;
+    }
+
+    uint8_t data[1 + SK_LEN_25519 + 4];
+    uint8_t z[HMAC_SHA512_LEN];
+    uint16_t dataLen = 0;
+    zxerr_t error = zxerr_unknown;
+
+    if ((index & BIP32_HARDENED_BIT) != 0) {
+        data[0] = 0x00;
+        MEMCPY(data + 1, node->key, SK_LEN_25519);
+        dataLen = 1 + SK_LEN_25519;
+    } else {
+        data[0] = 0x02;
+        if (scalarmult_base(data + 1, node->key) != zxerr_ok) {
+            goto cleanup;
+        }
+        dataLen = 1 + PK_LEN_25519;
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        data[dataLen + i] = (uint8_t) (index >> (8 * i));
+    }
+    dataLen += 4;
+
+    if (hmac_sha512(node->chainCode, sizeof(node->chainCode), data, dataLen, z) != zxerr_ok) {
+        goto cleanup;
+    }
+    add_child_tweak(node->key, z);
+
+    data[0] = (index & BIP32_HARDENED_BIT) != 0 ? 0x01 : 0x03;
+    if (hmac_sha512(node->chainCode, sizeof(node->chainCode), data, dataLen, z) != zxerr_ok) {
+        goto cleanup;
+    }
+    MEMCPY(node->chainCode, z + 32, sizeof(node->chainCode));
+    error = zxerr_ok;
+
+cleanup:
+    MEMZERO(data, sizeof(data));
+    MEMZERO(z, sizeof(z));
+    if (error != zxerr_ok) {
+        MEMZERO(node, sizeof(*node));
+    }
+    return error;
+}
@@ -0,0 +1,41 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "coin.h"
+#include "zxerror.h"
+
+#define BIP32_HARDENED_BIT   0x80000000u
+#define BIP32_CHAIN_CODE_LEN 32u
+
+// Extended BIP32-Ed25519 (Khovratovich-Law) node, as returned by
+// os_derive_bip32_with_seed_no_throw(HDW_NORMAL, CX_CURVE_Ed25519, ...)
+typedef struct {
+    uint8_t key[SK_LEN_25519];              // kL || kR, little endian
+    uint8_t chainCode[BIP32_CHAIN_CODE_LEN];
+} bip32_ed25519_node_t;
+
+/// Replaces `node` with its child `index` (hardened when the top bit is set)
+zxerr_t bip32_ed25519_derive_child(bip32_ed25519_node_t *node, uint32_t index);
+
+#ifdef __cplusplus
+}
+#endif
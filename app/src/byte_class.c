@@ -0,0 +1,236 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "byte_class.h"
+#include <string.h>
+
+#if !defined(LEDGER_SPECIFIC) && defined(__SSE2__)
+#include <immintrin.h>
+#define BYTE_CLASS_X86
+#endif
+
+// Native register width: 32 bits on device
+typedef uintptr_t word_t;
+
+#define WORD_ONES   ((word_t) -1 / 0xFF)
+#define WORD_HIGHS  (WORD_ONES * 0x80)
+
+static bool in_range_bytes(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    const uint8_t span = hi - lo;
+    for (size_t i = 0; i < len; i++) {
+        if ((uint8_t) (data[i] - lo) > span) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool all_zero_bytes(const uint8_t *data, size_t len) {
+    uint8_t acc = 0;
+    for (size_t i = 0; i < len; i++) {
+        acc |= data[i];
+    }
+    return acc == 0;
+}
+
+// Bytes before the first word aligned address
+static size_t unaligned_head(const uint8_t *data, size_t len) {
+    const size_t head = (size_t) (-(uintptr_t) data) & (sizeof(word_t) - 1);
+    return head < len ? head : len;
+}
+
+static word_t load_word(const uint8_t *data) {
+    word_t w;
+    memcpy(&w, data, sizeof(w));
+    return w;
+}
+
+static bool in_range_portable(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    // The word tests below are exact when hi is 7-bit, which covers every caller
+    if (hi >= 0x80) {
+        return in_range_bytes(data, len, lo, hi);
+    }
+
+    const size_t head = unaligned_head(data, len);
+    if (!in_range_bytes(data, head, lo, hi)) {
+        return false;
+    }
+    data += head;
+    len -= head;
+
+    // A byte is outside [lo, hi] when its high bit is set, when subtracting lo borrows
+    // into it, or when adding 0x7F - hi carries into it
+    const word_t below = WORD_ONES * lo;
+    const word_t above = WORD_ONES * (uint8_t) (0x7F - hi);
+    for (; len >= sizeof(word_t); data += sizeof(word_t), len -= sizeof(word_t)) {
+        const word_t w = load_word(data);
+        if (((w | (w - below) | (w + above)) & WORD_HIGHS) != 0) {
+            return false;
+        }
+    }
+    return in_range_bytes(data, len, lo, hi);
+}
+
+static bool all_zero_portable(const uint8_t *data, size_t len) {
+    const size_t head = unaligned_head(data, len);
+    if (!all_zero_bytes(data, head)) {
+        return false;
+    }
+    data += head;
+    len -= head;
+
+    word_t acc = 0;
+    for (; len >= sizeof(word_t); data += sizeof(word_t), len -= sizeof(word_t)) {
+        acc |= load_word(data);
+    }
+    return acc == 0 && all_zero_bytes(data, len);
+}
+
+#if defined(BYTE_CLASS_X86)
+// x - lo <= hi - lo as unsigned bytes, checked with max_epu8 since SSE2 has no unsigned compare
+static bool in_range_sse2(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    const __m128i vlo = _mm_set1_epi8((char) lo);
+    const __m128i vspan = _mm_set1_epi8((char) (hi - lo));
+    size_t i = 0;
+
+    for (; i + 64 <= len; i += 64) {
+        __m128i m = _mm_sub_epi8(_mm_loadu_si128((const __m128i *) (data + i)), vlo);
+        m = _mm_max_epu8(m, _mm_sub_epi8(_mm_loadu_si128((const __m128i *) (data + i + 16)), vlo));
+        m = _mm_max_epu8(m, _mm_sub_epi8(_mm_loadu_si128((const __m128i *) (data + i + 32)), vlo));
+        m = _mm_max_epu8(m, _mm_sub_epi8(_mm_loadu_si128((const __m128i *) (data + i + 48)), vlo));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(m, vspan), vspan)) != 0xFFFF) {
+            return false;
+        }
+    }
+    for (; i + 16 <= len; i += 16) {
+        const __m128i m = _mm_sub_epi8(_mm_loadu_si128((const __m128i *) (data + i)), vlo);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(m, vspan), vspan)) != 0xFFFF) {
+            return false;
+        }
+    }
+    return in_range_bytes(data + i, len - i, lo, hi);
+}
+
+static bool all_zero_sse2(const uint8_t *data, size_t len) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i *) (data + i)));
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) == 0xFFFF &&
+           all_zero_bytes(data + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static bool in_range_avx2(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    const __m256i vlo = _mm256_set1_epi8((char) lo);
+    const __m256i vspan = _mm256_set1_epi8((char) (hi - lo));
+    size_t i = 0;
+
+    for (; i + 128 <= len; i += 128) {
+        __m256i m = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i *) (data + i)), vlo);
+        m = _mm256_max_epu8(m, _mm256_sub_epi8(_mm256_loadu_si256((const __m256i *) (data + i + 32)), vlo));
+        m = _mm256_max_epu8(m, _mm256_sub_epi8(_mm256_loadu_si256((const __m256i *) (data + i + 64)), vlo));
+        m = _mm256_max_epu8(m, _mm256_sub_epi8(_mm256_loadu_si256((const __m256i *) (data + i + 96)), vlo));
+        if ((uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(m, vspan), vspan)) != 0xFFFFFFFF) {
+            _mm256_zeroupper();
+            return false;
+        }
+    }
+    // Leave the upper halves clean before running the SSE2 tail
+    _mm256_zeroupper();
+    return in_range_sse2(data + i, len - i, lo, hi);
+}
+
+__attribute__((target("avx2")))
+static bool all_zero_avx2(const uint8_t *data, size_t len) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        acc = _mm256_or_si256(acc, _mm256_loadu_si256((const __m256i *) (data + i)));
+    }
+    const bool zero = _mm256_testz_si256(acc, acc);
+    _mm256_zeroupper();
+    return zero && all_zero_sse2(data + i, len - i);
+}
+#endif
+
+#if !defined(LEDGER_SPECIFIC)
+static int8_t selected_backend = -1;
+
+static bool backend_supported(byte_class_backend_e backend) {
+    switch (backend) {
+        case byte_class_backend_portable:
+            return true;
+#if defined(BYTE_CLASS_X86)
+        case byte_class_backend_sse2:
+            return true;
+        case byte_class_backend_avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+byte_class_backend_e byte_class_get_backend(void) {
+    if (selected_backend < 0) {
+        selected_backend = byte_class_backend_avx2;
+        while (!backend_supported((byte_class_backend_e) selected_backend)) {
+            selected_backend--;
+        }
+    }
+    return (byte_class_backend_e) selected_backend;
+}
+
+zxerr_t byte_class_set_backend(byte_class_backend_e backend) {
+    if (!backend_supported(backend)) {
+        return zxerr_unknown;
+    }
+    selected_backend = (int8_t) backend;
+    return zxerr_ok;
+}
+#endif
+
+bool bytes_in_range(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi) {
+    if (lo > hi) {
+        return len == 0;
+    }
+#if defined(BYTE_CLASS_X86)
+    switch (byte_class_get_backend()) {
+        case byte_class_backend_avx2:
+            return in_range_avx2(data, len, lo, hi);
+        case byte_class_backend_sse2:
+            return in_range_sse2(data, len, lo, hi);
+        default:
+            break;
+    }
+#endif
+    return in_range_portable(data, len, lo, hi);
+}
+
+bool bytes_all_zero(const uint8_t *data, size_t len) {
+#if defined(BYTE_CLASS_X86)
+    switch (byte_class_get_backend()) {
+        case byte_class_backend_avx2:
+            return all_zero_avx2(data, len);
+        case byte_class_backend_sse2:
+            return all_zero_sse2(data, len);
+        default:
+            break;
+    }
+#endif
+    return all_zero_portable(data, len);
+}
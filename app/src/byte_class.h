@@ -0,0 +1,55 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "zxerror.h"
+
+// Byte class checks over whole buffers: word at a time on device, SSE2/AVX2 on x86 hosts
+
+// True when every byte lies in [lo, hi]. Empty buffers pass.
+bool bytes_in_range(const uint8_t *data, size_t len, uint8_t lo, uint8_t hi);
+
+// True when every byte is zero. Empty buffers pass.
+bool bytes_all_zero(const uint8_t *data, size_t len);
+
+// True when every byte is printable ASCII (32-126)
+static inline bool bytes_printable(const uint8_t *data, size_t len) {
+    return bytes_in_range(data, len, 0x20, 0x7E);
+}
+
+#if !defined(LEDGER_SPECIFIC)
+typedef enum {
+    byte_class_backend_portable = 0,
+    byte_class_backend_sse2 = 1,
+    byte_class_backend_avx2 = 2,
+} byte_class_backend_e;
+
+// Host only: the widest backend the CPU supports is picked on first use
+// and can be forced afterwards to compare or benchmark the implementations.
+byte_class_backend_e byte_class_get_backend(void);
+zxerr_t byte_class_set_backend(byte_class_backend_e backend);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -13,159 +13,128 @@
 *  See the License for the specific language governing permissions and
 *  limitations under the License.
 ********************************************************************************/
-
-#include "cbor.h"
 #include "parser_cbor.h"
-#include "parser_common.h"
+#include "zxmacros.h"
 
-parser_error_t parser_init_cbor(
-    cbor_parser_t *parser,
-    cbor_value_t *value,
-    const uint8_t *buffer,
-    size_t bufferSize) {
-    if (parser == NULL || value == NULL || buffer == NULL || bufferSize == 0) {
-        return parser_cbor_error_invalid_parameters;
-    }
-    
-    CborError err = cbor_parser_init(buffer, bufferSize, 0, parser, value);
-    
-    if (err != CborNoError) {
-        return parser_cbor_error_parser_init;
-    }
-    
-    return parser_ok;
+#define CBOR_INFO_MASK          0x1F
+#define CBOR_INFO_UINT8         24
+#define CBOR_INFO_UINT64        27
+
+static size_t cbor_remaining(const cbor_reader_t *reader) {
+    return (size_t) (reader->end - reader->ptr);
 }
 
-parser_error_t parser_traverse_map_entries(
-    cbor_value_t *map,
-    parser_error_t (*callback)(cbor_value_t *key, cbor_value_t *value)) {
-    
-    if (map == NULL || callback == NULL) {
-        return parser_cbor_error_invalid_parameters;
+// Reads the initial byte and its argument: the value of an integer, the length of a string,
+// the number of entries of a container, the tag number or the payload of a simple value.
+// Reserved additional information values and indefinite lengths (31) are rejected:
+// FIDO2 authenticators emit CTAP2 canonical CBOR, which only uses definite lengths.
+static parser_error_t cbor_read_head(cbor_reader_t *reader, uint8_t *major, uint64_t *argument) {
+    if (reader->ptr >= reader->end) {
+        return parser_cbor_error_unexpected;
     }
+    const uint8_t initial = *reader->ptr++;
+    const uint8_t info = initial & CBOR_INFO_MASK;
+    *major = initial >> 5;
 
-    if (!cbor_value_is_map(map)) {
-        return parser_cbor_error_invalid_type;
-    }
-    
-    cbor_value_t mapCopy;
-    parser_error_t err = parser_enter_map(map, &mapCopy);
-    
-    if (err != parser_ok) {
-        return err;
+    if (info < CBOR_INFO_UINT8) {
+        *argument = info;
+        return parser_ok;
     }
-    
-    while (!cbor_value_at_end(&mapCopy)) {
-        cbor_value_t key = mapCopy;
-        
-        // Advance to the value
-        CborError cborErr = cbor_value_advance(&mapCopy);
-        if (cborErr != CborNoError) {
-            return parser_cbor_error_unexpected;
-        }
-        
-        cbor_value_t value = mapCopy;
-        
-        // Call the callback with the key-value pair
-        parser_error_t callbackResult = callback(&key, &value);
-        if (callbackResult != parser_ok) {
-            return callbackResult;
-        }
-        
-        // Advance to the next key
-        cborErr = cbor_value_advance(&mapCopy);
-        if (cborErr != CborNoError) {
-            return parser_cbor_error_unexpected;
-        }
+    if (info > CBOR_INFO_UINT64) {
+        return parser_cbor_error_unexpected;
     }
-    
-    // Leave the container
-    return parser_leave_map(map, &mapCopy);
-}
 
-
-parser_error_t parser_enter_map(
-    cbor_value_t *value,
-    cbor_value_t *mapValue) {
-    
-    if (!cbor_value_is_map(value)) {
-        return parser_cbor_error_invalid_type;
+    const uint8_t argumentLen = 1 << (info - CBOR_INFO_UINT8);
+    if (cbor_remaining(reader) < argumentLen) {
+        return parser_cbor_error_unexpected;
+    }
+    *argument = 0;
+    for (uint8_t i = 0; i < argumentLen; i++) {
+        *argument = (*argument << 8) | *reader->ptr++;
     }
-    
-    CborError err = cbor_value_enter_container(value, mapValue);
-    
-    if (err != CborNoError) {
-        return parser_cbor_error_map_entry;
+    // Two byte simple values below 32 are not well-formed (RFC 8949 - Section 3.3)
+    if (*major == CBOR_MAJOR_SIMPLE && info == CBOR_INFO_UINT8 && *argument < 32) {
+        return parser_cbor_error_unexpected;
     }
-    
     return parser_ok;
 }
 
-parser_error_t parser_leave_map(
-    cbor_value_t *map,
-    const cbor_value_t *mapValue) {
-    
-    CborError err = cbor_value_leave_container(map, mapValue);
-    
-    if (err != CborNoError) {
-        return parser_cbor_error_map_entry;
+void cbor_reader_init(cbor_reader_t *reader, const uint8_t *buffer, size_t bufferLen) {
+    reader->ptr = buffer;
+    reader->end = buffer + bufferLen;
+}
+
+parser_error_t cbor_peek_type(const cbor_reader_t *reader, uint8_t *major) {
+    if (reader->ptr >= reader->end) {
+        return parser_cbor_error_unexpected;
     }
-    
+    *major = *reader->ptr >> 5;
     return parser_ok;
 }
 
-parser_error_t read_int_array(cbor_value_t *value, int *values, size_t *count) {
-    cbor_value_t element;
-    size_t i = 0;
-    size_t max_items = 0;
-
-    if (value == NULL || values == NULL || count == NULL) {
-        return parser_cbor_error_invalid_parameters;
+parser_error_t cbor_read_int(cbor_reader_t *reader, int64_t *value) {
+    uint8_t major = 0;
+    uint64_t argument = 0;
+    CHECK_ERROR(cbor_peek_type(reader, &major))
+    if (major != CBOR_MAJOR_UINT && major != CBOR_MAJOR_NINT) {
+        return parser_cbor_error_invalid_type;
     }
-
-    if (cbor_value_get_array_length(value, &max_items) != CborNoError) {
+    CHECK_ERROR(cbor_read_head(reader, &major, &argument))
+    if (argument > INT64_MAX) {
         return parser_cbor_error_unexpected;
     }
+    *value = major == CBOR_MAJOR_UINT ? (int64_t) argument : -1 - (int64_t) argument;
+    return parser_ok;
+}
 
-    // Verify it's an array
-    if (!cbor_value_is_array(value)) {
+parser_error_t cbor_read_container(cbor_reader_t *reader, uint8_t major, uint64_t *count) {
+    uint8_t itemMajor = 0;
+    CHECK_ERROR(cbor_peek_type(reader, &itemMajor))
+    if (itemMajor != major) {
         return parser_cbor_error_invalid_type;
     }
-        
-    // Get array length if known
-    size_t array_length;
-    if (cbor_value_is_length_known(value)) {
-        if (cbor_value_get_array_length(value, &array_length) != CborNoError)
-            return parser_cbor_error_unexpected;
-        if (array_length > max_items)
-            return parser_cbor_error_out_of_memory;
+    CHECK_ERROR(cbor_read_head(reader, &itemMajor, count))
+    // Every element takes at least one byte
+    if (*count > cbor_remaining(reader)) {
+        return parser_cbor_error_unexpected;
     }
-    
-    // Enter the array container
-    if (cbor_value_enter_container(value, &element) != CborNoError)
-        return parser_cbor_error_container;
-    
-    // Iterate through array elements
-    while (!cbor_value_at_end(&element) && i < max_items) {
-        // Make sure we're looking at an integer
-        if (!cbor_value_is_integer(&element))
-            return parser_cbor_error_invalid_type;
-            
-        // Get the integer value
-        if (cbor_value_get_int(&element, &values[i]) != CborNoError)
-            return parser_cbor_error_unexpected;
-            
-        // Move to next element
-        if (cbor_value_advance(&element) != CborNoError)
+    return parser_ok;
+}
+
+parser_error_t cbor_skip_item(cbor_reader_t *reader) {
+    uint64_t pending = 1;
+    while (pending > 0) {
+        uint8_t major = 0;
+        uint64_t argument = 0;
+        CHECK_ERROR(cbor_read_head(reader, &major, &argument))
+        pending--;
+
+        switch (major) {
+            case CBOR_MAJOR_BYTES:
+            case CBOR_MAJOR_TEXT:
+                if (argument > cbor_remaining(reader)) {
+                    return parser_cbor_error_unexpected;
+                }
+                reader->ptr += argument;
+                break;
+            case CBOR_MAJOR_ARRAY:
+            case CBOR_MAJOR_MAP:
+                if (argument > cbor_remaining(reader)) {
+                    return parser_cbor_error_unexpected;
+                }
+                pending += major == CBOR_MAJOR_MAP ? 2 * argument : argument;
+                break;
+            case CBOR_MAJOR_TAG:
+                pending++;
+                break;
+            default:
+                break;
+        }
+
+        // Every pending item takes at least one byte, which also keeps the counter bounded
+        if (pending > cbor_remaining(reader)) {
             return parser_cbor_error_unexpected;
-            
-        i++;
+        }
     }
-    
-    // Leave the array container
-    if (cbor_value_leave_container(value, &element) != CborNoError)
-        return parser_cbor_error_container;
-    
-    *count = i;
     return parser_ok;
 }
@@ -15,102 +15,77 @@
 ********************************************************************************/
 #pragma once
 
-#include "cbor.h"
+#include <stddef.h>
+#include <stdint.h>
 #include "parser_common.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct CborParser cbor_parser_t;
-typedef struct CborValue cbor_value_t;
+// CBOR major types (RFC 8949 - Section 3.1)
+#define CBOR_MAJOR_UINT     0
+#define CBOR_MAJOR_NINT     1
+#define CBOR_MAJOR_BYTES    2
+#define CBOR_MAJOR_TEXT     3
+#define CBOR_MAJOR_ARRAY    4
+#define CBOR_MAJOR_MAP      5
+#define CBOR_MAJOR_TAG      6
+#define CBOR_MAJOR_SIMPLE   7
 
 /**
- * Initializes a TinyCBOR parser
- *
- * @param[out] parser Pointer to a cbor_parser_t structure that will be initialized
- * @param[out] value Pointer to a cbor_value_t that will be initialized with the first element
- * @param[in] buffer Pointer to CBOR data to parse
- * @param[in] bufferSize Size of the CBOR data buffer
- * @return PARSER_CBOR_OK on success, PARSER_CBOR_ERROR_PARSER_INIT otherwise
- */
-parser_error_t parser_init_cbor(
-    cbor_parser_t *parser,
-    cbor_value_t *value,
-    const uint8_t *buffer,
-    size_t bufferSize);
-
-/**
- * Traverses all key-value pairs in a CBOR map and calls a callback function for each pair
- *
- * @param[in] map Pointer to a cbor_value_t that contains a CBOR map
- * @param[in] callback Function pointer to be called for each key-value pair
- * @param[in] context Optional user-provided context that will be passed to the callback
- * @return PARSER_CBOR_OK on success, error code otherwise
+ * Cursor over a bounded CBOR buffer. Nothing is ever read at or past end.
  */
-parser_error_t parser_traverse_map_entries(
-    cbor_value_t *map,
-    parser_error_t (*callback)(cbor_value_t *key, cbor_value_t *value));
+typedef struct {
+    const uint8_t *ptr;
+    const uint8_t *end;
+} cbor_reader_t;
 
 /**
- * Gets the size (number of key-value pairs) of a CBOR map
+ * Initializes a reader over bufferLen bytes
  *
- * @param[in] value Pointer to a cbor_value_t that contains a CBOR map
- * @param[out] mapSize Pointer to a size_t variable where the map size will be stored
- * @return PARSER_CBOR_OK on success, error code otherwise
+ * @param[out] reader Reader to initialize
+ * @param[in] buffer Pointer to CBOR data to parse
+ * @param[in] bufferLen Size of the CBOR data buffer
  */
-parser_error_t parser_get_map_size(
-    cbor_value_t *value,
-    size_t *mapSize);
+void cbor_reader_init(cbor_reader_t *reader, const uint8_t *buffer, size_t bufferLen);
 
 /**
- * Enters a CBOR map container
+ * Returns the major type of the next item without consuming it
  *
- * @param[in] value Pointer to a cbor_value_t that contains a CBOR map
- * @param[out] mapValue Pointer to a cbor_value_t that will be initialized with the map elements
- * @return PARSER_CBOR_OK on success, error code otherwise
+ * @param[in] reader Reader positioned at an item
+ * @param[out] major Major type of the item (CBOR_MAJOR_*)
+ * @return parser_ok on success, parser_cbor_error_unexpected at the end of the buffer
  */
-parser_error_t parser_enter_map(
-    cbor_value_t *value,
-    cbor_value_t *mapValue);
+parser_error_t cbor_peek_type(const cbor_reader_t *reader, uint8_t *major);
 
 /**
- * Finds a specific value in a CBOR map by its key
+ * Reads an unsigned or negative integer
  *
- * @param[in] map Pointer to a cbor_value_t that contains a CBOR map
- * @param[in] key C string containing the key to search for
- * @param[out] value Pointer to a cbor_value_t that will be initialized with the found value
- * @return PARSER_CBOR_OK on success, error code otherwise
+ * @param[in,out] reader Reader positioned at an integer
+ * @param[out] value Integer value
+ * @return parser_ok on success, parser_cbor_error_invalid_type if the item is not an integer
  */
-parser_error_t parser_find_map_value(
-    const cbor_value_t *map,
-    const char *key,
-    cbor_value_t *value);
+parser_error_t cbor_read_int(cbor_reader_t *reader, int64_t *value);
 
 /**
- * Leaves a CBOR map container
+ * Reads the header of a definite length map or array, leaving the reader at its first element
  *
- * @param[in,out] map Pointer to the original cbor_value_t before entering the map
- * @param[in] mapValue Pointer to the cbor_value_t after all map elements have been processed
- * @return PARSER_CBOR_OK on success, error code otherwise
+ * @param[in,out] reader Reader positioned at a container
+ * @param[in] major CBOR_MAJOR_MAP or CBOR_MAJOR_ARRAY
+ * @param[out] count Number of key-value pairs for maps, of elements for arrays
+ * @return parser_ok on success, parser_cbor_error_invalid_type if the item has another type
  */
-parser_error_t parser_leave_map(
-    cbor_value_t *map,
-    const cbor_value_t *mapValue);
+parser_error_t cbor_read_container(cbor_reader_t *reader, uint8_t major, uint64_t *count);
 
 /**
- * Reads an array of integers from a CBOR array
+ * Skips one complete item, including the elements of nested containers and tagged items
  *
- * @param[in] value Pointer to a cbor_value_t that contains a CBOR array
- * @param[out] values Pointer to an integer array where the values will be stored
- * @param[out] count Pointer to a size_t variable where the number of values will be stored
- * @return parser_ok on success, error code otherwise
+ * @param[in,out] reader Reader positioned at an item
+ * @return parser_ok on success, parser_cbor_error_unexpected on malformed or truncated data
  */
-parser_error_t read_int_array(
-    cbor_value_t *value,
-    int *values,
-    size_t *count);
+parser_error_t cbor_skip_item(cbor_reader_t *reader);
 
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
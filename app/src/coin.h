@@ -43,6 +43,7 @@ extern "C" {
 
 #define MAX_SIGN_SIZE 256u
 #define SHA256_DIGEST_SIZE 32u
+#define TXID_LEN 32u
 
 #define COIN_AMOUNT_DECIMAL_PLACES 6
 #define COIN_TICKER "ALGO "
@@ -66,6 +67,12 @@ extern "C" {
 #define P1_FIRST_ACCOUNT_ID 0x01
 #define P1_MORE  0x80
 #define P1_WITH_REQUEST_USER_APPROVAL  0x80
+// First chunk of INS_SIGN_MSGPACK: reply with the txid after the signature
+#define P1_RETURN_TXID 0x02
+// First chunk of INS_SIGN_MSGPACK: the payload is a delta against the previous transaction,
+// preceded by its length (2) and txid
+#define P1_DELTA 0x04
+#define DELTA_REFERENCE_LEN (2 + TXID_LEN)
 
 #define P2_LAST  0x00
 #define P2_MORE  0x80
@@ -75,6 +82,14 @@ extern "C" {
 #define INS_GET_ADDRESS     0x04
 #define INS_SIGN_MSGPACK    0x08
 #define INS_SIGN_DATA       0x10
+#define INS_GET_KEY_CACHE_STATS 0x11
+#define INS_GET_PUBLIC_KEYS 0x12
+#define INS_SIGN_GROUP      0x13
+#define INS_SIGN_DATA_BATCH 0x14
+#define INS_VALIDATE_MSGPACK 0x15
+#define INS_GET_TRACE       0x16
+
+#define P1_GET_SIGNATURES   0x03
 
 #ifdef __cplusplus
 }
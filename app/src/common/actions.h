@@ -25,6 +25,8 @@
 #include "zxerror.h"
 
 extern uint16_t action_addrResponseLen;
+// Set by the first INS_SIGN_MSGPACK chunk when P1_RETURN_TXID is present
+extern bool action_returnTxid;
 
 __Z_INLINE zxerr_t app_fill_address() {
     // Put data directly in the apdu buffer
@@ -45,55 +47,123 @@ __Z_INLINE void app_sign() {
     const uint16_t messageLength = tx_get_buffer_length();
 
     zxerr_t err = crypto_sign(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3, message, messageLength);
+    uint16_t replyLen = SK_LEN_25519;
+
+    if (err == zxerr_ok && action_returnTxid) {
+        err = crypto_txid(message, messageLength, G_io_apdu_buffer + SK_LEN_25519,
+                          IO_APDU_BUFFER_SIZE - 3 - SK_LEN_25519);
+        replyLen += TXID_LEN;
+    }
+    action_returnTxid = false;
 
     if (err != zxerr_ok) {
+        MEMZERO(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
         set_code(G_io_apdu_buffer, 0, APDU_CODE_SIGN_VERIFY_ERROR);
         io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
     } else {
-        set_code(G_io_apdu_buffer, SK_LEN_25519, APDU_CODE_OK);
-        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, SK_LEN_25519 + 2);
+        set_code(G_io_apdu_buffer, replyLen, APDU_CODE_OK);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, replyLen + 2);
     }
 }
 
-// EdDSA(SHA256(data) + SHA256(authenticatedData))
+// EdDSA(SHA256(data) + SHA256(authenticatedData)), both digests taken by the parser
 __Z_INLINE void app_sign_arbitrary() {
     parser_context_t *ctx = tx_get_parser_context();
-    const uint8_t *data = ctx->parser_arbitrary_data_obj->dataBuffer;
-    const uint16_t dataLen = ctx->parser_arbitrary_data_obj->dataLen;
-    const uint8_t *authData = ctx->parser_arbitrary_data_obj->authDataBuffer;
-    const uint16_t authDataLen = ctx->parser_arbitrary_data_obj->authDataLen;
 
-    uint8_t dataHash[SHA256_DIGEST_SIZE] = {0};
-    uint8_t authDataHash[SHA256_DIGEST_SIZE] = {0};
-    uint8_t message[SHA256_DIGEST_SIZE * 2] = {0};
-    uint16_t messageLength = SHA256_DIGEST_SIZE * 2;
+    zxerr_t err = crypto_signArbitraryData(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3,
+                                           ctx->parser_arbitrary_data_obj->dataDigest,
+                                           ctx->parser_arbitrary_data_obj->authDataDigest);
 
-    if (crypto_sha256(data, dataLen, dataHash, SHA256_DIGEST_SIZE) != zxerr_ok) {
+    if (err != zxerr_ok) {
         set_code(G_io_apdu_buffer, 0, APDU_CODE_SIGN_VERIFY_ERROR);
         io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
-        return;
+    } else {
+        set_code(G_io_apdu_buffer, SK_LEN_25519, APDU_CODE_OK);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, SK_LEN_25519 + 2);
+    }
+}
+
+#define SIGNATURES_PER_APDU ((IO_APDU_BUFFER_SIZE - 3) / ED25519_SIGNATURE_SIZE)
+
+typedef zxerr_t (*app_sign_nth_t)(uint8_t idx, uint8_t *signature);
+
+// Writes [N][N signatures] starting at the first-th signature of an approved multi-signature
+// request (group or challenge batch). The request is released once its last signature has
+// been returned.
+__Z_INLINE zxerr_t app_fill_signatures(uint8_t first, uint8_t total, bool approved,
+                                       app_sign_nth_t sign_nth, uint16_t *replyLen) {
+    if (!approved || first >= total) {
+        return zxerr_no_data;
     }
 
-    if (crypto_sha256(authData, authDataLen, authDataHash, SHA256_DIGEST_SIZE) != zxerr_ok) {
-        set_code(G_io_apdu_buffer, 0, APDU_CODE_SIGN_VERIFY_ERROR);
-        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
-        return;
+    uint8_t count = total - first;
+    if (count > SIGNATURES_PER_APDU) {
+        count = SIGNATURES_PER_APDU;
     }
 
-    MEMMOVE((void*)message, (void*)dataHash, SHA256_DIGEST_SIZE);
-    MEMMOVE((void*)(message + SHA256_DIGEST_SIZE), (void*)authDataHash, SHA256_DIGEST_SIZE);
+    MEMZERO(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
+    for (uint8_t i = 0; i < count; i++) {
+        CHECK_ZXERR(sign_nth(first + i, G_io_apdu_buffer + 1 + i * ED25519_SIGNATURE_SIZE))
+    }
+    G_io_apdu_buffer[0] = count;
+    *replyLen = 1 + count * ED25519_SIGNATURE_SIZE;
 
-    zxerr_t err = crypto_sign(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3, message, messageLength);
+    if (first + count == total) {
+        tx_reset();
+    }
+    return zxerr_ok;
+}
+
+__Z_INLINE void app_reply_signatures(app_sign_nth_t sign_nth, uint8_t total, bool approved) {
+    uint16_t replyLen = 0;
+    zxerr_t err = app_fill_signatures(0, total, approved, sign_nth, &replyLen);
 
     if (err != zxerr_ok) {
+        tx_reset();
+        MEMZERO(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
         set_code(G_io_apdu_buffer, 0, APDU_CODE_SIGN_VERIFY_ERROR);
         io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
     } else {
-        set_code(G_io_apdu_buffer, SK_LEN_25519, APDU_CODE_OK);
-        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, SK_LEN_25519 + 2);
+        set_code(G_io_apdu_buffer, replyLen, APDU_CODE_OK);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, replyLen + 2);
     }
 }
 
+__Z_INLINE zxerr_t app_sign_group_nth(uint8_t idx, uint8_t *signature) {
+    const uint8_t *message = NULL;
+    uint16_t messageLength = 0;
+    CHECK_ZXERR(tx_group_get_signable(idx, &message, &messageLength))
+    return crypto_sign(signature, ED25519_SIGNATURE_SIZE, message, messageLength);
+}
+
+__Z_INLINE zxerr_t app_fill_group_signatures(uint8_t first, uint16_t *replyLen) {
+    return app_fill_signatures(first, tx_group_sign_count(), tx_group_is_approved(),
+                               app_sign_group_nth, replyLen);
+}
+
+__Z_INLINE void app_sign_group() {
+    tx_group_approve();
+    app_reply_signatures(app_sign_group_nth, tx_group_sign_count(), tx_group_is_approved());
+}
+
+__Z_INLINE zxerr_t app_sign_arbitrary_batch_nth(uint8_t idx, uint8_t *signature) {
+    const parser_arbitrary_item_t *item = NULL;
+    CHECK_ZXERR(tx_arbitrary_batch_get_item(idx, &item))
+    return crypto_signArbitraryData(signature, ED25519_SIGNATURE_SIZE, item->dataDigest, item->authDataDigest);
+}
+
+__Z_INLINE zxerr_t app_fill_arbitrary_batch_signatures(uint8_t first, uint16_t *replyLen) {
+    return app_fill_signatures(first, tx_arbitrary_batch_count(), tx_arbitrary_batch_is_approved(),
+                               app_sign_arbitrary_batch_nth, replyLen);
+}
+
+// One EdDSA(SHA256(data) + SHA256(authenticatedData)) per challenge
+__Z_INLINE void app_sign_arbitrary_batch() {
+    tx_arbitrary_batch_approve();
+    app_reply_signatures(app_sign_arbitrary_batch_nth, tx_arbitrary_batch_count(),
+                         tx_arbitrary_batch_is_approved());
+}
+
 __Z_INLINE void app_reject() {
     MEMZERO(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
     set_code(G_io_apdu_buffer, 0, APDU_CODE_COMMAND_NOT_ALLOWED);
@@ -16,6 +16,7 @@
 ********************************************************************************/
 #include "app_main.h"
 #include "view.h"
+#include "key_cache.h"
 
 #include <os_io_seproxyhal.h>
 
@@ -43,4 +44,6 @@ main(void) {
         {}
     }
     END_TRY;
+    // Derived keys must not outlive the app, see key_cache.h
+    key_cache_reset();
 }
@@ -34,7 +34,9 @@ extern "C" {
 
 // Request ID in binary can be up to 255 bytes, so in base64 it can be up to 340 bytes
 #define REQUEST_ID_MAX_LEN 255
-#define BASE64_REQUEST_ID_MAX_LEN 340
+
+// Batch review: signer, domain, number of challenges and hdPath
+#define ARBITRARY_BATCH_NUM_ITEMS 4
 const char *parser_getErrorDescription(parser_error_t err);
 const char *parser_getMsgPackTypeDescription(uint8_t type);
 
@@ -66,7 +68,8 @@ parser_error_t parser_getItem(parser_context_t *ctx,
 parser_error_t getItem(uint8_t index, uint8_t* displayIdx);
 
 parser_error_t parser_jsonGetNthKey(parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen);
-parser_error_t parser_jsonGetNthValue(parser_context_t *ctx, uint8_t displayIdx, char *outVal, uint16_t outValLen);
+// Raw value in the JSON data: pageJsonString drops the backslashes when it is shown
+parser_error_t parser_jsonGetNthValue(parser_context_t *ctx, uint8_t displayIdx, const char **value, uint16_t *valueLen);
 
 #ifdef __cplusplus
 }
@@ -104,6 +104,14 @@ typedef enum {
     parser_cbor_error_out_of_memory = 55,
     parser_cbor_error_container = 56,
     parser_cbor_error_invalid_parameters = 57,
+
+    // Group signing
+    parser_invalid_group = 58,
+
+    // Canonical MsgPack
+    parser_msgpack_unsorted_keys = 59,
+    parser_msgpack_non_minimal_encoding = 60,
+    parser_msgpack_zero_value = 61,
 } parser_error_t;
 
 typedef struct {
@@ -113,6 +121,7 @@ typedef struct {
     txn_content_e content;
     parser_tx_t *parser_tx_obj;
     parser_arbitrary_data_t *parser_arbitrary_data_obj;
+    parser_arbitrary_batch_t *parser_arbitrary_batch_obj;
 } parser_context_t;
 
 #ifdef __cplusplus
@@ -18,6 +18,11 @@
 #include "apdu_codes.h"
 #include "buffering.h"
 #include "common/parser.h"
+#include "parser_group.h"
+#include "delta.h"
+#include "crypto.h"
+#include "profile.h"
+#include "trace.h"
 #include <string.h>
 #include "zxmacros.h"
 
@@ -38,12 +43,40 @@ typedef struct
 #if defined(LEDGER_SPECIFIC)
 storage_t NV_CONST N_appdata_impl __attribute__((aligned(64)));
 #define N_appdata (*(NV_VOLATILE storage_t *)PIC(&N_appdata_impl))
+#else
+// Host builds (tools/apdu_harness) keep the flash buffer in RAM
+static storage_t N_appdata;
 #endif
 
 static parser_tx_t parser_tx_obj;
 static parser_arbitrary_data_t parser_arbitrary_data_obj;
+static parser_arbitrary_batch_t parser_arbitrary_batch_obj;
 static parser_context_t ctx_parsed_tx;
 
+typedef struct {
+    uint32_t hdPath[HDPATH_LEN_DEFAULT];
+    uint8_t expectedTxns;
+    uint8_t receivedTxns;
+    uint8_t header[GROUP_ENTRY_HEADER_LEN];
+    uint8_t headerLen;
+    uint16_t pendingLen;
+    bool parsed;
+    bool approved;
+} tx_group_state_t;
+
+static tx_group_state_t group_state;
+static parser_group_t parser_group_obj;
+
+typedef struct {
+    uint32_t hdPath[HDPATH_LEN_DEFAULT];
+    bool parsed;
+    bool approved;
+} tx_batch_state_t;
+
+static tx_batch_state_t batch_state;
+
+static delta_state_t delta_state;
+
 void tx_initialize()
 {
     buffering_init(
@@ -56,11 +89,18 @@ void tx_initialize()
 void tx_reset()
 {
     buffering_reset();
+    MEMZERO(&group_state, sizeof(group_state));
+    MEMZERO(&batch_state, sizeof(batch_state));
+    MEMZERO(&delta_state, sizeof(delta_state));
 }
 
 uint32_t tx_append(unsigned char *buffer, uint32_t length)
 {
-    return buffering_append(buffer, length);
+    const uint32_t added = buffering_append(buffer, length);
+    if (buffering_get_buffer()->data != ram_buffer) {
+        TRACE_EVENT(TRACE_NVM_WRITE, added);
+    }
+    return added;
 }
 
 uint32_t tx_get_buffer_length()
@@ -80,8 +120,11 @@ parser_context_t *tx_get_parser_context()
 
 parser_error_t tx_parse(txn_content_e content)
 {
+    profile_reset();
     MEMZERO(&parser_tx_obj, sizeof(parser_tx_obj));
     MEMZERO(&parser_arbitrary_data_obj, sizeof(parser_arbitrary_data_obj));
+    MEMZERO(&parser_arbitrary_batch_obj, sizeof(parser_arbitrary_batch_obj));
+    MEMZERO(&batch_state, sizeof(batch_state));
 
     uint8_t err = parser_unexpected_error;
     void *parser_obj = NULL;
@@ -92,15 +135,19 @@ parser_error_t tx_parse(txn_content_e content)
         offset = TX_PREFIX_LENGTH;   // 'TX' is prepended to input buffer
     } else if (content == ArbitraryData) {
         parser_obj = (void *) &parser_arbitrary_data_obj;
+    } else if (content == ArbitraryDataBatch) {
+        parser_obj = (void *) &parser_arbitrary_batch_obj;
     } else {
         return parser_unexpected_error;
     }
 
+    TRACE_EVENT(TRACE_PARSE_START, content);
     err = parser_parse(&ctx_parsed_tx,
                                    tx_get_buffer() + offset,
                                    tx_get_buffer_length() - offset,
                                    parser_obj,
                                    content);
+    TRACE_EVENT(TRACE_PARSE_END, err);
     CHECK_APP_CANARY()
 
     if (err != parser_ok)
@@ -109,6 +156,7 @@ parser_error_t tx_parse(txn_content_e content)
     }
 
     err = parser_validate(&ctx_parsed_tx);
+    TRACE_EVENT(TRACE_VALIDATE_END, err);
     CHECK_APP_CANARY()
 
     if (err != parser_ok)
@@ -116,6 +164,11 @@ parser_error_t tx_parse(txn_content_e content)
         return err;
     }
 
+    if (content == ArbitraryDataBatch) {
+        MEMCPY(batch_state.hdPath, hdPath, sizeof(batch_state.hdPath));
+        batch_state.parsed = true;
+    }
+
     return parser_ok;
 }
 
@@ -146,6 +199,11 @@ zxerr_t tx_getItem(int8_t displayIdx,
         return zxerr_no_data;
     }
 
+    // The review starts on the first page of the first item
+    if (displayIdx == 0 && pageIdx == 0) {
+        TRACE_EVENT(TRACE_FIRST_RENDER, 0);
+    }
+
     parser_error_t err = parser_getItem(&ctx_parsed_tx,
                                         displayIdx,
                                         outKey, outKeyLen,
@@ -163,3 +221,207 @@ zxerr_t tx_getItem(int8_t displayIdx,
 
     return zxerr_ok;
 }
+
+void tx_group_init(uint8_t txnCount)
+{
+    MEMZERO(&group_state, sizeof(group_state));
+    MEMZERO(&parser_group_obj, sizeof(parser_group_obj));
+    MEMCPY(group_state.hdPath, hdPath, sizeof(group_state.hdPath));
+    group_state.expectedTxns = txnCount;
+}
+
+// Entries arrive as flags | length | msgpack and may be split anywhere across chunks.
+// "TX" is inserted after each header so every buffered transaction can be signed in place.
+zxerr_t tx_group_append(const uint8_t *buffer, uint32_t length)
+{
+    static const uint8_t prefix[] = {'T', 'X'};
+
+    while (length > 0) {
+        if (group_state.pendingLen == 0) {
+            group_state.header[group_state.headerLen++] = *buffer++;
+            length--;
+            if (group_state.headerLen < GROUP_ENTRY_HEADER_LEN) {
+                continue;
+            }
+
+            group_state.headerLen = 0;
+            group_state.pendingLen = (uint16_t) ((group_state.header[1] << 8) | group_state.header[2]);
+            if (group_state.pendingLen == 0 || group_state.receivedTxns >= group_state.expectedTxns) {
+                return zxerr_out_of_bounds;
+            }
+            group_state.receivedTxns++;
+            if (tx_append(group_state.header, sizeof(group_state.header)) != sizeof(group_state.header) ||
+                tx_append((unsigned char *) prefix, sizeof(prefix)) != sizeof(prefix)) {
+                return zxerr_buffer_too_small;
+            }
+            continue;
+        }
+
+        const uint32_t take = length < group_state.pendingLen ? length : group_state.pendingLen;
+        if (tx_append((unsigned char *) buffer, take) != take) {
+            return zxerr_buffer_too_small;
+        }
+        buffer += take;
+        length -= take;
+        group_state.pendingLen -= (uint16_t) take;
+    }
+    return zxerr_ok;
+}
+
+parser_error_t tx_group_parse()
+{
+    profile_reset();
+    group_state.parsed = false;
+    group_state.approved = false;
+
+    if (group_state.headerLen != 0 || group_state.pendingLen != 0 ||
+        group_state.receivedTxns != group_state.expectedTxns) {
+        return parser_unexpected_buffer_end;
+    }
+
+    // Senders other than this account are listed in the review
+    uint8_t signer[PK_LEN_25519] = {0};
+    if (crypto_extractPublicKey(signer, sizeof(signer)) != zxerr_ok) {
+        return parser_invalid_signer;
+    }
+
+    MEMZERO(&parser_tx_obj, sizeof(parser_tx_obj));
+    const parser_error_t err = parser_group_parse(tx_get_buffer(), (uint16_t) tx_get_buffer_length(),
+                                                  group_state.expectedTxns, signer,
+                                                  &parser_group_obj, &parser_tx_obj);
+    CHECK_APP_CANARY()
+    MEMZERO(&parser_tx_obj, sizeof(parser_tx_obj));
+
+    group_state.parsed = err == parser_ok;
+    return err;
+}
+
+zxerr_t tx_group_getNumItems(uint8_t *num_items)
+{
+    if (!group_state.parsed || parser_group_getNumItems(&parser_group_obj, num_items) != parser_ok) {
+        return zxerr_unknown;
+    }
+    return zxerr_ok;
+}
+
+zxerr_t tx_group_getItem(int8_t displayIdx,
+                         char *outKey, uint16_t outKeyLen,
+                         char *outValue, uint16_t outValueLen,
+                         uint8_t pageIdx, uint8_t *pageCount)
+{
+    if (!group_state.parsed || displayIdx < 0) {
+        return zxerr_no_data;
+    }
+
+    const parser_error_t err = parser_group_getItem(&parser_group_obj, &parser_tx_obj, (uint8_t) displayIdx,
+                                                    outKey, outKeyLen, outValue, outValueLen,
+                                                    pageIdx, pageCount);
+    if (err == parser_display_idx_out_of_range || err == parser_display_page_out_of_range) {
+        return zxerr_no_data;
+    }
+    if (err != parser_ok) {
+        return zxerr_unknown;
+    }
+    return zxerr_ok;
+}
+
+void tx_group_approve()
+{
+    group_state.approved = group_state.parsed;
+}
+
+bool tx_group_is_approved()
+{
+    return group_state.approved;
+}
+
+uint8_t tx_group_sign_count()
+{
+    return group_state.parsed ? parser_group_obj.signCount : 0;
+}
+
+zxerr_t tx_group_get_signable(uint8_t signIdx, const uint8_t **message, uint16_t *messageLen)
+{
+    if (!group_state.approved || signIdx >= parser_group_obj.signCount) {
+        return zxerr_no_data;
+    }
+    // Other instructions may have changed hdPath since the group was received
+    MEMCPY(hdPath, group_state.hdPath, sizeof(group_state.hdPath));
+    if (parser_group_getSignable(tx_get_buffer(), (uint16_t) tx_get_buffer_length(),
+                                 signIdx, message, messageLen) != parser_ok) {
+        return zxerr_unknown;
+    }
+    return zxerr_ok;
+}
+
+void tx_arbitrary_batch_approve()
+{
+    batch_state.approved = batch_state.parsed;
+}
+
+bool tx_arbitrary_batch_is_approved()
+{
+    return batch_state.approved;
+}
+
+uint8_t tx_arbitrary_batch_count()
+{
+    return batch_state.parsed ? parser_arbitrary_batch_obj.itemCount : 0;
+}
+
+zxerr_t tx_arbitrary_batch_get_item(uint8_t idx, const parser_arbitrary_item_t **item)
+{
+    if (!batch_state.approved || idx >= parser_arbitrary_batch_obj.itemCount || item == NULL) {
+        return zxerr_no_data;
+    }
+    // Other instructions may have changed hdPath since the batch was received
+    MEMCPY(hdPath, batch_state.hdPath, sizeof(batch_state.hdPath));
+    *item = &parser_arbitrary_batch_obj.items[idx];
+    return zxerr_ok;
+}
+
+// The previous transaction is still at the start of the RAM buffer as "TX" || msgpack unless it
+// did not fit there. It is moved to the end of the RAM buffer, which is shrunk accordingly, so
+// the rebuilt transaction can be appended (and spill to flash) without overwriting it.
+zxerr_t tx_delta_init(uint16_t referenceLen, const uint8_t referenceTxid[TXID_LEN])
+{
+    uint8_t txid[TXID_LEN];
+
+    if (referenceLen == 0 || TX_PREFIX_LENGTH + referenceLen > RAM_BUFFER_SIZE / 2 ||
+        ram_buffer[0] != 'T' || ram_buffer[1] != 'X') {
+        return zxerr_no_data;
+    }
+    CHECK_ZXERR(crypto_txid(ram_buffer, TX_PREFIX_LENGTH + referenceLen, txid, sizeof(txid)))
+    if (MEMCMP(txid, referenceTxid, TXID_LEN) != 0) {
+        return zxerr_no_data;
+    }
+
+    uint8_t *reference = ram_buffer + RAM_BUFFER_SIZE - referenceLen;
+    memmove(reference, ram_buffer + TX_PREFIX_LENGTH, referenceLen);
+    buffering_init(
+        ram_buffer,
+        RAM_BUFFER_SIZE - referenceLen,
+        (uint8_t *)N_appdata.buffer,
+        sizeof(N_appdata.buffer));
+    tx_reset();
+
+    delta_init(&delta_state, reference, referenceLen);
+    return zxerr_ok;
+}
+
+bool tx_delta_active()
+{
+    return delta_state.active;
+}
+
+zxerr_t tx_delta_append(const uint8_t *buffer, uint32_t length)
+{
+    return delta_apply(&delta_state, buffer, length, tx_append);
+}
+
+zxerr_t tx_delta_finish()
+{
+    const zxerr_t err = delta_finish(&delta_state);
+    delta_state.active = false;
+    return err;
+}
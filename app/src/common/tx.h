@@ -49,6 +49,9 @@ parser_context_t *tx_get_parser_context();
 /// \return It returns NULL if data is valid or error message otherwise.
 parser_error_t tx_parse(txn_content_e content);
 
+/// Clears the parsed transaction, leaving the transaction buffer as it is
+void tx_parse_reset();
+
 /// Return the number of items in the transaction
 zxerr_t tx_getNumItems(uint8_t *num_items);
 
@@ -57,3 +60,55 @@ zxerr_t tx_getItem(int8_t displayIdx,
                    char *outKey, uint16_t outKeyLen,
                    char *outValue, uint16_t outValueLen,
                    uint8_t pageIdx, uint8_t *pageCount);
+
+/// Starts buffering an atomic group of txnCount transactions, signed with the current hdPath
+void tx_group_init(uint8_t txnCount);
+
+/// Appends a chunk of group entries (flags | msgpack length | msgpack)
+zxerr_t tx_group_append(const uint8_t *buffer, uint32_t length);
+
+/// Parses the buffered group, checking every transaction and the group hash
+parser_error_t tx_group_parse();
+
+/// Items of the aggregated group review
+zxerr_t tx_group_getNumItems(uint8_t *num_items);
+zxerr_t tx_group_getItem(int8_t displayIdx,
+                         char *outKey, uint16_t outKeyLen,
+                         char *outValue, uint16_t outValueLen,
+                         uint8_t pageIdx, uint8_t *pageCount);
+
+/// Marks the parsed group as approved by the user; cleared by tx_reset()
+void tx_group_approve();
+bool tx_group_is_approved();
+
+/// Number of transactions in the group flagged for signing
+uint8_t tx_group_sign_count();
+
+/// "TX" || msgpack of the signIdx-th transaction to sign, only once the group is approved.
+/// Also restores the group's hdPath for the following crypto_sign.
+zxerr_t tx_group_get_signable(uint8_t signIdx, const uint8_t **message, uint16_t *messageLen);
+
+/// Marks the parsed challenge batch as approved by the user; cleared by tx_reset()
+void tx_arbitrary_batch_approve();
+bool tx_arbitrary_batch_is_approved();
+
+/// Number of challenges in the parsed batch
+uint8_t tx_arbitrary_batch_count();
+
+/// idx-th challenge of the batch, only once it is approved.
+/// Also restores the batch's hdPath for the following signature.
+zxerr_t tx_arbitrary_batch_get_item(uint8_t idx, const parser_arbitrary_item_t **item);
+
+/// Starts rebuilding a transaction from a delta against the previous one, which must still be
+/// in the RAM buffer, be referenceLen bytes long (without "TX") and hash to referenceTxid.
+/// Resets the transaction buffer; tx_initialize() restores its full size.
+zxerr_t tx_delta_init(uint16_t referenceLen, const uint8_t referenceTxid[TXID_LEN]);
+
+/// True between tx_delta_init() and tx_delta_finish()
+bool tx_delta_active();
+
+/// Decodes a chunk of delta operations, appending the rebuilt bytes to the transaction buffer
+zxerr_t tx_delta_append(const uint8_t *buffer, uint32_t length);
+
+/// Checks that the delta is complete and leaves delta mode
+zxerr_t tx_delta_finish();
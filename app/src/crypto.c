@@ -18,30 +18,22 @@
 #include "coin.h"
 #include "zxmacros.h"
 #include "parser_encoding.h"
+#include "crypto_utils.h"
+#include "key_cache.h"
+#include "trace.h"
+#include "bip32_ed25519.h"
+#include "sha512.h"
+#include <string.h>
 
 #if defined(LEDGER_SPECIFIC)
 #include "cx.h"
-zxerr_t crypto_extractPublicKey(uint8_t *pubKey, uint16_t pubKeyLen) {
-    if (pubKey == NULL || pubKeyLen < PK_LEN_25519) {
-        return zxerr_invalid_crypto_settings;
-    }
 
+static zxerr_t crypto_publicKeyFromSeed(const uint8_t seed[SCALAR_LEN_ED25519], uint8_t pubKey[PK_LEN_25519]) {
     zxerr_t error = zxerr_unknown;
     cx_ecfp_public_key_t cx_publicKey;
     cx_ecfp_private_key_t cx_privateKey;
-    uint8_t privateKeyData[SK_LEN_25519] = {0};
-
-    // Generate keys
-    CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL,
-                                                     CX_CURVE_Ed25519,
-                                                     hdPath,
-                                                     HDPATH_LEN_DEFAULT,
-                                                     privateKeyData,
-                                                     NULL,
-                                                     NULL,
-                                                     0));
 
-    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519, privateKeyData, 32, &cx_privateKey));
+    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519, seed, SCALAR_LEN_ED25519, &cx_privateKey));
     CATCH_CXERROR(cx_ecfp_init_public_key_no_throw(CX_CURVE_Ed25519, NULL, 0, &cx_publicKey));
     CATCH_CXERROR(cx_ecfp_generate_pair_no_throw(CX_CURVE_Ed25519, &cx_publicKey, &cx_privateKey, 1));
 
@@ -56,25 +48,35 @@ zxerr_t crypto_extractPublicKey(uint8_t *pubKey, uint16_t pubKeyLen) {
 
 catch_cx_error:
     MEMZERO(&cx_privateKey, sizeof(cx_privateKey));
-    MEMZERO(privateKeyData, SK_LEN_25519);
+    return error;
+}
+
+static zxerr_t crypto_deriveNode(const uint32_t *path, uint8_t pathLen, bip32_ed25519_node_t *node) {
+    zxerr_t error = zxerr_unknown;
+
+    CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL,
+                                                     CX_CURVE_Ed25519,
+                                                     path,
+                                                     pathLen,
+                                                     node->key,
+                                                     node->chainCode,
+                                                     NULL,
+                                                     0));
+    error = zxerr_ok;
 
+catch_cx_error:
     if (error != zxerr_ok) {
-        MEMZERO(pubKey, pubKeyLen);
+        MEMZERO(node, sizeof(*node));
     }
-
     return error;
 }
 
-zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen) {
-    if (signature == NULL || message == NULL || signatureMaxlen < ED25519_SIGNATURE_SIZE || messageLen == 0) {
-        return zxerr_unknown;
-    }
-
-    cx_ecfp_private_key_t cx_privateKey;
-    uint8_t privateKeyData[SK_LEN_25519] = {0};
-
+// Derives the EdDSA seed (kL) for hdPath and its public key
+static zxerr_t crypto_deriveKeyPair(uint8_t seed[SCALAR_LEN_ED25519], uint8_t pubKey[PK_LEN_25519]) {
     zxerr_t error = zxerr_unknown;
+    uint8_t privateKeyData[SK_LEN_25519] = {0};
 
+    // Generate keys
     CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL,
                                                      CX_CURVE_Ed25519,
                                                      hdPath,
@@ -84,7 +86,24 @@ zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t
                                                      NULL,
                                                      0));
 
-    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519, privateKeyData, 32, &cx_privateKey));
+    error = crypto_publicKeyFromSeed(privateKeyData, pubKey);
+    if (error == zxerr_ok) {
+        MEMCPY(seed, privateKeyData, SCALAR_LEN_ED25519);
+    }
+
+catch_cx_error:
+    MEMZERO(privateKeyData, SK_LEN_25519);
+    return error;
+}
+
+static zxerr_t crypto_signWithSeed(uint8_t *signature, uint16_t signatureMaxlen,
+                                   const uint8_t *message, uint16_t messageLen,
+                                   const uint8_t seed[SCALAR_LEN_ED25519],
+                                   __Z_UNUSED const uint8_t pubKey[PK_LEN_25519]) {
+    cx_ecfp_private_key_t cx_privateKey;
+    zxerr_t error = zxerr_unknown;
+
+    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519, seed, SCALAR_LEN_ED25519, &cx_privateKey));
     CATCH_CXERROR(cx_eddsa_sign_no_throw(&cx_privateKey,
                                          CX_SHA512,
                                          message,
@@ -95,12 +114,127 @@ zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t
 
 catch_cx_error:
     MEMZERO(&cx_privateKey, sizeof(cx_privateKey));
+    return error;
+}
+
+#else
+#include "crypto_host.h"
+#include "ed25519.h"
+
+static zxerr_t crypto_publicKeyFromSeed(const uint8_t seed[SCALAR_LEN_ED25519], uint8_t pubKey[PK_LEN_25519]) {
+    ed25519_publickey(pubKey, seed);
+    return zxerr_ok;
+}
+
+static zxerr_t crypto_deriveNode(const uint32_t *path, uint8_t pathLen, bip32_ed25519_node_t *node) {
+    return crypto_host_derive_ed25519(path, pathLen, node->key, node->chainCode);
+}
+
+static zxerr_t crypto_deriveKeyPair(uint8_t seed[SCALAR_LEN_ED25519], uint8_t pubKey[PK_LEN_25519]) {
+    uint8_t privateKeyData[SK_LEN_25519] = {0};
+    zxerr_t error = crypto_host_derive_ed25519(hdPath, HDPATH_LEN_DEFAULT, privateKeyData, NULL);
+    if (error == zxerr_ok) {
+        // Like cx_ecfp_init_private_key(..., 32, ...): only kL is used, as the EdDSA seed
+        error = crypto_publicKeyFromSeed(privateKeyData, pubKey);
+        MEMCPY(seed, privateKeyData, SCALAR_LEN_ED25519);
+    }
     MEMZERO(privateKeyData, SK_LEN_25519);
+    return error;
+}
+
+static zxerr_t crypto_signWithSeed(uint8_t *signature, __Z_UNUSED uint16_t signatureMaxlen,
+                                   const uint8_t *message, uint16_t messageLen,
+                                   const uint8_t seed[SCALAR_LEN_ED25519],
+                                   const uint8_t pubKey[PK_LEN_25519]) {
+    ed25519_sign(signature, message, messageLen, seed, pubKey);
+    return zxerr_ok;
+}
+#endif
+
+// Returns the key pair for hdPath, deriving it only when it is not cached yet
+static zxerr_t crypto_getKeyPair(uint8_t seed[SCALAR_LEN_ED25519], uint8_t pubKey[PK_LEN_25519]) {
+    if (key_cache_lookup(hdPath, seed, pubKey)) {
+        return zxerr_ok;
+    }
+    TRACE_EVENT(TRACE_KEY_DERIVE_START, 0);
+    const zxerr_t error = crypto_deriveKeyPair(seed, pubKey);
+    TRACE_EVENT(TRACE_KEY_DERIVE_END, error);
+    CHECK_ZXERR(error)
+    key_cache_store(hdPath, seed, pubKey);
+    return zxerr_ok;
+}
+
+zxerr_t crypto_extractPublicKey(uint8_t *pubKey, uint16_t pubKeyLen) {
+    if (pubKey == NULL || pubKeyLen < PK_LEN_25519) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    uint8_t seed[SCALAR_LEN_ED25519] = {0};
+    const zxerr_t error = crypto_getKeyPair(seed, pubKey);
+    MEMZERO(seed, sizeof(seed));
 
     if (error != zxerr_ok) {
-        MEMZERO(signature, signatureMaxlen);
+        MEMZERO(pubKey, pubKeyLen);
+    }
+    return error;
+}
+
+// The account level is hardened, so every key needs the private parent node: derive
+// m/44'/283' once through the OS and walk account'/0/0 in the app for each index
+zxerr_t crypto_extractPublicKeys(uint32_t firstAccount, uint8_t count, uint8_t *buffer, uint16_t bufferLen) {
+    if (buffer == NULL || count == 0 || bufferLen < (uint16_t) count * PK_LEN_25519 ||
+        firstAccount >= BIP32_HARDENED_BIT || BIP32_HARDENED_BIT - firstAccount < count) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    // Both nodes hold extended private keys: every path below wipes them, and a child is
+    // wiped as soon as its public key is out, whether or not its derivation succeeded
+    const uint32_t parentPath[] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT};
+    bip32_ed25519_node_t parent;
+    bip32_ed25519_node_t child;
+    zxerr_t error = crypto_deriveNode(parentPath, sizeof(parentPath) / sizeof(parentPath[0]), &parent);
+
+    for (uint8_t i = 0; i < count && error == zxerr_ok; i++) {
+        MEMCPY(&child, &parent, sizeof(child));
+        error = bip32_ed25519_derive_child(&child, HDPATH_2_DEFAULT | (firstAccount + i));
+        if (error == zxerr_ok) {
+            error = bip32_ed25519_derive_child(&child, HDPATH_3_DEFAULT);
+        }
+        if (error == zxerr_ok) {
+            error = bip32_ed25519_derive_child(&child, HDPATH_4_DEFAULT);
+        }
+        if (error == zxerr_ok) {
+            error = crypto_publicKeyFromSeed(child.key, buffer + (uint16_t) i * PK_LEN_25519);
+        }
+        explicit_bzero(&child, sizeof(child));
+    }
+
+    explicit_bzero(&parent, sizeof(parent));
+    if (error != zxerr_ok) {
+        MEMZERO(buffer, bufferLen);
     }
+    return error;
+}
 
+zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen) {
+    if (signature == NULL || message == NULL || signatureMaxlen < ED25519_SIGNATURE_SIZE || messageLen == 0) {
+        return zxerr_unknown;
+    }
+
+    uint8_t seed[SCALAR_LEN_ED25519] = {0};
+    uint8_t pubKey[PK_LEN_25519] = {0};
+
+    TRACE_EVENT(TRACE_SIGN_START, 0);
+    zxerr_t error = crypto_getKeyPair(seed, pubKey);
+    if (error == zxerr_ok) {
+        error = crypto_signWithSeed(signature, signatureMaxlen, message, messageLen, seed, pubKey);
+    }
+    TRACE_EVENT(TRACE_SIGN_END, error);
+    MEMZERO(seed, sizeof(seed));
+
+    if (error != zxerr_ok) {
+        MEMZERO(signature, signatureMaxlen);
+    }
     return error;
 }
 
@@ -126,6 +260,28 @@ zxerr_t crypto_fillAddress(uint8_t *buffer, uint16_t bufferLen, uint16_t *addrRe
     return zxerr_ok;
 }
 
-#endif
-uint32_t hdPath[HDPATH_LEN_DEFAULT];
+zxerr_t crypto_signArbitraryData(uint8_t *signature, uint16_t signatureMaxlen,
+                                 const uint8_t *dataDigest, const uint8_t *authDataDigest) {
+    if (dataDigest == NULL || authDataDigest == NULL) {
+        return zxerr_unknown;
+    }
+    uint8_t message[SHA256_DIGEST_SIZE * 2] = {0};
+
+    MEMCPY(message, dataDigest, SHA256_DIGEST_SIZE);
+    MEMCPY(message + SHA256_DIGEST_SIZE, authDataDigest, SHA256_DIGEST_SIZE);
+
+    return crypto_sign(signature, signatureMaxlen, message, sizeof(message));
+}
 
+zxerr_t crypto_txid(const uint8_t *message, uint16_t messageLen, uint8_t *txid, uint16_t txidLen) {
+    if (message == NULL || txid == NULL || messageLen == 0 || txidLen < TXID_LEN) {
+        return zxerr_unknown;
+    }
+    // The buffered message already carries the "TX" domain separator
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256(message, messageLen, digest);
+    MEMCPY(txid, digest, TXID_LEN);
+    return zxerr_ok;
+}
+
+uint32_t hdPath[HDPATH_LEN_DEFAULT];
@@ -25,13 +25,22 @@ extern "C" {
 #include <sigutils.h>
 #include "zxerror.h"
 
-#if defined(LEDGER_SPECIFIC)
 zxerr_t crypto_fillAddress(uint8_t *buffer, uint16_t bufferLen, uint16_t *addrResponseLen);
 
 zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen);
 
+// EdDSA(SHA256(data) + SHA256(authenticatedData)), from both digests
+zxerr_t crypto_signArbitraryData(uint8_t *signature, uint16_t signatureMaxlen,
+                                 const uint8_t *dataDigest, const uint8_t *authDataDigest);
+
 zxerr_t crypto_extractPublicKey(uint8_t *pubKey, uint16_t pubKeyLen);
-#endif
+
+// Transaction ID: SHA512/256("TX" || msgpack), message being the signed buffer
+zxerr_t crypto_txid(const uint8_t *message, uint16_t messageLen, uint8_t *txid, uint16_t txidLen);
+
+// Public keys of accounts firstAccount .. firstAccount + count - 1 (44'/283'/account'/0/0),
+// written back to back into buffer
+zxerr_t crypto_extractPublicKeys(uint32_t firstAccount, uint8_t count, uint8_t *buffer, uint16_t bufferLen);
 
 extern uint32_t hdPath[HDPATH_LEN_DEFAULT];
 
@@ -0,0 +1,183 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#if !defined(LEDGER_SPECIFIC)
+#include "crypto_host.h"
+#include "bip32_ed25519.h"
+#include "crypto_utils.h"
+#include "sha512.h"
+#include "coin.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define BIP39_SEED_LEN          64
+#define BIP39_PBKDF2_ROUNDS     2048
+#define HMAC_SHA512_BLOCK_LEN   128
+#define HMAC_SHA256_BLOCK_LEN   64
+
+static const uint8_t ed25519_seed_key[] = "ed25519 seed";
+
+static uint8_t bip39_seed[BIP39_SEED_LEN];
+static bool bip39_seed_ready = false;
+
+void crypto_host_hmac_sha512(const uint8_t *key, size_t keyLen,
+                             const uint8_t *data, size_t dataLen,
+                             uint8_t out[SHA512_DIGEST_LENGTH]) {
+    uint8_t pad[HMAC_SHA512_BLOCK_LEN] = {0};
+    uint8_t inner[SHA512_DIGEST_LENGTH];
+    mbedtls_sha512_context ctx;
+
+    if (keyLen > sizeof(pad)) {
+        SHA512(key, keyLen, pad);
+    } else {
+        memcpy(pad, key, keyLen);
+    }
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36;
+    }
+    SHA512_init(&ctx);
+    SHA512_update(&ctx, pad, sizeof(pad));
+    SHA512_update(&ctx, data, dataLen);
+    SHA512_final(&ctx, inner);
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36 ^ 0x5c;
+    }
+    SHA512_init(&ctx);
+    SHA512_update(&ctx, pad, sizeof(pad));
+    SHA512_update(&ctx, inner, sizeof(inner));
+    SHA512_final(&ctx, out);
+
+    secure_wipe(pad, sizeof(pad));
+    secure_wipe(inner, sizeof(inner));
+}
+
+static zxerr_t hmac_sha256(const uint8_t *key, size_t keyLen,
+                           const uint8_t *data, size_t dataLen,
+                           uint8_t out[SHA256_DIGEST_SIZE]) {
+    uint8_t pad[HMAC_SHA256_BLOCK_LEN] = {0};
+    uint8_t inner[SHA256_DIGEST_SIZE];
+    crypto_sha256_ctx_t ctx;
+    zxerr_t err = zxerr_unknown;
+
+    if (keyLen > sizeof(pad) || dataLen > UINT32_MAX) {
+        return zxerr_unknown;
+    }
+    memcpy(pad, key, keyLen);
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36;
+    }
+    if (crypto_sha256_init(&ctx) != zxerr_ok ||
+        crypto_sha256_update(&ctx, pad, sizeof(pad)) != zxerr_ok ||
+        crypto_sha256_update(&ctx, data, (uint32_t) dataLen) != zxerr_ok ||
+        crypto_sha256_final(&ctx, inner, sizeof(inner)) != zxerr_ok) {
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36 ^ 0x5c;
+    }
+    if (crypto_sha256_init(&ctx) != zxerr_ok ||
+        crypto_sha256_update(&ctx, pad, sizeof(pad)) != zxerr_ok ||
+        crypto_sha256_update(&ctx, inner, sizeof(inner)) != zxerr_ok ||
+        crypto_sha256_final(&ctx, out, SHA256_DIGEST_SIZE) != zxerr_ok) {
+        goto cleanup;
+    }
+    err = zxerr_ok;
+
+cleanup:
+    secure_wipe(pad, sizeof(pad));
+    secure_wipe(inner, sizeof(inner));
+    return err;
+}
+
+// BIP39: seed = PBKDF2-HMAC-SHA512(mnemonic, "mnemonic", 2048), one 64-byte block
+static void bip39_mnemonic_to_seed(const char *mnemonic, uint8_t seed[BIP39_SEED_LEN]) {
+    static const uint8_t salt[] = {'m', 'n', 'e', 'm', 'o', 'n', 'i', 'c', 0, 0, 0, 1};
+    const size_t mnemonicLen = strlen(mnemonic);
+    uint8_t u[SHA512_DIGEST_LENGTH];
+
+    crypto_host_hmac_sha512((const uint8_t *) mnemonic, mnemonicLen, salt, sizeof(salt), u);
+    memcpy(seed, u, BIP39_SEED_LEN);
+    for (uint16_t round = 1; round < BIP39_PBKDF2_ROUNDS; round++) {
+        crypto_host_hmac_sha512((const uint8_t *) mnemonic, mnemonicLen, u, sizeof(u), u);
+        for (uint8_t i = 0; i < BIP39_SEED_LEN; i++) {
+            seed[i] ^= u[i];
+        }
+    }
+    secure_wipe(u, sizeof(u));
+}
+
+zxerr_t crypto_host_set_mnemonic(const char *mnemonic) {
+    if (mnemonic == NULL || mnemonic[0] == 0) {
+        return zxerr_unknown;
+    }
+    bip39_mnemonic_to_seed(mnemonic, bip39_seed);
+    bip39_seed_ready = true;
+    return zxerr_ok;
+}
+
+// The Ledger OS derives HDW_NORMAL Ed25519 keys with BIP32-Ed25519 (Khovratovich-Law)
+// rooted at the "ed25519 seed" master key, which is what os_derive_bip32 returns on device.
+zxerr_t crypto_host_derive_ed25519(const uint32_t *path, uint8_t pathLen,
+                                   uint8_t privateKey[CRYPTO_HOST_PRIVATE_KEY_LEN],
+                                   uint8_t *chainCode) {
+    if (path == NULL || privateKey == NULL) {
+        return zxerr_unknown;
+    }
+    if (!bip39_seed_ready) {
+        CHECK_ZXERR(crypto_host_set_mnemonic(CRYPTO_HOST_TEST_MNEMONIC))
+    }
+
+    bip32_ed25519_node_t node;
+    uint8_t data[1 + BIP39_SEED_LEN];
+    zxerr_t err = zxerr_unknown;
+
+    data[0] = 0x01;
+    memcpy(data + 1, bip39_seed, BIP39_SEED_LEN);
+    if (hmac_sha256(ed25519_seed_key, sizeof(ed25519_seed_key) - 1, data, sizeof(data), node.chainCode) != zxerr_ok) {
+        goto cleanup;
+    }
+
+    crypto_host_hmac_sha512(ed25519_seed_key, sizeof(ed25519_seed_key) - 1, bip39_seed, BIP39_SEED_LEN, node.key);
+    while ((node.key[31] & 0x20) != 0) {
+        crypto_host_hmac_sha512(ed25519_seed_key, sizeof(ed25519_seed_key) - 1, node.key, sizeof(node.key), node.key);
+    }
+    node.key[0] &= 0xF8;
+    node.key[31] = (node.key[31] & 0x7F) | 0x40;
+
+    for (uint8_t level = 0; level < pathLen; level++) {
+        if (bip32_ed25519_derive_child(&node, path[level]) != zxerr_ok) {
+            goto cleanup;
+        }
+    }
+
+    memcpy(privateKey, node.key, CRYPTO_HOST_PRIVATE_KEY_LEN);
+    if (chainCode != NULL) {
+        memcpy(chainCode, node.chainCode, BIP32_CHAIN_CODE_LEN);
+    }
+    err = zxerr_ok;
+
+cleanup:
+    secure_wipe((uint8_t *) &node, sizeof(node));
+    secure_wipe(data, sizeof(data));
+    if (err != zxerr_ok) {
+        secure_wipe(privateKey, CRYPTO_HOST_PRIVATE_KEY_LEN);
+    }
+    return err;
+}
+#endif
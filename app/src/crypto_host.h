@@ -0,0 +1,50 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "zxerror.h"
+
+#if !defined(LEDGER_SPECIFIC)
+// Mnemonic loaded by Zemu in tests_zemu, so host keys match the device under test
+#define CRYPTO_HOST_TEST_MNEMONIC \
+    "glory promote mansion idle axis finger extra february uncover one trip resource " \
+    "lawn turtle enact monster seven myth punch hobby comfort wild raise skin"
+
+#define CRYPTO_HOST_PRIVATE_KEY_LEN 64
+
+/// Replace the BIP39 mnemonic used to seed host derivations (empty passphrase)
+zxerr_t crypto_host_set_mnemonic(const char *mnemonic);
+
+/// Host equivalent of os_derive_bip32_with_seed_no_throw(HDW_NORMAL, CX_CURVE_Ed25519, ...):
+/// writes the 64-byte extended private key kL || kR for `path` and, if not NULL, its chain code
+zxerr_t crypto_host_derive_ed25519(const uint32_t *path, uint8_t pathLen,
+                                   uint8_t privateKey[CRYPTO_HOST_PRIVATE_KEY_LEN],
+                                   uint8_t *chainCode);
+
+void crypto_host_hmac_sha512(const uint8_t *key, size_t keyLen,
+                             const uint8_t *data, size_t dataLen,
+                             uint8_t out[64]);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,112 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#if !defined(LEDGER_SPECIFIC)
+#include "crypto_sha256_shani.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define CPUID_SSSE3_ECX   (1u << 9)
+#define CPUID_SSE41_ECX   (1u << 19)
+#define CPUID_SHA_EBX     (1u << 29)
+
+static const uint32_t K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+bool sha256_shani_supported(void) {
+    static int8_t supported = -1;
+    if (supported < 0) {
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        supported = 0;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+            (ecx & CPUID_SSSE3_ECX) != 0 && (ecx & CPUID_SSE41_ECX) != 0 &&
+            __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+            (ebx & CPUID_SHA_EBX) != 0) {
+            supported = 1;
+        }
+    }
+    return supported == 1;
+}
+
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha256_shani_compress(uint32_t state[8], const uint8_t *data, size_t blocks) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Reorder the state into the ABEF/CDGH layout expected by sha256rnds2
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[0]), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[4]), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (blocks-- > 0) {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i msg[4];
+
+        for (uint8_t group = 0; group < 16; group++) {
+            __m128i words;
+            if (group < 4) {
+                words = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 16 * group)), byteSwap);
+            } else {
+                words = _mm_sha256msg1_epu32(msg[group & 3], msg[(group + 1) & 3]);
+                words = _mm_add_epi32(words, _mm_alignr_epi8(msg[(group + 3) & 3], msg[(group + 2) & 3], 4));
+                words = _mm_sha256msg2_epu32(words, msg[(group + 3) & 3]);
+            }
+            msg[group & 3] = words;
+
+            __m128i rounds = _mm_add_epi32(words, _mm_loadu_si128((const __m128i *) &K256[4 * group]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, rounds);
+            rounds = _mm_shuffle_epi32(rounds, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, rounds);
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+        data += 64;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128((__m128i *) &state[0], state0);
+    _mm_storeu_si128((__m128i *) &state[4], state1);
+}
+
+#else
+
+bool sha256_shani_supported(void) {
+    return false;
+}
+
+void sha256_shani_compress(uint32_t state[8], const uint8_t *data, size_t blocks) {
+    (void) state;
+    (void) data;
+    (void) blocks;
+}
+
+#endif
+#endif
@@ -0,0 +1,35 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Host-only SHA-256 compression using the x86 SHA extensions.
+// On other architectures sha256_shani_supported() always returns false.
+bool sha256_shani_supported(void);
+
+// Process `blocks` consecutive 64-byte blocks into `state`.
+void sha256_shani_compress(uint32_t state[8], const uint8_t *data, size_t blocks);
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,25 +15,162 @@
 ********************************************************************************/
 #include "crypto_utils.h"
 #include "zxerror.h"
+#include "coin.h"
+#include <string.h>
+#if !defined(LEDGER_SPECIFIC)
+#include "crypto_sha256_shani.h"
+#include "profile.h"
+#endif
+
+#if !defined(LEDGER_SPECIFIC)
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+static int8_t selected_backend = -1;
+
+crypto_sha256_backend_e crypto_sha256_get_backend(void) {
+    if (selected_backend < 0) {
+        selected_backend = sha256_shani_supported() ? crypto_sha256_backend_shani
+                                                    : crypto_sha256_backend_portable;
+    }
+    return (crypto_sha256_backend_e) selected_backend;
+}
+
+zxerr_t crypto_sha256_set_backend(crypto_sha256_backend_e backend) {
+    switch (backend) {
+        case crypto_sha256_backend_portable:
+            break;
+        case crypto_sha256_backend_shani:
+            if (!sha256_shani_supported()) {
+                return zxerr_invalid_crypto_settings;
+            }
+            break;
+        default:
+            return zxerr_unknown;
+    }
+    selected_backend = (int8_t) backend;
+    return zxerr_ok;
+}
+
+static void shani_update(crypto_sha256_shani_ctx_t *ctx, const uint8_t *in, uint32_t inLen) {
+    ctx->totalLen += inLen;
+
+    if (ctx->blockLen > 0) {
+        const uint32_t fill = sizeof(ctx->block) - ctx->blockLen;
+        const uint32_t take = inLen < fill ? inLen : fill;
+        memcpy(ctx->block + ctx->blockLen, in, take);
+        ctx->blockLen += (uint8_t) take;
+        in += take;
+        inLen -= take;
+        if (ctx->blockLen < sizeof(ctx->block)) {
+            return;
+        }
+        sha256_shani_compress(ctx->state, ctx->block, 1);
+        ctx->blockLen = 0;
+    }
+
+    const uint32_t blocks = inLen / sizeof(ctx->block);
+    if (blocks > 0) {
+        sha256_shani_compress(ctx->state, in, blocks);
+        in += blocks * sizeof(ctx->block);
+        inLen -= blocks * sizeof(ctx->block);
+    }
+
+    if (inLen > 0) {
+        memcpy(ctx->block, in, inLen);
+        ctx->blockLen = (uint8_t) inLen;
+    }
+}
+
+static void shani_final(crypto_sha256_shani_ctx_t *ctx, uint8_t *digest) {
+    const uint64_t bitLen = ctx->totalLen * 8;
+
+    ctx->block[ctx->blockLen++] = 0x80;
+    if (ctx->blockLen > sizeof(ctx->block) - 8) {
+        memset(ctx->block + ctx->blockLen, 0, sizeof(ctx->block) - ctx->blockLen);
+        sha256_shani_compress(ctx->state, ctx->block, 1);
+        ctx->blockLen = 0;
+    }
+    memset(ctx->block + ctx->blockLen, 0, sizeof(ctx->block) - 8 - ctx->blockLen);
+    for (uint8_t i = 0; i < 8; i++) {
+        ctx->block[sizeof(ctx->block) - 1 - i] = (uint8_t) (bitLen >> (8 * i));
+    }
+    sha256_shani_compress(ctx->state, ctx->block, 1);
+
+    for (uint8_t i = 0; i < 8; i++) {
+        digest[4 * i] = (uint8_t) (ctx->state[i] >> 24);
+        digest[4 * i + 1] = (uint8_t) (ctx->state[i] >> 16);
+        digest[4 * i + 2] = (uint8_t) (ctx->state[i] >> 8);
+        digest[4 * i + 3] = (uint8_t) ctx->state[i];
+    }
+}
+#endif
+
+zxerr_t crypto_sha256_init(crypto_sha256_ctx_t *ctx) {
+    if (ctx == NULL) {
+        return zxerr_unknown;
+    }
+    memset(ctx, 0, sizeof(*ctx));
 #if defined(LEDGER_SPECIFIC)
-#include "cx.h"
+    cx_sha256_init(&ctx->cx);
 #else
-#include "picohash.h"
+    ctx->backend = crypto_sha256_get_backend();
+    if (ctx->backend == crypto_sha256_backend_shani) {
+        memcpy(ctx->u.shani.state, sha256_iv, sizeof(sha256_iv));
+    } else {
+        picohash_init_sha256(&ctx->u.pico);
+    }
 #endif
+    return zxerr_ok;
+}
 
-zxerr_t crypto_sha256(const uint8_t *in, uint16_t inLen, uint8_t *digest, uint16_t digestLen) {
+zxerr_t crypto_sha256_update(crypto_sha256_ctx_t *ctx, const uint8_t *in, uint32_t inLen) {
+    if (ctx == NULL || (in == NULL && inLen > 0)) {
+        return zxerr_unknown;
+    }
+    if (inLen == 0) {
+        return zxerr_ok;
+    }
+#if defined(LEDGER_SPECIFIC)
+    if (cx_hash_no_throw(&ctx->cx.header, 0, in, inLen, NULL, 0) != CX_OK) {
+        return zxerr_unknown;
+    }
+#else
+    if (ctx->backend == crypto_sha256_backend_shani) {
+        shani_update(&ctx->u.shani, in, inLen);
+    } else {
+        picohash_update(&ctx->u.pico, in, inLen);
+    }
+#endif
+    return zxerr_ok;
+}
+
+zxerr_t crypto_sha256_final(crypto_sha256_ctx_t *ctx, uint8_t *digest, uint16_t digestLen) {
+    if (ctx == NULL || digest == NULL || digestLen < SHA256_DIGEST_SIZE) {
+        return zxerr_unknown;
+    }
 #if defined(LEDGER_SPECIFIC)
-    cx_sha256_t ctx;
-    memset(&ctx, 0, sizeof(ctx));
-    cx_sha256_init(&ctx);
-    if (cx_hash_no_throw(&ctx.header, CX_LAST, in, inLen, digest, digestLen) != CX_OK) {
+    if (cx_hash_no_throw(&ctx->cx.header, CX_LAST, NULL, 0, digest, digestLen) != CX_OK) {
         return zxerr_unknown;
     }
 #else
-    picohash_ctx_t ctx;
-    picohash_init_sha256(&ctx);
-    picohash_update(&ctx, in, inLen);
-    picohash_final(&ctx, digest);
+    if (ctx->backend == crypto_sha256_backend_shani) {
+        shani_final(&ctx->u.shani, digest);
+    } else {
+        picohash_final(&ctx->u.pico, digest);
+    }
 #endif
+    memset(ctx, 0, sizeof(*ctx));
+    return zxerr_ok;
+}
+
+zxerr_t crypto_sha256(const uint8_t *in, uint16_t inLen, uint8_t *digest, uint16_t digestLen) {
+    crypto_sha256_ctx_t ctx;
+    PROFILE_COUNT(PROFILE_SHA256);
+    CHECK_ZXERR(crypto_sha256_init(&ctx))
+    CHECK_ZXERR(crypto_sha256_update(&ctx, in, inLen))
+    CHECK_ZXERR(crypto_sha256_final(&ctx, digest, digestLen))
     return zxerr_ok;
-}
\ No newline at end of file
+}
@@ -15,7 +15,58 @@
 ********************************************************************************/
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #include <stdint.h>
 #include "zxerror.h"
 
-zxerr_t crypto_sha256(const uint8_t *in, uint16_t inLen, uint8_t *digest, uint16_t digestLen);
\ No newline at end of file
+#if defined(LEDGER_SPECIFIC)
+#include "cx.h"
+#else
+#include "picohash.h"
+#endif
+
+#if !defined(LEDGER_SPECIFIC)
+typedef enum {
+    crypto_sha256_backend_portable = 0,
+    crypto_sha256_backend_shani = 1,
+} crypto_sha256_backend_e;
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t totalLen;
+    uint8_t block[64];
+    uint8_t blockLen;
+} crypto_sha256_shani_ctx_t;
+#endif
+
+typedef struct {
+#if defined(LEDGER_SPECIFIC)
+    cx_sha256_t cx;
+#else
+    crypto_sha256_backend_e backend;
+    union {
+        picohash_ctx_t pico;
+        crypto_sha256_shani_ctx_t shani;
+    } u;
+#endif
+} crypto_sha256_ctx_t;
+
+zxerr_t crypto_sha256(const uint8_t *in, uint16_t inLen, uint8_t *digest, uint16_t digestLen);
+
+zxerr_t crypto_sha256_init(crypto_sha256_ctx_t *ctx);
+zxerr_t crypto_sha256_update(crypto_sha256_ctx_t *ctx, const uint8_t *in, uint32_t inLen);
+zxerr_t crypto_sha256_final(crypto_sha256_ctx_t *ctx, uint8_t *digest, uint16_t digestLen);
+
+#if !defined(LEDGER_SPECIFIC)
+// Host only: the backend is picked on first use (SHA extensions when the CPU has them)
+// and can be forced afterwards to compare or benchmark both implementations.
+crypto_sha256_backend_e crypto_sha256_get_backend(void);
+zxerr_t crypto_sha256_set_backend(crypto_sha256_backend_e backend);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "delta.h"
+#include <string.h>
+
+void delta_init(delta_state_t *state, const uint8_t *reference, uint16_t referenceLen) {
+    memset(state, 0, sizeof(*state));
+    state->reference = reference;
+    state->referenceLen = referenceLen;
+    state->active = true;
+}
+
+static zxerr_t delta_runOp(delta_state_t *state, delta_sink_t sink) {
+    const uint16_t first = (uint16_t) ((state->header[1] << 8) | state->header[2]);
+
+    if (state->header[0] == DELTA_OP_INSERT) {
+        if (first == 0) {
+            return zxerr_out_of_bounds;
+        }
+        state->pendingInsert = first;
+        return zxerr_ok;
+    }
+
+    const uint16_t length = (uint16_t) ((state->header[3] << 8) | state->header[4]);
+    if (length == 0 || (uint32_t) first + length > state->referenceLen) {
+        return zxerr_out_of_bounds;
+    }
+    if (sink((unsigned char *) state->reference + first, length) != length) {
+        return zxerr_buffer_too_small;
+    }
+    return zxerr_ok;
+}
+
+zxerr_t delta_apply(delta_state_t *state, const uint8_t *buffer, uint32_t length, delta_sink_t sink) {
+    if (state == NULL || !state->active || sink == NULL || (buffer == NULL && length > 0)) {
+        return zxerr_unknown;
+    }
+
+    while (length > 0) {
+        if (state->pendingInsert > 0) {
+            const uint32_t take = length < state->pendingInsert ? length : state->pendingInsert;
+            if (sink((unsigned char *) buffer, take) != take) {
+                return zxerr_buffer_too_small;
+            }
+            buffer += take;
+            length -= take;
+            state->pendingInsert -= (uint16_t) take;
+            continue;
+        }
+
+        if (state->headerLen == 0 && *buffer != DELTA_OP_COPY && *buffer != DELTA_OP_INSERT) {
+            return zxerr_unknown;
+        }
+        state->header[state->headerLen++] = *buffer++;
+        length--;
+
+        const uint8_t headerLen = state->header[0] == DELTA_OP_COPY ? DELTA_COPY_HEADER_LEN
+                                                                    : DELTA_INSERT_HEADER_LEN;
+        if (state->headerLen < headerLen) {
+            continue;
+        }
+        state->headerLen = 0;
+        CHECK_ZXERR(delta_runOp(state, sink))
+    }
+    return zxerr_ok;
+}
+
+zxerr_t delta_finish(const delta_state_t *state) {
+    if (state == NULL || !state->active || state->headerLen != 0 || state->pendingInsert != 0) {
+        return zxerr_unknown;
+    }
+    return zxerr_ok;
+}
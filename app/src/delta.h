@@ -0,0 +1,59 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "zxerror.h"
+
+// A delta rebuilds a transaction from a reference one (the previously signed transaction)
+// as a sequence of operations, which may be split anywhere across chunks:
+//   copy:   0x00 | offset (2) | length (2)    bytes [offset, offset + length) of the reference
+//   insert: 0x01 | length (2) | bytes         literal bytes
+// Lengths and offsets are big endian; zero lengths are rejected.
+#define DELTA_OP_COPY               0x00
+#define DELTA_OP_INSERT             0x01
+
+#define DELTA_COPY_HEADER_LEN       5
+#define DELTA_INSERT_HEADER_LEN     3
+
+/// Receives the rebuilt bytes; returns how many were accepted (same contract as tx_append)
+typedef uint32_t (*delta_sink_t)(unsigned char *buffer, uint32_t length);
+
+typedef struct {
+    const uint8_t *reference;
+    uint16_t referenceLen;
+    uint8_t header[DELTA_COPY_HEADER_LEN];
+    uint8_t headerLen;
+    uint16_t pendingInsert;
+    bool active;
+} delta_state_t;
+
+void delta_init(delta_state_t *state, const uint8_t *reference, uint16_t referenceLen);
+
+/// Decodes a chunk of operations, writing the rebuilt bytes to sink
+zxerr_t delta_apply(delta_state_t *state, const uint8_t *buffer, uint32_t length, delta_sink_t sink);
+
+/// Checks that the operations ended on an operation boundary
+zxerr_t delta_finish(const delta_state_t *state);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,542 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#if !defined(LEDGER_SPECIFIC)
+#include "ed25519.h"
+#include "sha512.h"
+#include <string.h>
+
+// Field elements mod p = 2^255 - 19 in radix 2^51
+typedef struct {
+    uint64_t v[5];
+} fe_t;
+
+// Points in extended twisted Edwards coordinates: x = X/Z, y = Y/Z, x*y = T/Z
+typedef struct {
+    fe_t X;
+    fe_t Y;
+    fe_t Z;
+    fe_t T;
+} ge_t;
+
+#define MASK51 ((UINT64_C(1) << 51) - 1)
+
+static bool constants_ready = false;
+static fe_t fe_d;
+static fe_t fe_d2;
+static fe_t fe_sqrtm1;
+static ge_t ge_base;
+
+// Group order L = 2^252 + 27742317777372353535851937790883648493, little endian
+static const int64_t L[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+static uint64_t load64_le(const uint8_t *in) {
+    uint64_t r = 0;
+    for (int8_t i = 7; i >= 0; i--) {
+        r = (r << 8) | in[i];
+    }
+    return r;
+}
+
+static void store64_le(uint8_t *out, uint64_t v) {
+    for (uint8_t i = 0; i < 8; i++) {
+        out[i] = (uint8_t) (v >> (8 * i));
+    }
+}
+
+static void fe_set(fe_t *h, uint64_t small) {
+    memset(h, 0, sizeof(*h));
+    h->v[0] = small;
+}
+
+static void fe_carry(fe_t *h) {
+    for (uint8_t i = 0; i < 4; i++) {
+        h->v[i + 1] += h->v[i] >> 51;
+        h->v[i] &= MASK51;
+    }
+    h->v[0] += 19 * (h->v[4] >> 51);
+    h->v[4] &= MASK51;
+}
+
+static void fe_frombytes(fe_t *h, const uint8_t s[32]) {
+    const uint64_t w0 = load64_le(s);
+    const uint64_t w1 = load64_le(s + 8);
+    const uint64_t w2 = load64_le(s + 16);
+    const uint64_t w3 = load64_le(s + 24);
+
+    h->v[0] = w0 & MASK51;
+    h->v[1] = ((w0 >> 51) | (w1 << 13)) & MASK51;
+    h->v[2] = ((w1 >> 38) | (w2 << 26)) & MASK51;
+    h->v[3] = ((w2 >> 25) | (w3 << 39)) & MASK51;
+    h->v[4] = (w3 >> 12) & MASK51;
+}
+
+static void fe_tobytes(uint8_t s[32], const fe_t *f) {
+    fe_t h = *f;
+    fe_carry(&h);
+    fe_carry(&h);
+
+    // h < 2^255 + small here; subtract p once if h >= p
+    uint64_t q = (h.v[0] + 19) >> 51;
+    for (uint8_t i = 1; i < 5; i++) {
+        q = (h.v[i] + q) >> 51;
+    }
+    h.v[0] += 19 * q;
+    for (uint8_t i = 0; i < 4; i++) {
+        h.v[i + 1] += h.v[i] >> 51;
+        h.v[i] &= MASK51;
+    }
+    h.v[4] &= MASK51;
+
+    store64_le(s, h.v[0] | (h.v[1] << 51));
+    store64_le(s + 8, (h.v[1] >> 13) | (h.v[2] << 38));
+    store64_le(s + 16, (h.v[2] >> 26) | (h.v[3] << 25));
+    store64_le(s + 24, (h.v[3] >> 39) | (h.v[4] << 12));
+}
+
+static void fe_add(fe_t *h, const fe_t *f, const fe_t *g) {
+    for (uint8_t i = 0; i < 5; i++) {
+        h->v[i] = f->v[i] + g->v[i];
+    }
+    fe_carry(h);
+}
+
+static void fe_sub(fe_t *h, const fe_t *f, const fe_t *g) {
+    // Add 4p so limbs never underflow
+    h->v[0] = f->v[0] + UINT64_C(0x1FFFFFFFFFFFB4) - g->v[0];
+    for (uint8_t i = 1; i < 5; i++) {
+        h->v[i] = f->v[i] + UINT64_C(0x1FFFFFFFFFFFFC) - g->v[i];
+    }
+    fe_carry(h);
+}
+
+static void fe_neg(fe_t *h, const fe_t *f) {
+    fe_t zero;
+    fe_set(&zero, 0);
+    fe_sub(h, &zero, f);
+}
+
+static void fe_mul(fe_t *h, const fe_t *f, const fe_t *g) {
+    typedef unsigned __int128 u128;
+    const uint64_t f0 = f->v[0], f1 = f->v[1], f2 = f->v[2], f3 = f->v[3], f4 = f->v[4];
+    const uint64_t g0 = g->v[0], g1 = g->v[1], g2 = g->v[2], g3 = g->v[3], g4 = g->v[4];
+    const uint64_t g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3, g4_19 = 19 * g4;
+
+    u128 r0 = (u128) f0 * g0 + (u128) f1 * g4_19 + (u128) f2 * g3_19 + (u128) f3 * g2_19 + (u128) f4 * g1_19;
+    u128 r1 = (u128) f0 * g1 + (u128) f1 * g0 + (u128) f2 * g4_19 + (u128) f3 * g3_19 + (u128) f4 * g2_19;
+    u128 r2 = (u128) f0 * g2 + (u128) f1 * g1 + (u128) f2 * g0 + (u128) f3 * g4_19 + (u128) f4 * g3_19;
+    u128 r3 = (u128) f0 * g3 + (u128) f1 * g2 + (u128) f2 * g1 + (u128) f3 * g0 + (u128) f4 * g4_19;
+    u128 r4 = (u128) f0 * g4 + (u128) f1 * g3 + (u128) f2 * g2 + (u128) f3 * g1 + (u128) f4 * g0;
+
+    r1 += (uint64_t) (r0 >> 51);
+    r2 += (uint64_t) (r1 >> 51);
+    r3 += (uint64_t) (r2 >> 51);
+    r4 += (uint64_t) (r3 >> 51);
+    const u128 carry = (r4 >> 51) * 19 + ((uint64_t) r0 & MASK51);
+
+    h->v[0] = (uint64_t) carry & MASK51;
+    h->v[1] = ((uint64_t) r1 & MASK51) + (uint64_t) (carry >> 51);
+    h->v[2] = (uint64_t) r2 & MASK51;
+    h->v[3] = (uint64_t) r3 & MASK51;
+    h->v[4] = (uint64_t) r4 & MASK51;
+}
+
+static void fe_sq(fe_t *h, const fe_t *f) {
+    fe_mul(h, f, f);
+}
+
+static void fe_sqn(fe_t *h, const fe_t *f, uint16_t n) {
+    fe_sq(h, f);
+    for (uint16_t i = 1; i < n; i++) {
+        fe_sq(h, h);
+    }
+}
+
+// Shared prefix of the inversion and square-root exponent chains: returns z^(2^250 - 1) and z^11
+static void fe_pow_2_250_1(fe_t *out, fe_t *z11, const fe_t *z) {
+    fe_t t0, t1, t2, t3;
+
+    fe_sq(&t0, z);                 // 2
+    fe_sqn(&t1, &t0, 2);           // 8
+    fe_mul(&t1, z, &t1);           // 9
+    fe_mul(&t0, &t0, &t1);         // 11
+    *z11 = t0;
+    fe_sq(&t2, &t0);               // 22
+    fe_mul(&t1, &t1, &t2);         // 2^5 - 1
+    fe_sqn(&t2, &t1, 5);
+    fe_mul(&t1, &t2, &t1);         // 2^10 - 1
+    fe_sqn(&t2, &t1, 10);
+    fe_mul(&t2, &t2, &t1);         // 2^20 - 1
+    fe_sqn(&t3, &t2, 20);
+    fe_mul(&t2, &t3, &t2);         // 2^40 - 1
+    fe_sqn(&t2, &t2, 10);
+    fe_mul(&t1, &t2, &t1);         // 2^50 - 1
+    fe_sqn(&t2, &t1, 50);
+    fe_mul(&t2, &t2, &t1);         // 2^100 - 1
+    fe_sqn(&t3, &t2, 100);
+    fe_mul(&t2, &t3, &t2);         // 2^200 - 1
+    fe_sqn(&t2, &t2, 50);
+    fe_mul(out, &t2, &t1);         // 2^250 - 1
+}
+
+static void fe_invert(fe_t *out, const fe_t *z) {
+    fe_t t, z11;
+    fe_pow_2_250_1(&t, &z11, z);
+    fe_sqn(&t, &t, 5);             // 2^255 - 32
+    fe_mul(out, &t, &z11);         // 2^255 - 21 = p - 2
+}
+
+static void fe_pow22523(fe_t *out, const fe_t *z) {
+    fe_t t, z11;
+    fe_pow_2_250_1(&t, &z11, z);
+    fe_sqn(&t, &t, 2);             // 2^252 - 4
+    fe_mul(out, &t, z);            // 2^252 - 3 = (p - 5) / 8
+}
+
+static bool fe_equal(const fe_t *f, const fe_t *g) {
+    uint8_t a[32], b[32];
+    fe_tobytes(a, f);
+    fe_tobytes(b, g);
+    return memcmp(a, b, sizeof(a)) == 0;
+}
+
+static bool fe_isnegative(const fe_t *f) {
+    uint8_t s[32];
+    fe_tobytes(s, f);
+    return (s[0] & 1) != 0;
+}
+
+static bool fe_iszero(const fe_t *f) {
+    uint8_t s[32];
+    static const uint8_t zero[32] = {0};
+    fe_tobytes(s, f);
+    return memcmp(s, zero, sizeof(s)) == 0;
+}
+
+static void fe_cmov(fe_t *f, const fe_t *g, uint64_t flag) {
+    const uint64_t mask = (uint64_t) 0 - flag;
+    for (uint8_t i = 0; i < 5; i++) {
+        f->v[i] ^= mask & (f->v[i] ^ g->v[i]);
+    }
+}
+
+static void ge_identity(ge_t *p) {
+    fe_set(&p->X, 0);
+    fe_set(&p->Y, 1);
+    fe_set(&p->Z, 1);
+    fe_set(&p->T, 0);
+}
+
+static void ge_add(ge_t *r, const ge_t *p, const ge_t *q) {
+    fe_t a, b, c, d, e, f, g, h, t;
+
+    fe_sub(&a, &p->Y, &p->X);
+    fe_sub(&t, &q->Y, &q->X);
+    fe_mul(&a, &a, &t);
+    fe_add(&b, &p->Y, &p->X);
+    fe_add(&t, &q->Y, &q->X);
+    fe_mul(&b, &b, &t);
+    fe_mul(&c, &p->T, &q->T);
+    fe_mul(&c, &c, &fe_d2);
+    fe_mul(&d, &p->Z, &q->Z);
+    fe_add(&d, &d, &d);
+    fe_sub(&e, &b, &a);
+    fe_sub(&f, &d, &c);
+    fe_add(&g, &d, &c);
+    fe_add(&h, &b, &a);
+
+    fe_mul(&r->X, &e, &f);
+    fe_mul(&r->Y, &g, &h);
+    fe_mul(&r->T, &e, &h);
+    fe_mul(&r->Z, &f, &g);
+}
+
+static void ge_double(ge_t *r, const ge_t *p) {
+    fe_t a, b, c, e, f, g, h;
+
+    fe_sq(&a, &p->X);
+    fe_sq(&b, &p->Y);
+    fe_sq(&c, &p->Z);
+    fe_add(&c, &c, &c);
+    fe_add(&h, &a, &b);
+    fe_add(&e, &p->X, &p->Y);
+    fe_sq(&e, &e);
+    fe_sub(&e, &h, &e);
+    fe_sub(&g, &a, &b);
+    fe_add(&f, &c, &g);
+
+    fe_mul(&r->X, &e, &f);
+    fe_mul(&r->Y, &g, &h);
+    fe_mul(&r->T, &e, &h);
+    fe_mul(&r->Z, &f, &g);
+}
+
+static void ge_cmov(ge_t *p, const ge_t *q, uint64_t flag) {
+    fe_cmov(&p->X, &q->X, flag);
+    fe_cmov(&p->Y, &q->Y, flag);
+    fe_cmov(&p->Z, &q->Z, flag);
+    fe_cmov(&p->T, &q->T, flag);
+}
+
+// r = scalar * p, walking all 256 bits with an unconditional add
+static void ge_scalarmult(ge_t *r, const ge_t *p, const uint8_t scalar[32]) {
+    ge_t q, sum;
+    ge_identity(&q);
+    for (int16_t i = 255; i >= 0; i--) {
+        ge_double(&q, &q);
+        ge_add(&sum, &q, p);
+        ge_cmov(&q, &sum, (scalar[i >> 3] >> (i & 7)) & 1);
+    }
+    *r = q;
+}
+
+static void ge_tobytes(uint8_t s[32], const ge_t *p) {
+    fe_t zInv, x, y;
+    fe_invert(&zInv, &p->Z);
+    fe_mul(&x, &p->X, &zInv);
+    fe_mul(&y, &p->Y, &zInv);
+    fe_tobytes(s, &y);
+    s[31] ^= (uint8_t) (fe_isnegative(&x) << 7);
+}
+
+static bool ge_frombytes(ge_t *p, const uint8_t s[32]) {
+    fe_t u, v, v3, vxx, check;
+
+    fe_frombytes(&p->Y, s);
+    fe_set(&p->Z, 1);
+
+    // x^2 = (y^2 - 1) / (d y^2 + 1)
+    fe_sq(&u, &p->Y);
+    fe_mul(&v, &u, &fe_d);
+    fe_sub(&u, &u, &p->Z);
+    fe_add(&v, &v, &p->Z);
+
+    // x = u v^3 (u v^7)^((p - 5) / 8)
+    fe_sq(&v3, &v);
+    fe_mul(&v3, &v3, &v);
+    fe_sq(&p->X, &v3);
+    fe_mul(&p->X, &p->X, &v);
+    fe_mul(&p->X, &p->X, &u);
+    fe_pow22523(&p->X, &p->X);
+    fe_mul(&p->X, &p->X, &v3);
+    fe_mul(&p->X, &p->X, &u);
+
+    fe_sq(&vxx, &p->X);
+    fe_mul(&vxx, &vxx, &v);
+    if (!fe_equal(&vxx, &u)) {
+        fe_neg(&check, &u);
+        if (!fe_equal(&vxx, &check)) {
+            return false;
+        }
+        fe_mul(&p->X, &p->X, &fe_sqrtm1);
+    }
+
+    const bool sign = (s[31] >> 7) != 0;
+    if (fe_iszero(&p->X) && sign) {
+        return false;
+    }
+    if (fe_isnegative(&p->X) != sign) {
+        fe_neg(&p->X, &p->X);
+    }
+
+    fe_mul(&p->T, &p->X, &p->Y);
+    return true;
+}
+
+static void init_constants(void) {
+    if (constants_ready) {
+        return;
+    }
+
+    fe_t num, den;
+    fe_set(&num, 121665);
+    fe_neg(&num, &num);
+    fe_set(&den, 121666);
+    fe_invert(&den, &den);
+    fe_mul(&fe_d, &num, &den);
+    fe_add(&fe_d2, &fe_d, &fe_d);
+
+    // 2 is a non-residue, so 2^((p - 1) / 4) squares to -1
+    fe_t two;
+    fe_set(&two, 2);
+    fe_pow22523(&fe_sqrtm1, &two);      // 2^((p - 5) / 8)
+    fe_sq(&fe_sqrtm1, &fe_sqrtm1);      // 2^((p - 5) / 4)
+    fe_mul(&fe_sqrtm1, &fe_sqrtm1, &two);
+
+    static const uint8_t base_encoded[32] = {
+        0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+        0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    };
+    ge_frombytes(&ge_base, base_encoded);
+
+    constants_ready = true;
+}
+
+// Reduce a 64-limb little-endian number (limbs may exceed a byte) modulo L
+static void mod_l(uint8_t out[32], int64_t x[64]) {
+    int64_t carry;
+    int16_t i, j;
+
+    for (i = 63; i >= 32; --i) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; ++j) {
+            x[j] += carry - 16 * x[i] * L[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    carry = 0;
+    for (j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (j = 0; j < 32; j++) {
+        x[j] -= carry * L[j];
+    }
+    for (i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        out[i] = (uint8_t) (x[i] & 255);
+    }
+}
+
+void ed25519_scalar_reduce(uint8_t out[ED25519_SCALAR_SIZE], const uint8_t in[64]) {
+    int64_t x[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        x[i] = in[i];
+    }
+    mod_l(out, x);
+}
+
+void ed25519_scalar_muladd(uint8_t out[ED25519_SCALAR_SIZE],
+                           const uint8_t a[ED25519_SCALAR_SIZE],
+                           const uint8_t b[ED25519_SCALAR_SIZE],
+                           const uint8_t c[ED25519_SCALAR_SIZE]) {
+    int64_t x[64] = {0};
+    for (uint8_t i = 0; i < 32; i++) {
+        x[i] = c[i];
+    }
+    for (uint8_t i = 0; i < 32; i++) {
+        for (uint8_t j = 0; j < 32; j++) {
+            x[i + j] += (int64_t) a[i] * b[j];
+        }
+    }
+    mod_l(out, x);
+}
+
+void ed25519_scalarmult_base(uint8_t out[ED25519_PUBLIC_KEY_SIZE], const uint8_t scalar[ED25519_SCALAR_SIZE]) {
+    init_constants();
+    ge_t p;
+    ge_scalarmult(&p, &ge_base, scalar);
+    ge_tobytes(out, &p);
+}
+
+void ed25519_expand_seed(uint8_t az[64], const uint8_t seed[ED25519_SEED_SIZE]) {
+    SHA512(seed, ED25519_SEED_SIZE, az);
+    az[0] &= 248;
+    az[31] &= 127;
+    az[31] |= 64;
+}
+
+void ed25519_publickey(uint8_t pk[ED25519_PUBLIC_KEY_SIZE], const uint8_t seed[ED25519_SEED_SIZE]) {
+    uint8_t az[64];
+    ed25519_expand_seed(az, seed);
+    ed25519_scalarmult_base(pk, az);
+    secure_wipe(az, sizeof(az));
+}
+
+void ed25519_sign(uint8_t sig[ED25519_SIG_SIZE],
+                  const uint8_t *msg, size_t msgLen,
+                  const uint8_t seed[ED25519_SEED_SIZE],
+                  const uint8_t pk[ED25519_PUBLIC_KEY_SIZE]) {
+    uint8_t az[64];
+    uint8_t digest[64];
+    uint8_t nonce[32];
+    uint8_t k[32];
+    mbedtls_sha512_context ctx;
+
+    ed25519_expand_seed(az, seed);
+
+    // r = H(prefix || M) mod L, R = rB
+    SHA512_init(&ctx);
+    SHA512_update(&ctx, az + 32, 32);
+    SHA512_update(&ctx, msg, msgLen);
+    SHA512_final(&ctx, digest);
+    ed25519_scalar_reduce(nonce, digest);
+    ed25519_scalarmult_base(sig, nonce);
+
+    // k = H(R || A || M) mod L, S = r + k a
+    SHA512_init(&ctx);
+    SHA512_update(&ctx, sig, 32);
+    SHA512_update(&ctx, pk, ED25519_PUBLIC_KEY_SIZE);
+    SHA512_update(&ctx, msg, msgLen);
+    SHA512_final(&ctx, digest);
+    ed25519_scalar_reduce(k, digest);
+    ed25519_scalar_muladd(sig + 32, k, az, nonce);
+
+    secure_wipe(az, sizeof(az));
+    secure_wipe(nonce, sizeof(nonce));
+    secure_wipe(digest, sizeof(digest));
+}
+
+bool ed25519_verify(const uint8_t sig[ED25519_SIG_SIZE],
+                    const uint8_t *msg, size_t msgLen,
+                    const uint8_t pk[ED25519_PUBLIC_KEY_SIZE]) {
+    init_constants();
+
+    // S must be canonical (S < L)
+    for (int8_t i = 31; i >= 0; i--) {
+        if (sig[32 + i] < L[i]) {
+            break;
+        }
+        if (sig[32 + i] > L[i] || i == 0) {
+            return false;
+        }
+    }
+
+    ge_t a;
+    if (!ge_frombytes(&a, pk)) {
+        return false;
+    }
+    fe_neg(&a.X, &a.X);
+    fe_neg(&a.T, &a.T);
+
+    uint8_t digest[64];
+    uint8_t k[32];
+    mbedtls_sha512_context ctx;
+    SHA512_init(&ctx);
+    SHA512_update(&ctx, sig, 32);
+    SHA512_update(&ctx, pk, ED25519_PUBLIC_KEY_SIZE);
+    SHA512_update(&ctx, msg, msgLen);
+    SHA512_final(&ctx, digest);
+    ed25519_scalar_reduce(k, digest);
+
+    // Check R == SB - kA
+    ge_t sb, ka, r;
+    ge_scalarmult(&sb, &ge_base, sig + 32);
+    ge_scalarmult(&ka, &a, k);
+    ge_add(&r, &sb, &ka);
+
+    uint8_t encoded[32];
+    ge_tobytes(encoded, &r);
+    return memcmp(encoded, sig, 32) == 0;
+}
+#endif
@@ -0,0 +1,62 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Portable Ed25519 (RFC 8032) used by host builds in place of the cx_* primitives.
+// Not constant-time hardened beyond branch-free scalar multiplication: host only.
+
+#define ED25519_SEED_SIZE       32
+#define ED25519_PUBLIC_KEY_SIZE 32
+#define ED25519_SCALAR_SIZE     32
+#define ED25519_SIG_SIZE        64
+
+/// A = scalar * B, where scalar is a little-endian 256-bit integer used as is
+void ed25519_scalarmult_base(uint8_t out[ED25519_PUBLIC_KEY_SIZE], const uint8_t scalar[ED25519_SCALAR_SIZE]);
+
+/// out = in mod L, in is a little-endian 512-bit integer (e.g. a SHA-512 digest)
+void ed25519_scalar_reduce(uint8_t out[ED25519_SCALAR_SIZE], const uint8_t in[64]);
+
+/// out = (a * b + c) mod L
+void ed25519_scalar_muladd(uint8_t out[ED25519_SCALAR_SIZE],
+                           const uint8_t a[ED25519_SCALAR_SIZE],
+                           const uint8_t b[ED25519_SCALAR_SIZE],
+                           const uint8_t c[ED25519_SCALAR_SIZE]);
+
+/// SHA-512(seed) with the first half clamped into the secret scalar; the second half is the nonce prefix
+void ed25519_expand_seed(uint8_t az[64], const uint8_t seed[ED25519_SEED_SIZE]);
+
+void ed25519_publickey(uint8_t pk[ED25519_PUBLIC_KEY_SIZE], const uint8_t seed[ED25519_SEED_SIZE]);
+
+void ed25519_sign(uint8_t sig[ED25519_SIG_SIZE],
+                  const uint8_t *msg, size_t msgLen,
+                  const uint8_t seed[ED25519_SEED_SIZE],
+                  const uint8_t pk[ED25519_PUBLIC_KEY_SIZE]);
+
+bool ed25519_verify(const uint8_t sig[ED25519_SIG_SIZE],
+                    const uint8_t *msg, size_t msgLen,
+                    const uint8_t pk[ED25519_PUBLIC_KEY_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,6 +19,7 @@
 #include "parser_impl.h"
 #include "parser_json.h"
 #include "jsmn.h"
+#include "byte_class.h"
 #include <stdbool.h>
 #include "zxmacros_ledger.h"
 
@@ -130,20 +131,30 @@ parser_error_t parser_json_object_get_nth_value(uint16_t object_token_index, uin
     return parser_ok;
 }
 
-parser_error_t parser_getJsonItemFromTokenIndex(const char *jsonBuffer, uint16_t token_index, char *outVal, uint16_t outValLen) {
+parser_error_t parser_getJsonTokenSpan(const char *jsonBuffer, uint16_t token_index, const char **value, uint16_t *valueLen) {
     parsed_json_t *json = &parsed_json;
     jsmntok_t token = json->tokens[token_index];
 
-    if (token.type == JSMN_STRING || token.type == JSMN_ARRAY) {
-        if (token.end - token.start > outValLen) {
-            return parser_unexpected_buffer_end;
-        }
-        memcpy(outVal, jsonBuffer + token.start, token.end - token.start);
-        outVal[token.end - token.start] = '\0';
-    } else {
+    if (token.type != JSMN_STRING && token.type != JSMN_ARRAY) {
         return parser_bad_json;
     }
 
+    *value = jsonBuffer + token.start;
+    *valueLen = (uint16_t) (token.end - token.start);
+    return parser_ok;
+}
+
+parser_error_t parser_getJsonItemFromTokenIndex(const char *jsonBuffer, uint16_t token_index, char *outVal, uint16_t outValLen) {
+    const char *value = NULL;
+    uint16_t valueLen = 0;
+    CHECK_ERROR(parser_getJsonTokenSpan(jsonBuffer, token_index, &value, &valueLen))
+
+    if (valueLen >= outValLen) {
+        return parser_unexpected_buffer_end;
+    }
+    memcpy(outVal, value, valueLen);
+    outVal[valueLen] = '\0';
+
     return parser_ok;
 }
 
@@ -238,10 +249,8 @@ parser_error_t parser_json_check_canonical(const char *data, uint16_t data_len)
     }
 
     // Check there are only ASCII characters
-    for (uint16_t i = 0; i < data_len; i++) {
-        if (data[i] < 32 || data[i] > 126) {
-            return parser_bad_json;
-        }
+    if (!bytes_printable((const uint8_t *) data, data_len)) {
+        return parser_bad_json;
     }
 
     return parser_ok;
@@ -36,6 +36,9 @@ parser_error_t parser_json_object_get_nth_key(uint16_t object_token_index, uint1
 parser_error_t parser_json_object_get_nth_value(uint16_t object_token_index, uint16_t object_element_index,
                                     uint16_t *key_index);
 
+// Points into jsonBuffer: a string value without its quotes, or an array with its brackets
+parser_error_t parser_getJsonTokenSpan(const char *jsonBuffer, uint16_t token_index, const char **value, uint16_t *valueLen);
+
 parser_error_t parser_getJsonItemFromTokenIndex(const char *jsonBuffer, uint16_t token_index, char *outVal, uint16_t outValLen);
 
 parser_error_t parser_json_check_canonical(const char *data, uint16_t data_len);
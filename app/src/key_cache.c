@@ -0,0 +1,118 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "key_cache.h"
+#include "zxmacros.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    uint8_t seed[SCALAR_LEN_ED25519];
+    uint8_t publicKey[PK_LEN_25519];
+    uint32_t lastUse;
+    bool valid;
+} key_cache_entry_t;
+
+static key_cache_entry_t entries[KEY_CACHE_ENTRIES];
+static key_cache_stats_t stats;
+static uint32_t useCounter = 0;
+
+static void wipe_entry(key_cache_entry_t *entry) {
+    MEMZERO(entry, sizeof(*entry));
+}
+
+bool key_cache_lookup(const uint32_t path[HDPATH_LEN_DEFAULT],
+                      uint8_t seed[SCALAR_LEN_ED25519],
+                      uint8_t publicKey[PK_LEN_25519]) {
+    if (path == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < KEY_CACHE_ENTRIES; i++) {
+        key_cache_entry_t *entry = &entries[i];
+        if (!entry->valid || memcmp(entry->path, path, sizeof(entry->path)) != 0) {
+            continue;
+        }
+        if (seed != NULL) {
+            MEMCPY(seed, entry->seed, sizeof(entry->seed));
+        }
+        if (publicKey != NULL) {
+            MEMCPY(publicKey, entry->publicKey, sizeof(entry->publicKey));
+        }
+        entry->lastUse = ++useCounter;
+        stats.hits++;
+        return true;
+    }
+
+    stats.misses++;
+    return false;
+}
+
+void key_cache_store(const uint32_t path[HDPATH_LEN_DEFAULT],
+                     const uint8_t seed[SCALAR_LEN_ED25519],
+                     const uint8_t publicKey[PK_LEN_25519]) {
+    if (path == NULL || seed == NULL || publicKey == NULL) {
+        return;
+    }
+
+    key_cache_entry_t *slot = &entries[0];
+    for (uint8_t i = 0; i < KEY_CACHE_ENTRIES; i++) {
+        key_cache_entry_t *entry = &entries[i];
+        if (entry->valid && memcmp(entry->path, path, sizeof(entry->path)) == 0) {
+            slot = entry;
+            break;
+        }
+        if (!entry->valid) {
+            if (slot->valid) {
+                slot = entry;
+            }
+        } else if (slot->valid && entry->lastUse < slot->lastUse) {
+            slot = entry;
+        }
+    }
+
+    if (slot->valid && memcmp(slot->path, path, sizeof(slot->path)) != 0) {
+        stats.evictions++;
+    }
+    wipe_entry(slot);
+
+    MEMCPY(slot->path, path, sizeof(slot->path));
+    MEMCPY(slot->seed, seed, sizeof(slot->seed));
+    MEMCPY(slot->publicKey, publicKey, sizeof(slot->publicKey));
+    slot->lastUse = ++useCounter;
+    slot->valid = true;
+}
+
+void key_cache_reset(void) {
+    bool hadEntries = false;
+    for (uint8_t i = 0; i < KEY_CACHE_ENTRIES; i++) {
+        hadEntries |= entries[i].valid;
+        wipe_entry(&entries[i]);
+    }
+    useCounter = 0;
+    if (hadEntries) {
+        stats.resets++;
+    }
+}
+
+void key_cache_get_stats(key_cache_stats_t *out) {
+    if (out != NULL) {
+        MEMCPY(out, &stats, sizeof(stats));
+    }
+}
+
+void key_cache_clear_stats(void) {
+    MEMZERO(&stats, sizeof(stats));
+}
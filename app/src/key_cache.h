@@ -0,0 +1,61 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "coin.h"
+
+// Derived Ed25519 key material for the last few hdPaths used in this session.
+// Entries hold the 32-byte EdDSA seed (kL) and its public key; they are wiped on
+// eviction and whenever key_cache_reset() is called: on the first APDU handled after the
+// device locks (PIN lock or auto-lock timeout), on I/O reset and when the app exits.
+#if defined(TARGET_NANOS)
+#define KEY_CACHE_ENTRIES 1
+#else
+#define KEY_CACHE_ENTRIES 4
+#endif
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t resets;
+} key_cache_stats_t;
+
+/// Looks up hdPath; on a hit copies the cached seed and/or public key (either may be NULL)
+bool key_cache_lookup(const uint32_t path[HDPATH_LEN_DEFAULT],
+                      uint8_t seed[SCALAR_LEN_ED25519],
+                      uint8_t publicKey[PK_LEN_25519]);
+
+/// Stores freshly derived key material, evicting the least recently used entry if full
+void key_cache_store(const uint32_t path[HDPATH_LEN_DEFAULT],
+                     const uint8_t seed[SCALAR_LEN_ED25519],
+                     const uint8_t publicKey[PK_LEN_25519]);
+
+/// Wipes every entry
+void key_cache_reset(void);
+
+void key_cache_get_stats(key_cache_stats_t *stats);
+void key_cache_clear_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -32,12 +32,13 @@
 #include "algo_asa.h"
 
 #include "crypto.h"
+#include "profile.h"
 
-parser_error_t parser_parse(parser_context_t *ctx,
-                            const uint8_t *data,
-                            size_t dataLen,
-                            void *tx_obj,
-                            txn_content_e content) {
+static parser_error_t parser_parseContent(parser_context_t *ctx,
+                                          const uint8_t *data,
+                                          size_t dataLen,
+                                          void *tx_obj,
+                                          txn_content_e content) {
     CHECK_ERROR(parser_init(ctx, data, dataLen, content))
     if (content == MsgPack) {
         ctx->parser_tx_obj = (parser_tx_t *) tx_obj;
@@ -45,11 +46,26 @@ parser_error_t parser_parse(parser_context_t *ctx,
     } else if (content == ArbitraryData) {
         ctx->parser_arbitrary_data_obj = (parser_arbitrary_data_t *) tx_obj;
         return _read_arbitrary_data(ctx, (parser_arbitrary_data_t *) tx_obj);
+    } else if (content == ArbitraryDataBatch) {
+        ctx->parser_arbitrary_batch_obj = (parser_arbitrary_batch_t *) tx_obj;
+        return _read_arbitrary_batch(ctx, (parser_arbitrary_batch_t *) tx_obj);
     }
     return parser_unexpected_error;
 }
 
-parser_error_t parser_validate(parser_context_t *ctx) {
+parser_error_t parser_parse(parser_context_t *ctx,
+                            const uint8_t *data,
+                            size_t dataLen,
+                            void *tx_obj,
+                            txn_content_e content) {
+    PROFILE_STAGE_BEGIN();
+    b64hash_reset();
+    const parser_error_t err = parser_parseContent(ctx, data, dataLen, tx_obj, content);
+    PROFILE_STAGE_END(PROFILE_STAGE_PARSE);
+    return err;
+}
+
+static parser_error_t parser_validateItems(parser_context_t *ctx) {
     // Iterate through all items to check that all can be shown and are valid
     uint8_t numItems = 0;
     CHECK_ERROR(parser_getNumItems(&numItems))
@@ -64,6 +80,13 @@ parser_error_t parser_validate(parser_context_t *ctx) {
     return parser_ok;
 }
 
+parser_error_t parser_validate(parser_context_t *ctx) {
+    PROFILE_STAGE_BEGIN();
+    const parser_error_t err = parser_validateItems(ctx);
+    PROFILE_STAGE_END(PROFILE_STAGE_VALIDATE);
+    return err;
+}
+
 parser_error_t parser_getNumItems(uint8_t *num_items) {
     *num_items = _getNumItems();
 
@@ -116,10 +139,10 @@ static parser_error_t parser_printJsonItem(parser_context_t *ctx, uint8_t displa
     *pageCount = 1;
     CHECK_ERROR(parser_jsonGetNthKey(ctx, displayIdx, outKey, outKeyLen));
 
-    char json_val[200];
-    CHECK_ERROR(parser_jsonGetNthValue(ctx, displayIdx, json_val, sizeof(json_val)));
-    pageString(outVal, outValLen, json_val, pageIdx, pageCount);
-    return parser_ok;
+    const char *value = NULL;
+    uint16_t valueLen = 0;
+    CHECK_ERROR(parser_jsonGetNthValue(ctx, displayIdx, &value, &valueLen));
+    return pageJsonString(outVal, outValLen, value, valueLen, pageIdx, pageCount);
 }
 
 static parser_error_t parser_printTxType(const parser_context_t *ctx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen, uint8_t *pageCount)
@@ -225,20 +248,22 @@ static parser_error_t parser_printCommonParams(const parser_tx_t *parser_tx_obj,
 
         case IDX_COMMON_LEASE:
             snprintf(outKey, outKeyLen, "Lease");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) parser_tx_obj->lease, sizeof(parser_tx_obj->lease));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, (const uint8_t*) parser_tx_obj->lease, sizeof(parser_tx_obj->lease), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_COMMON_GEN_HASH:
+            if (parser_tx_obj->network != NULL) {
+                snprintf(outKey, outKeyLen, "Network");
+                pageString(outVal, outValLen, parser_tx_obj->network->name, pageIdx, pageCount);
+                return parser_ok;
+            }
             snprintf(outKey, outKeyLen, "Genesis hash");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) parser_tx_obj->genesisHash, sizeof(parser_tx_obj->genesisHash));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, (const uint8_t*) parser_tx_obj->genesisHash, sizeof(parser_tx_obj->genesisHash), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_COMMON_GROUP_ID:
             snprintf(outKey, outKeyLen, "Group ID");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) parser_tx_obj->groupID, sizeof(parser_tx_obj->groupID));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, (const uint8_t*) parser_tx_obj->groupID, sizeof(parser_tx_obj->groupID), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_COMMON_NOTE:
@@ -314,27 +339,21 @@ static parser_error_t parser_printTxKeyreg(const txn_keyreg *keyreg,
                                                    uint8_t pageIdx, uint8_t *pageCount)
 {
     *pageCount = 1;
-    char buff[45];
     switch (displayIdx) {
         case IDX_KEYREG_VOTE_PK:
             snprintf(outKey, outKeyLen, "Vote PK");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) keyreg->votepk, sizeof(keyreg->votepk));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, (const uint8_t*) keyreg->votepk, sizeof(keyreg->votepk), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_KEYREG_VRF_PK:
             snprintf(outKey, outKeyLen, "VRF PK");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) keyreg->vrfpk, sizeof(keyreg->vrfpk));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, (const uint8_t*) keyreg->vrfpk, sizeof(keyreg->vrfpk), pageIdx, pageCount);
             return parser_ok;
 
-        case IDX_KEYREG_SPRF_PK: {
+        case IDX_KEYREG_SPRF_PK:
             snprintf(outKey, outKeyLen, "SPRF PK");
-            char tmpBuff[90];
-            base64_encode(tmpBuff, sizeof(tmpBuff), (const uint8_t*) keyreg->sprfkey, sizeof(keyreg->sprfkey));
-            pageString(outVal, outValLen, tmpBuff, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, (const uint8_t*) keyreg->sprfkey, sizeof(keyreg->sprfkey), pageIdx, pageCount);
             return parser_ok;
-        }
 
         case IDX_KEYREG_VOTE_FIRST:
             snprintf(outKey, outKeyLen, "Vote first");
@@ -548,8 +567,7 @@ static parser_error_t parser_printTxAssetConfig(const txn_asset_config *asset_co
 
         case IDX_CONFIG_METADATA_HASH:
             snprintf(outKey, outKeyLen, "Metadata hash");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) asset_config->params.metadata_hash, sizeof(asset_config->params.metadata_hash));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, (const uint8_t*) asset_config->params.metadata_hash, sizeof(asset_config->params.metadata_hash), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_CONFIG_MANAGER:
@@ -841,9 +859,8 @@ static parser_error_t parser_getItemArbitrary(parser_context_t *ctx,
             // Request ID
             *pageCount = 1;
             snprintf(outKey, outKeyLen, "Request ID");
-            char base64ReqId[BASE64_REQUEST_ID_MAX_LEN] = {0};
-            base64_encode(base64ReqId, sizeof(base64ReqId), ctx->parser_arbitrary_data_obj->requestIdBuffer, ctx->parser_arbitrary_data_obj->requestIdLen);
-            pageString(outVal, outValLen, base64ReqId, pageIdx, pageCount);
+            pageBase64(outVal, outValLen, ctx->parser_arbitrary_data_obj->requestIdBuffer,
+                       ctx->parser_arbitrary_data_obj->requestIdLen, pageIdx, pageCount);
             return parser_ok;
         }
     } else {
@@ -863,6 +880,49 @@ static parser_error_t parser_getItemArbitrary(parser_context_t *ctx,
     return parser_display_idx_out_of_range;
 }
 
+static parser_error_t parser_getItemArbitraryBatch(const parser_context_t *ctx,
+                                                  uint8_t displayIdx,
+                                                  char *outKey, uint16_t outKeyLen,
+                                                  char *outVal, uint16_t outValLen,
+                                                  uint8_t pageIdx, uint8_t *pageCount) {
+    if (ctx == NULL || ctx->parser_arbitrary_batch_obj == NULL) {
+        return parser_unexpected_value;
+    }
+    const parser_arbitrary_batch_t *batch = ctx->parser_arbitrary_batch_obj;
+
+    cleanOutput(outKey, outKeyLen, outVal, outValLen);
+    *pageCount = 1;
+
+    switch (displayIdx) {
+        case 0: {
+            snprintf(outKey, outKeyLen, "Signer");
+            char addr[80] = {0};
+            if (encodePubKey((uint8_t*) addr, sizeof(addr), batch->signerBuffer) == 0) {
+                return parser_unexpected_error;
+            }
+            pageString(outVal, outValLen, addr, pageIdx, pageCount);
+            return parser_ok;
+        }
+        case 1:
+            snprintf(outKey, outKeyLen, "Domain");
+            pageStringExt(outVal, outValLen, (const char*) batch->domainBuffer, batch->domainLen, pageIdx, pageCount);
+            return parser_ok;
+        case 2:
+            snprintf(outKey, outKeyLen, "Challenges");
+            snprintf(outVal, outValLen, "%d", batch->itemCount);
+            return parser_ok;
+        case 3:
+            if (addr_printHdPath(outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount) != zxerr_ok) {
+                return parser_unexpected_error;
+            }
+            return parser_ok;
+        default:
+            break;
+    }
+
+    return parser_display_idx_out_of_range;
+}
+
 parser_error_t parser_getItem(parser_context_t *ctx,
                               uint8_t displayIdx,
                               char *outKey, uint16_t outKeyLen,
@@ -872,13 +932,18 @@ parser_error_t parser_getItem(parser_context_t *ctx,
         return parser_unexpected_value;
     }
 
+    PROFILE_STAGE_BEGIN();
+    parser_error_t err = parser_unexpected_error;
     if (ctx->content == MsgPack) {
-        return parser_getItemMsgPack(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        err = parser_getItemMsgPack(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
     } else if (ctx->content == ArbitraryData) {
-        return parser_getItemArbitrary(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        err = parser_getItemArbitrary(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+    } else if (ctx->content == ArbitraryDataBatch) {
+        err = parser_getItemArbitraryBatch(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
     }
+    PROFILE_STAGE_END(PROFILE_STAGE_GET_ITEM);
 
-    return parser_unexpected_error;
+    return err;
 }
 
 parser_error_t parser_getTxnText(parser_context_t *ctx,
@@ -22,6 +22,8 @@
 
 #include "sha512.h"
 #include "base32.h"
+#include "profile.h"
+#include "byte_class.h"
 #define CX_SHA512_SIZE 64
 
  #if defined(LEDGER_SPECIFIC)
@@ -33,6 +35,7 @@
 
 uint32_t encodePubKey(uint8_t *buffer, uint16_t bufferLen, const uint8_t *publicKey)
 {
+    PROFILE_COUNT(PROFILE_ENCODE_PUBKEY);
     if(bufferLen < (2 * PK_LEN_25519 + 1)) {
         return 0;
     }
@@ -46,33 +49,215 @@ uint32_t encodePubKey(uint8_t *buffer, uint16_t bufferLen, const uint8_t *public
     return base32_encode(checksummed, sizeof(checksummed), (char*)buffer, bufferLen);
 }
 
+// Paging through a program or app arg would otherwise hash it again for every page.
+// Cleared on every parse, since the same pointer and length can then hold other bytes.
+static struct {
+    const unsigned char *data;
+    size_t dataLen;
+    char b64hash[BASE64_HASH_LEN + 1];
+} last_b64hash;
+
+void b64hash_reset(void)
+{
+    memset(&last_b64hash, 0, sizeof(last_b64hash));
+}
+
 parser_error_t b64hash_data(unsigned char *data, size_t data_len, char *b64hash, size_t b64hashLen)
 {
-    unsigned char hash[32];
-    if (crypto_sha256(data, data_len, hash, sizeof(hash)) != zxerr_ok) {
-        return parser_unexpected_value;
+    if (b64hashLen < sizeof(last_b64hash.b64hash)) {
+        return parser_unexpected_buffer_end;
+    }
+
+    if (last_b64hash.b64hash[0] == 0 || last_b64hash.data != data || last_b64hash.dataLen != data_len) {
+        unsigned char hash[32];
+        if (crypto_sha256(data, data_len, hash, sizeof(hash)) != zxerr_ok) {
+            b64hash_reset();
+            return parser_unexpected_value;
+        }
+        base64_encode(last_b64hash.b64hash, sizeof(last_b64hash.b64hash), (const uint8_t *)hash, sizeof(hash));
+        last_b64hash.data = data;
+        last_b64hash.dataLen = data_len;
     }
-    base64_encode(b64hash, b64hashLen, (const uint8_t *)hash, sizeof(hash));
+
+    memcpy(b64hash, last_b64hash.b64hash, sizeof(last_b64hash.b64hash));
     return parser_ok;
 }
 
-parser_error_t _toStringBalance(uint64_t* amount, uint8_t decimalPlaces, const char *postfix, const char *prefix,
-                                char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount)
+static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void pageBase64(char *outValue, uint16_t outValueLen, const uint8_t *data, uint16_t dataLen,
+                uint8_t pageIdx, uint8_t *pageCount)
 {
-    char bufferUI[200] = {0};
-    if (uint64_to_str(bufferUI, sizeof(bufferUI), *amount) != NULL) {
-        return parser_unexpected_value;
+    memset(outValue, 0, outValueLen);
+    *pageCount = 0;
+    if (outValueLen <= 1 || dataLen == 0) {
+        return;
     }
 
-    if (intstr_to_fpstr_inplace(bufferUI, sizeof(bufferUI), decimalPlaces) == 0) {
-        return parser_unexpected_value;
+    const uint16_t charsPerPage = outValueLen - 1;
+    const uint32_t encodedLen = 4 * (((uint32_t) dataLen + 2) / 3);
+    *pageCount = (uint8_t) ((encodedLen + charsPerPage - 1) / charsPerPage);
+    if (pageIdx >= *pageCount) {
+        return;
+    }
+
+    // Only the 3-byte groups behind the requested characters are encoded
+    const uint32_t first = (uint32_t) pageIdx * charsPerPage;
+    const uint32_t last = first + charsPerPage < encodedLen ? first + charsPerPage : encodedLen;
+    for (uint32_t i = first; i < last; i++) {
+        const uint32_t group = (i / 4) * 3;
+        const uint32_t available = dataLen - group < 3 ? dataLen - group : 3;
+        const uint32_t bits = ((uint32_t) data[group] << 16) |
+                              (available > 1 ? (uint32_t) data[group + 1] << 8 : 0) |
+                              (available > 2 ? (uint32_t) data[group + 2] : 0);
+        const uint32_t pos = i % 4;
+        *outValue++ = pos > available ? '=' : base64_chars[(bits >> (18 - 6 * pos)) & 0x3F];
+    }
+}
+
+parser_error_t pageJsonString(char *outValue, uint16_t outValueLen, const char *value, uint16_t valueLen,
+                              uint8_t pageIdx, uint8_t *pageCount)
+{
+    memset(outValue, 0, outValueLen);
+    *pageCount = 0;
+    if (outValueLen <= 1) {
+        return parser_ok;
     }
 
-    if (z_str3join(bufferUI, sizeof(bufferUI), prefix, postfix) != zxerr_ok) {
+    // Backslashes are not displayed
+    uint16_t shownLen = 0;
+    for (uint16_t i = 0; i < valueLen; i++) {
+        shownLen += value[i] != '\\';
+    }
+    if (shownLen == 0) {
+        return parser_ok;
+    }
+
+    // Values are only bounded by the data length, the page count by its uint8_t
+    const uint16_t charsPerPage = outValueLen - 1;
+    const uint32_t pages = ((uint32_t) shownLen + charsPerPage - 1) / charsPerPage;
+    if (pages > UINT8_MAX) {
         return parser_unexpected_buffer_end;
     }
+    *pageCount = (uint8_t) pages;
+    if (pageIdx >= *pageCount) {
+        return parser_ok;
+    }
+
+    uint32_t skip = (uint32_t) pageIdx * charsPerPage;
+    uint16_t written = 0;
+    for (uint16_t i = 0; i < valueLen && written < charsPerPage; i++) {
+        if (value[i] == '\\') {
+            continue;
+        }
+        if (skip > 0) {
+            skip--;
+            continue;
+        }
+        outValue[written++] = value[i];
+    }
+    return parser_ok;
+}
+
+// "00" "01" ... "99": two digits per division keeps the conversion at ten divisions at most
+static const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static char *appendString(char *out, const char *end, const char *s)
+{
+    if (s == NULL) {
+        return out;
+    }
+    while (*s != 0) {
+        if (out == end) {
+            return NULL;
+        }
+        *out++ = *s++;
+    }
+    return out;
+}
+
+size_t _formatAmount(char *out, size_t outLen, uint64_t amount, uint8_t decimalPlaces,
+                     const char *prefix, const char *postfix)
+{
+    if (out == NULL || outLen == 0) {
+        return 0;
+    }
+
+    // Digits are produced from the least significant end into the tail of `digits`
+    char digits[MAX_AMOUNT_DIGITS];
+    char *first = digits + sizeof(digits);
+    while (amount >= 100) {
+        const uint32_t pair = (uint32_t) (amount % 100) * 2;
+        amount /= 100;
+        *--first = digit_pairs[pair + 1];
+        *--first = digit_pairs[pair];
+    }
+    if (amount >= 10) {
+        *--first = digit_pairs[amount * 2 + 1];
+        *--first = digit_pairs[amount * 2];
+    } else {
+        *--first = (char) ('0' + amount);
+    }
+    const size_t numDigits = (size_t) (digits + sizeof(digits) - first);
+
+    // Leave room for the terminator
+    const char *end = out + outLen - 1;
+    char *p = appendString(out, end, prefix);
+    if (p == NULL) {
+        return 0;
+    }
+
+    // Integer part, "0" when every digit falls after the point
+    const size_t intDigits = numDigits > decimalPlaces ? numDigits - decimalPlaces : 0;
+    if (intDigits == 0) {
+        if (p == end) {
+            return 0;
+        }
+        *p++ = '0';
+    } else {
+        if ((size_t) (end - p) < intDigits) {
+            return 0;
+        }
+        memcpy(p, first, intDigits);
+        p += intDigits;
+    }
+
+    if (decimalPlaces > 0) {
+        if ((size_t) (end - p) < (size_t) decimalPlaces + 1) {
+            return 0;
+        }
+        *p++ = '.';
+        char *fraction = p;
+        for (size_t i = numDigits; i < decimalPlaces; i++) {
+            *p++ = '0';
+        }
+        memcpy(p, first + intDigits, numDigits - intDigits);
+        p += numDigits - intDigits;
+
+        // Trailing zeros go, but one decimal always stays
+        while (p > fraction + 1 && *(p - 1) == '0') {
+            p--;
+        }
+    }
+
+    p = appendString(p, end, postfix);
+    if (p == NULL) {
+        return 0;
+    }
+    *p = 0;
+    return (size_t) (p - out);
+}
 
-    number_inplace_trimming(bufferUI, 1);
+parser_error_t _toStringBalance(uint64_t* amount, uint8_t decimalPlaces, const char *postfix, const char *prefix,
+                                char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount)
+{
+    char bufferUI[MAX_AMOUNT_STR_LEN];
+    if (_formatAmount(bufferUI, sizeof(bufferUI), *amount, decimalPlaces, prefix, postfix) == 0) {
+        return parser_unexpected_buffer_end;
+    }
 
     pageString(outValue, outValueLen, bufferUI, pageIdx, pageCount);
     return parser_ok;
@@ -131,10 +316,5 @@ bool is_opt_in_tx(parser_tx_t *tx_obj) {
 }
 
 bool all_zero_key(uint8_t *buff) {
-  for (int i = 0; i < 32; i++) {
-    if (buff[i] != 0) {
-      return false;
-    }
-  }
-  return true;
+  return bytes_all_zero(buff, 32);
 }
@@ -19,9 +19,35 @@
 #include "stdbool.h"
 #include "parser_common.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 uint32_t encodePubKey(uint8_t *buffer, uint16_t bufferLen, const uint8_t *publicKey);
 
+// base64 of a SHA256 digest
+#define BASE64_HASH_LEN 44
+
+// b64hashLen must hold BASE64_HASH_LEN + 1. The last result is kept until b64hash_reset().
 parser_error_t b64hash_data(unsigned char *data, size_t data_len, char *b64hash, size_t b64hashLen);
+void b64hash_reset(void);
+
+// Page renderers that only encode what the requested page shows: the base64 of `data`, and a
+// JSON value read in place from the request, without its backslashes. pageJsonString fails
+// when the value needs more than 255 pages.
+void pageBase64(char *outValue, uint16_t outValueLen, const uint8_t *data, uint16_t dataLen,
+                uint8_t pageIdx, uint8_t *pageCount);
+parser_error_t pageJsonString(char *outValue, uint16_t outValueLen, const char *value, uint16_t valueLen,
+                              uint8_t pageIdx, uint8_t *pageCount);
+
+// Up to 20 digits of a uint64, a point and 19 decimals, plus room for a ticker or ASA unit
+#define MAX_AMOUNT_DIGITS   20
+#define MAX_AMOUNT_STR_LEN  72
+
+// Writes prefix, amount with `decimalPlaces` decimals (trailing zeros trimmed, one kept) and
+// postfix into `out` in a single pass. Returns the length, or 0 when it does not fit in outLen.
+size_t _formatAmount(char *out, size_t outLen, uint64_t amount, uint8_t decimalPlaces,
+                     const char *prefix, const char *postfix);
 
 parser_error_t _toStringBalance(uint64_t* amount, uint8_t decimalPlaces, const char *postfix, const char *prefix,
                                 char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount);
@@ -32,3 +58,7 @@ parser_error_t _toStringSchema(const state_schema *schema, char* outValue, uint1
 
 bool all_zero_key(uint8_t *buff);
 bool is_opt_in_tx(parser_tx_t *tx_obj);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,486 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <zxmacros.h>
+#include <zxformat.h>
+
+#include "parser_group.h"
+#include "common/parser.h"
+#include "parser_impl.h"
+#include "parser_encoding.h"
+#include "msgpack.h"
+#include "coin.h"
+#include "base64.h"
+#include "sha512.h"
+#include "profile.h"
+
+typedef enum {
+    IDX_GROUP_SIZE = 0,
+    IDX_GROUP_TO_SIGN,
+    IDX_GROUP_ID,
+    IDX_GROUP_NETWORK,
+    IDX_GROUP_TYPES,
+    IDX_GROUP_TOTAL_AMOUNT,
+    IDX_GROUP_TOTAL_FEES,
+    // Then the addresses, the warnings and the details
+    IDX_GROUP_ADDRESSES,
+} group_index_e;
+
+static const char *const group_type_names[] = {
+    [TX_UNKNOWN] = "Unknown",
+    [TX_PAYMENT] = "Payment",
+    [TX_KEYREG] = "Key reg",
+    [TX_ASSET_XFER] = "Asset xfer",
+    [TX_ASSET_FREEZE] = "Asset freeze",
+    [TX_ASSET_CONFIG] = "Asset config",
+    [TX_APPLICATION] = "Application",
+};
+
+static const char *const group_address_names[] = {
+    [GROUP_ADDRESS_RECEIVER] = "Receiver",
+    [GROUP_ADDRESS_CLOSE] = "Close to",
+    [GROUP_ADDRESS_ASSET_RECEIVER] = "Asset dst",
+    [GROUP_ADDRESS_ASSET_CLOSE] = "Asset close",
+    [GROUP_ADDRESS_REKEY] = "Rekey to",
+    [GROUP_ADDRESS_OTHER_SENDER] = "Other sender",
+};
+
+typedef struct {
+    uint8_t flags;
+    const uint8_t *message;     // "TX" || msgpack
+    uint16_t messageLen;
+} group_entry_t;
+
+static parser_error_t readEntry(const uint8_t *buffer, uint16_t bufferLen, uint16_t *offset, group_entry_t *entry) {
+    if (bufferLen - *offset < GROUP_ENTRY_HEADER_LEN + GROUP_TX_PREFIX_LEN) {
+        return parser_unexpected_buffer_end;
+    }
+    const uint8_t *header = buffer + *offset;
+    const uint16_t msgpackLen = (uint16_t) ((header[1] << 8) | header[2]);
+
+    entry->flags = header[0];
+    entry->message = header + GROUP_ENTRY_HEADER_LEN;
+    entry->messageLen = GROUP_TX_PREFIX_LEN + msgpackLen;
+    if (msgpackLen == 0 || bufferLen - *offset - GROUP_ENTRY_HEADER_LEN < entry->messageLen) {
+        return parser_unexpected_buffer_end;
+    }
+    if ((entry->flags & ~GROUP_ENTRY_FLAG_SIGN) != 0 ||
+        entry->message[0] != 'T' || entry->message[1] != 'X') {
+        return parser_unexpected_value;
+    }
+
+    *offset += GROUP_ENTRY_HEADER_LEN + entry->messageLen;
+    return parser_ok;
+}
+
+static void writeMapHeader(uint16_t items, uint8_t *out, uint8_t *outLen) {
+    if (items <= FIXMAP_15 - FIXMAP_0) {
+        out[0] = (uint8_t) (FIXMAP_0 + items);
+        *outLen = 1;
+    } else {
+        out[0] = MAP16;
+        out[1] = (uint8_t) (items >> 8);
+        out[2] = (uint8_t) items;
+        *outLen = 3;
+    }
+}
+
+// The group hash covers the txids the transactions had before `grp` was assigned, i.e.
+// SHA512/256("TX" || msgpack) of the same canonical map without that one entry
+static parser_error_t txidWithoutGroup(const uint8_t *msgpack, uint16_t msgpackLen, uint8_t txid[TXID_LEN]) {
+    parser_context_t ctx = {.buffer = msgpack, .bufferLen = msgpackLen, .offset = 0, .content = MsgPack};
+    uint16_t mapItems = 0;
+    uint16_t grpStart = 0;
+    uint16_t grpEnd = 0;
+
+    CHECK_ERROR(_readMapSize(&ctx, &mapItems))
+    const uint16_t headerLen = ctx.offset;
+    if (_findKeyRange(&ctx, KEY_COMMON_GROUP_ID, &grpStart, &grpEnd) != parser_ok) {
+        return parser_invalid_group;
+    }
+
+    uint8_t header[3];
+    uint8_t newHeaderLen = 0;
+    writeMapHeader(mapItems - 1, header, &newHeaderLen);
+
+    mbedtls_sha512_context sha;
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256_init(&sha);
+    SHA512_update(&sha, (const uint8_t *) "TX", GROUP_TX_PREFIX_LEN);
+    SHA512_update(&sha, header, newHeaderLen);
+    SHA512_update(&sha, msgpack + headerLen, grpStart - headerLen);
+    SHA512_update(&sha, msgpack + grpEnd, msgpackLen - grpEnd);
+    SHA512_final(&sha, digest);
+
+    MEMCPY(txid, digest, TXID_LEN);
+    return parser_ok;
+}
+
+// Lists the address found under `key` for `role`, unless it already is. Absent keys are skipped.
+static parser_error_t addAddress(parser_group_t *group, const uint8_t *msgpack, uint16_t msgpackLen,
+                                 const char *key, uint8_t role, const uint8_t *signer) {
+    parser_context_t ctx = {.buffer = msgpack, .bufferLen = msgpackLen, .offset = 0, .content = MsgPack};
+    uint16_t start = 0;
+    uint16_t end = 0;
+    const parser_error_t err = _findKeyRange(&ctx, key, &start, &end);
+    if (err == parser_no_data) {
+        return parser_ok;
+    }
+    CHECK_ERROR(err)
+
+    // The parser already checked it is a 32-byte bin, so the address ends the value
+    const uint8_t *address = msgpack + end - PK_LEN_25519;
+    if (signer != NULL && memcmp(address, signer, PK_LEN_25519) == 0) {
+        return parser_ok;
+    }
+    for (uint8_t i = 0; i < group->addressCount; i++) {
+        if (group->addresses[i].role == role &&
+            memcmp(group->buffer + group->addresses[i].offset, address, PK_LEN_25519) == 0) {
+            return parser_ok;
+        }
+    }
+    if (group->addressCount >= GROUP_MAX_ADDRESSES) {
+        return parser_unexpected_number_items;
+    }
+    group->addresses[group->addressCount].offset = (uint16_t) (address - group->buffer);
+    group->addresses[group->addressCount].role = role;
+    group->addressCount++;
+    return parser_ok;
+}
+
+static parser_error_t addChecked(uint64_t *total, uint64_t value) {
+    if (*total > UINT64_MAX - value) {
+        return parser_value_out_of_range;
+    }
+    *total += value;
+    return parser_ok;
+}
+
+static parser_error_t accumulate(parser_group_t *group, const parser_tx_t *tx, const uint8_t *signer,
+                                 const uint8_t *msgpack, uint16_t msgpackLen) {
+    group->typeCount[tx->type]++;
+    CHECK_ERROR(addChecked(&group->totalFees, tx->fee))
+
+    CHECK_ERROR(addAddress(group, msgpack, msgpackLen, KEY_COMMON_SENDER, GROUP_ADDRESS_OTHER_SENDER, signer))
+    if (!all_zero_key((uint8_t *) tx->rekey)) {
+        group->rekeyCount++;
+        CHECK_ERROR(addAddress(group, msgpack, msgpackLen, KEY_COMMON_REKEY, GROUP_ADDRESS_REKEY, NULL))
+    }
+
+    switch (tx->type) {
+        case TX_PAYMENT:
+            CHECK_ERROR(addChecked(&group->totalAmount, tx->payment.amount))
+            CHECK_ERROR(addAddress(group, msgpack, msgpackLen, KEY_PAY_RECEIVER, GROUP_ADDRESS_RECEIVER, NULL))
+            if (!all_zero_key((uint8_t *) tx->payment.close)) {
+                group->closeCount++;
+                CHECK_ERROR(addAddress(group, msgpack, msgpackLen, KEY_PAY_CLOSE, GROUP_ADDRESS_CLOSE, NULL))
+            }
+            // The summary has no room for a note or a lease
+            if (tx->note_len == 0 && all_zero_key((uint8_t *) tx->lease)) {
+                return parser_ok;
+            }
+            break;
+        case TX_ASSET_XFER:
+            CHECK_ERROR(addAddress(group, msgpack, msgpackLen, KEY_XFER_RECEIVER, GROUP_ADDRESS_ASSET_RECEIVER, NULL))
+            if (!all_zero_key((uint8_t *) tx->asset_xfer.close)) {
+                group->closeCount++;
+                CHECK_ERROR(addAddress(group, msgpack, msgpackLen, KEY_XFER_CLOSE, GROUP_ADDRESS_ASSET_CLOSE, NULL))
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Everything but plain payments is shown in full, as for a single transaction
+    uint8_t numItems = 0;
+    CHECK_ERROR(parser_getNumItems(&numItems))
+    group_detail_t *detail = &group->details[group->detailCount++];
+    detail->offset = (uint16_t) (msgpack - group->buffer);
+    detail->length = msgpackLen;
+    detail->groupIdx = group->txnCount;
+    detail->numItems = numItems;
+    return parser_ok;
+}
+
+parser_error_t parser_group_parse(const uint8_t *buffer, uint16_t bufferLen, uint8_t expectedTxns,
+                                  const uint8_t signer[PK_LEN_25519],
+                                  parser_group_t *group, parser_tx_t *txObj) {
+    if (buffer == NULL || signer == NULL || group == NULL || txObj == NULL ||
+        expectedTxns == 0 || expectedTxns > GROUP_MAX_TXNS) {
+        return parser_unexpected_number_items;
+    }
+    MEMZERO(group, sizeof(*group));
+    group->buffer = buffer;
+
+    // SHA512/256("TG" || msgpack({"txlist": [txid, ...]})), streamed as txids are computed
+    static const uint8_t txlistKey[] = {FIXMAP_0 + 1, FIXSTR_0 + 6, 't', 'x', 'l', 'i', 's', 't'};
+    const uint8_t binHeader[] = {BIN8, TXID_LEN};
+    uint8_t arrayHeader[3] = {0};
+    uint8_t arrayHeaderLen = 1;
+    if (expectedTxns <= FIXARR_15 - FIXARR_0) {
+        arrayHeader[0] = (uint8_t) (FIXARR_0 + expectedTxns);
+    } else {
+        arrayHeader[0] = ARR16;
+        arrayHeader[2] = expectedTxns;
+        arrayHeaderLen = 3;
+    }
+
+    mbedtls_sha512_context groupSha;
+    SHA512_256_init(&groupSha);
+    SHA512_update(&groupSha, (const uint8_t *) "TG", 2);
+    SHA512_update(&groupSha, txlistKey, sizeof(txlistKey));
+    SHA512_update(&groupSha, arrayHeader, arrayHeaderLen);
+
+    uint16_t offset = 0;
+    while (offset < bufferLen) {
+        group_entry_t entry;
+        CHECK_ERROR(readEntry(buffer, bufferLen, &offset, &entry))
+        if (group->txnCount == expectedTxns) {
+            return parser_unexpected_number_items;
+        }
+
+        const uint8_t *msgpack = entry.message + GROUP_TX_PREFIX_LEN;
+        const uint16_t msgpackLen = entry.messageLen - GROUP_TX_PREFIX_LEN;
+
+        parser_context_t ctx;
+        MEMZERO(&ctx, sizeof(ctx));
+        MEMZERO(txObj, sizeof(*txObj));
+        CHECK_ERROR(parser_parse(&ctx, msgpack, msgpackLen, txObj, MsgPack))
+
+        if (all_zero_key(txObj->groupID)) {
+            return parser_invalid_group;
+        }
+        if (group->txnCount == 0) {
+            MEMCPY(group->groupID, txObj->groupID, sizeof(group->groupID));
+            MEMCPY(group->genesisHash, txObj->genesisHash, sizeof(group->genesisHash));
+            group->network = txObj->network;
+        } else if (memcmp(group->groupID, txObj->groupID, sizeof(group->groupID)) != 0 ||
+                   memcmp(group->genesisHash, txObj->genesisHash, sizeof(group->genesisHash)) != 0) {
+            return parser_invalid_group;
+        }
+
+        uint8_t txid[TXID_LEN];
+        CHECK_ERROR(txidWithoutGroup(msgpack, msgpackLen, txid))
+        SHA512_update(&groupSha, binHeader, sizeof(binHeader));
+        SHA512_update(&groupSha, txid, sizeof(txid));
+
+        if ((entry.flags & GROUP_ENTRY_FLAG_SIGN) != 0) {
+            CHECK_ERROR(parser_validate(&ctx))
+            CHECK_ERROR(accumulate(group, txObj, signer, msgpack, msgpackLen))
+            group->signCount++;
+        }
+        group->txnCount++;
+    }
+
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_final(&groupSha, digest);
+
+    if (group->txnCount != expectedTxns || group->signCount == 0) {
+        return parser_unexpected_number_items;
+    }
+    if (memcmp(digest, group->groupID, sizeof(group->groupID)) != 0) {
+        return parser_invalid_group;
+    }
+
+    // The whole review must fit the item index
+    uint16_t numItems = IDX_GROUP_ADDRESSES + group->addressCount +
+                        (group->rekeyCount > 0 ? 1 : 0) + (group->closeCount > 0 ? 1 : 0);
+    for (uint8_t i = 0; i < group->detailCount; i++) {
+        numItems += group->details[i].numItems;
+    }
+    if (numItems > UINT8_MAX) {
+        return parser_unexpected_number_items;
+    }
+    group->numItems = (uint8_t) numItems;
+    return parser_ok;
+}
+
+parser_error_t parser_group_getNumItems(const parser_group_t *group, uint8_t *numItems) {
+    if (group == NULL || numItems == NULL || group->txnCount == 0) {
+        return parser_unexpected_number_items;
+    }
+    *numItems = group->numItems;
+    return parser_ok;
+}
+
+static parser_error_t printTypes(const parser_group_t *group, char *outVal, uint16_t outValLen,
+                                 uint8_t pageIdx, uint8_t *pageCount) {
+    char buff[120] = {0};
+    uint16_t len = 0;
+    for (uint8_t type = TX_PAYMENT; type <= TX_APPLICATION; type++) {
+        if (group->typeCount[type] == 0) {
+            continue;
+        }
+        const int written = snprintf(buff + len, sizeof(buff) - len, "%s%u %s",
+                                     len > 0 ? ", " : "", group->typeCount[type], group_type_names[type]);
+        if (written < 0 || (size_t) written >= sizeof(buff) - len) {
+            return parser_unexpected_buffer_end;
+        }
+        len += (uint16_t) written;
+    }
+    pageString(outVal, outValLen, buff, pageIdx, pageCount);
+    return parser_ok;
+}
+
+static parser_error_t printAddress(const parser_group_t *group, const group_address_t *address,
+                                   char *outKey, uint16_t outKeyLen,
+                                   char *outVal, uint16_t outValLen,
+                                   uint8_t pageIdx, uint8_t *pageCount) {
+    char buff[65] = {0};
+    snprintf(outKey, outKeyLen, "%s", group_address_names[address->role]);
+    if (encodePubKey((uint8_t *) buff, sizeof(buff), group->buffer + address->offset) == 0) {
+        return parser_unexpected_buffer_end;
+    }
+    pageString(outVal, outValLen, buff, pageIdx, pageCount);
+    return parser_ok;
+}
+
+// Parses the transaction again and shows its item as the single transaction review does
+static parser_error_t printDetail(const parser_group_t *group, const group_detail_t *detail,
+                                  parser_tx_t *txObj, uint8_t itemIdx,
+                                  char *outKey, uint16_t outKeyLen,
+                                  char *outVal, uint16_t outValLen,
+                                  uint8_t pageIdx, uint8_t *pageCount) {
+    parser_context_t ctx;
+    char key[40] = {0};
+    MEMZERO(&ctx, sizeof(ctx));
+    MEMZERO(txObj, sizeof(*txObj));
+    CHECK_ERROR(parser_parse(&ctx, group->buffer + detail->offset, detail->length, txObj, MsgPack))
+    CHECK_ERROR(parser_getItem(&ctx, itemIdx, key, sizeof(key), outVal, outValLen, pageIdx, pageCount))
+    snprintf(outKey, outKeyLen, "Txn %u: %s", detail->groupIdx + 1, key);
+    return parser_ok;
+}
+
+parser_error_t parser_group_getItem(const parser_group_t *group, parser_tx_t *txObj, uint8_t displayIdx,
+                                    char *outKey, uint16_t outKeyLen,
+                                    char *outVal, uint16_t outValLen,
+                                    uint8_t pageIdx, uint8_t *pageCount) {
+    uint8_t numItems = 0;
+    CHECK_ERROR(parser_group_getNumItems(group, &numItems))
+    if (txObj == NULL || displayIdx >= numItems) {
+        return parser_display_idx_out_of_range;
+    }
+
+    MEMZERO(outKey, outKeyLen);
+    MEMZERO(outVal, outValLen);
+    *pageCount = 1;
+
+    switch (displayIdx) {
+        case IDX_GROUP_SIZE:
+            snprintf(outKey, outKeyLen, "Group txns");
+            snprintf(outVal, outValLen, "%u", group->txnCount);
+            return parser_ok;
+
+        case IDX_GROUP_TO_SIGN:
+            snprintf(outKey, outKeyLen, "To sign");
+            snprintf(outVal, outValLen, "%u", group->signCount);
+            return parser_ok;
+
+        case IDX_GROUP_ID:
+            snprintf(outKey, outKeyLen, "Group ID");
+            pageBase64(outVal, outValLen, (const uint8_t*) group->groupID, sizeof(group->groupID), pageIdx, pageCount);
+            return parser_ok;
+
+        case IDX_GROUP_NETWORK:
+            if (group->network != NULL) {
+                snprintf(outKey, outKeyLen, "Network");
+                pageString(outVal, outValLen, group->network->name, pageIdx, pageCount);
+                return parser_ok;
+            }
+            snprintf(outKey, outKeyLen, "Genesis hash");
+            pageBase64(outVal, outValLen, group->genesisHash, sizeof(group->genesisHash), pageIdx, pageCount);
+            return parser_ok;
+
+        case IDX_GROUP_TYPES:
+            snprintf(outKey, outKeyLen, "Txn types");
+            return printTypes(group, outVal, outValLen, pageIdx, pageCount);
+
+        case IDX_GROUP_TOTAL_AMOUNT: {
+            snprintf(outKey, outKeyLen, "Total amount");
+            uint64_t amount = group->totalAmount;
+            return _toStringBalance(&amount, COIN_AMOUNT_DECIMAL_PLACES, "", COIN_TICKER,
+                                    outVal, outValLen, pageIdx, pageCount);
+        }
+
+        case IDX_GROUP_TOTAL_FEES: {
+            snprintf(outKey, outKeyLen, "Total fees");
+            uint64_t fees = group->totalFees;
+            return _toStringBalance(&fees, COIN_AMOUNT_DECIMAL_PLACES, "", COIN_TICKER,
+                                    outVal, outValLen, pageIdx, pageCount);
+        }
+
+        default:
+            break;
+    }
+
+    uint8_t item = displayIdx - IDX_GROUP_ADDRESSES;
+    if (item < group->addressCount) {
+        return printAddress(group, &group->addresses[item], outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+    }
+    item -= group->addressCount;
+
+    // Warnings are only listed when present
+    if (group->rekeyCount > 0) {
+        if (item == 0) {
+            snprintf(outKey, outKeyLen, "Rekey");
+            snprintf(outVal, outValLen, "WARNING: %u txns rekey", group->rekeyCount);
+            return parser_ok;
+        }
+        item--;
+    }
+    if (group->closeCount > 0) {
+        if (item == 0) {
+            snprintf(outKey, outKeyLen, "Close");
+            snprintf(outVal, outValLen, "WARNING: %u txns close", group->closeCount);
+            return parser_ok;
+        }
+        item--;
+    }
+
+    for (uint8_t i = 0; i < group->detailCount; i++) {
+        if (item < group->details[i].numItems) {
+            return printDetail(group, &group->details[i], txObj, item,
+                               outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        }
+        item -= group->details[i].numItems;
+    }
+    return parser_display_idx_out_of_range;
+}
+
+parser_error_t parser_group_getSignable(const uint8_t *buffer, uint16_t bufferLen, uint8_t signIdx,
+                                        const uint8_t **message, uint16_t *messageLen) {
+    if (buffer == NULL || message == NULL || messageLen == NULL) {
+        return parser_unexpected_value;
+    }
+
+    uint16_t offset = 0;
+    uint8_t signable = 0;
+    while (offset < bufferLen) {
+        group_entry_t entry;
+        CHECK_ERROR(readEntry(buffer, bufferLen, &offset, &entry))
+        if ((entry.flags & GROUP_ENTRY_FLAG_SIGN) == 0) {
+            continue;
+        }
+        if (signable == signIdx) {
+            *message = entry.message;
+            *messageLen = entry.messageLen;
+            return parser_ok;
+        }
+        signable++;
+    }
+    return parser_no_data;
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "parser_common.h"
+#include "parser_txdef.h"
+#include "coin.h"
+
+// Algorand consensus limit on atomic group size
+#define GROUP_MAX_TXNS              16
+
+// Buffered entry: flags (1) | msgpack length (2, big endian) | "TX" | msgpack
+#define GROUP_ENTRY_FLAGS_LEN       1
+#define GROUP_ENTRY_LENGTH_LEN      2
+#define GROUP_ENTRY_HEADER_LEN      (GROUP_ENTRY_FLAGS_LEN + GROUP_ENTRY_LENGTH_LEN)
+#define GROUP_TX_PREFIX_LEN         2
+
+// Set for the transactions the device must sign; the others are only hashed
+#define GROUP_ENTRY_FLAG_SIGN       0x01
+
+// Every address of a signed transaction is listed once per role: snd, rcv, close, rekey
+#define GROUP_MAX_ADDRESSES         (4 * GROUP_MAX_TXNS)
+
+typedef enum {
+    GROUP_ADDRESS_RECEIVER = 0,
+    GROUP_ADDRESS_CLOSE,
+    GROUP_ADDRESS_ASSET_RECEIVER,
+    GROUP_ADDRESS_ASSET_CLOSE,
+    GROUP_ADDRESS_REKEY,
+    GROUP_ADDRESS_OTHER_SENDER,     // sender that is not the signing account
+} group_address_role_e;
+
+typedef struct {
+    uint16_t offset;                // of the 32-byte address in the group buffer
+    uint8_t role;                   // group_address_role_e
+} group_address_t;
+
+// Signed transaction other than a payment, reviewed item by item
+typedef struct {
+    uint16_t offset;                // of its msgpack in the group buffer
+    uint16_t length;
+    uint8_t groupIdx;
+    uint8_t numItems;
+} group_detail_t;
+
+typedef struct {
+    // Group entries the addresses and details point into, kept until the review ends
+    const uint8_t *buffer;
+
+    uint8_t txnCount;
+    uint8_t signCount;
+    uint8_t groupID[32];
+    // Shared by every transaction of the group
+    uint8_t genesisHash[GENESIS_HASH_LEN];
+    const algo_network_info_t *network;
+    uint8_t numItems;
+
+    // Aggregates over the transactions to sign
+    uint8_t typeCount[TX_APPLICATION + 1];
+    uint64_t totalAmount;
+    uint64_t totalFees;
+    uint8_t rekeyCount;
+    uint8_t closeCount;
+
+    uint8_t addressCount;
+    group_address_t addresses[GROUP_MAX_ADDRESSES];
+    uint8_t detailCount;
+    group_detail_t details[GROUP_MAX_TXNS];
+} parser_group_t;
+
+/// Parses and validates every buffered transaction, checks that they all carry the same
+/// `grp` and `gh` and that `grp` matches the group hash recomputed from their txids. `signer` is the
+/// public key of the signing account: senders other than it are listed for review.
+parser_error_t parser_group_parse(const uint8_t *buffer, uint16_t bufferLen, uint8_t expectedTxns,
+                                  const uint8_t signer[PK_LEN_25519],
+                                  parser_group_t *group, parser_tx_t *txObj);
+
+parser_error_t parser_group_getNumItems(const parser_group_t *group, uint8_t *numItems);
+
+/// Details are parsed again into txObj when they are displayed
+parser_error_t parser_group_getItem(const parser_group_t *group, parser_tx_t *txObj, uint8_t displayIdx,
+                                    char *outKey, uint16_t outKeyLen,
+                                    char *outVal, uint16_t outValLen,
+                                    uint8_t pageIdx, uint8_t *pageCount);
+
+/// Returns "TX" || msgpack of the signIdx-th transaction flagged for signing
+parser_error_t parser_group_getSignable(const uint8_t *buffer, uint16_t bufferLen, uint8_t signIdx,
+                                        const uint8_t **message, uint16_t *messageLen);
+
+#ifdef __cplusplus
+}
+#endif
@@ -26,6 +26,9 @@
 #include "zxerror.h"
 #include "jsmn.h"
 #include "base64.h"
+#include "profile.h"
+#include "byte_class.h"
+#include "parser_schema.h"
 
 #if defined(LEDGER_SPECIFIC)
 #include "crypto.h"
@@ -118,8 +121,6 @@ static uint8_t common_num_items;
 static uint8_t tx_num_items;
 static uint8_t num_json_items;
 
-static credential_public_key_t credential_public_key;
-
 #define KEY_VALUE_CRV -1
 #define KEY_VALUE_KTY 1
 #define KEY_VALUE_ALG 3
@@ -136,7 +137,6 @@ static credential_public_key_t credential_public_key;
 #define CRV_ED25519 6
 #define CRV_ED448 7
 
-#define MAX_PARAM_SIZE 12
 #define MAX_ITEM_ARRAY 50
 static uint8_t itemArray[MAX_ITEM_ARRAY] = {0};
 static uint8_t itemIndex = 0;
@@ -156,8 +156,8 @@ static parser_error_t _readData(parser_context_t *c, parser_arbitrary_data_t *v)
 static parser_error_t _readDomain(parser_context_t *c, parser_arbitrary_data_t *v);
 static parser_error_t _readAuthData(parser_context_t *c, parser_arbitrary_data_t *v);
 static parser_error_t _readRequestId(parser_context_t *c, parser_arbitrary_data_t *v);
-static parser_error_t checkCredentialPublicKeyItem(cbor_value_t *key, cbor_value_t *value);
-static parser_error_t checkExtensionsItem(cbor_value_t *key, cbor_value_t *value);
+static parser_error_t checkCredentialPublicKeyItem(cbor_reader_t *reader, credential_public_key_t *key);
+static parser_error_t checkExtensionsItem(cbor_reader_t *reader);
 
 #define SCOPE_AUTH 0x01
 #define ENCODING_BASE64 0x01
@@ -580,138 +580,6 @@ parser_error_t _readBool(parser_context_t *c, uint8_t *value)
     return parser_ok;
 }
 
-static parser_error_t _readAssetParams(parser_context_t *c, txn_asset_config *asset_config)
-{
-    uint8_t available_params[MAX_PARAM_SIZE];
-    memset(available_params, 0xFF, MAX_PARAM_SIZE);
-
-    uint16_t paramsSize = 0;
-    CHECK_ERROR(_readMapSize(c, &paramsSize))
-
-    if(paramsSize > MAX_PARAM_SIZE) {
-        return parser_unexpected_number_items;
-    }
-
-    uint8_t key[10] = {0};
-    for(uint16_t i = 0; i < paramsSize; i++) {
-        CHECK_ERROR(_readString(c, key, sizeof(key)))
-
-        if (strncmp((char*)key, KEY_APARAMS_TOTAL, strlen(KEY_APARAMS_TOTAL)) == 0) {
-            CHECK_ERROR(_readInteger(c, &asset_config->params.total))
-            available_params[IDX_CONFIG_TOTAL_UNITS] = IDX_CONFIG_TOTAL_UNITS;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_DEF_FROZEN, strlen(KEY_APARAMS_DEF_FROZEN)) == 0) {
-            CHECK_ERROR(_readBool(c, &asset_config->params.default_frozen))
-            available_params[IDX_CONFIG_FROZEN] = IDX_CONFIG_FROZEN;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_UNIT_NAME, strlen(KEY_APARAMS_UNIT_NAME)) == 0) {
-            memset(asset_config->params.unitname, 0, sizeof(asset_config->params.unitname));
-            CHECK_ERROR(_readString(c, (uint8_t*)asset_config->params.unitname, sizeof(asset_config->params.unitname)))
-            available_params[IDX_CONFIG_UNIT_NAME] = IDX_CONFIG_UNIT_NAME;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_DECIMALS, strlen(KEY_APARAMS_DECIMALS)) == 0) {
-            CHECK_ERROR(_readInteger(c, &asset_config->params.decimals))
-            available_params[IDX_CONFIG_DECIMALS] = IDX_CONFIG_DECIMALS;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_ASSET_NAME, strlen(KEY_APARAMS_ASSET_NAME)) == 0) {
-            memset(asset_config->params.assetname, 0, sizeof(asset_config->params.assetname));
-            CHECK_ERROR(_readString(c, (uint8_t*)asset_config->params.assetname, sizeof(asset_config->params.assetname)))
-            available_params[IDX_CONFIG_ASSET_NAME] = IDX_CONFIG_ASSET_NAME;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_URL, strlen(KEY_APARAMS_URL)) == 0) {
-            memset(asset_config->params.url, 0, sizeof(asset_config->params.url));
-            CHECK_ERROR(_readString(c, (uint8_t*)asset_config->params.url, sizeof(asset_config->params.url)))
-            available_params[IDX_CONFIG_URL] = IDX_CONFIG_URL;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_METADATA_HASH, strlen(KEY_APARAMS_METADATA_HASH)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.metadata_hash, sizeof(asset_config->params.metadata_hash)))
-            available_params[IDX_CONFIG_METADATA_HASH] = IDX_CONFIG_METADATA_HASH;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_MANAGER, strlen(KEY_APARAMS_MANAGER)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.manager, sizeof(asset_config->params.manager)))
-            available_params[IDX_CONFIG_MANAGER] = IDX_CONFIG_MANAGER;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_RESERVE, strlen(KEY_APARAMS_RESERVE)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.reserve, sizeof(asset_config->params.reserve)))
-            available_params[IDX_CONFIG_RESERVE] = IDX_CONFIG_RESERVE;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_FREEZE, strlen(KEY_APARAMS_FREEZE)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.freeze, sizeof(asset_config->params.freeze)))
-            available_params[IDX_CONFIG_FREEZER] = IDX_CONFIG_FREEZER;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_CLAWBACK, strlen(KEY_APARAMS_CLAWBACK)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.clawback, sizeof(asset_config->params.clawback)))
-            available_params[IDX_CONFIG_CLAWBACK] = IDX_CONFIG_CLAWBACK;
-            continue;
-        }
-    }
-
-    for(uint8_t i = 0; i < MAX_PARAM_SIZE; i++) {
-        switch (available_params[i])
-        {
-        case IDX_CONFIG_ASSET_ID:
-            DISPLAY_ITEM(IDX_CONFIG_ASSET_ID, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_TOTAL_UNITS:
-            DISPLAY_ITEM(IDX_CONFIG_TOTAL_UNITS, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_FROZEN:
-            DISPLAY_ITEM(IDX_CONFIG_FROZEN, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_UNIT_NAME:
-            DISPLAY_ITEM(IDX_CONFIG_UNIT_NAME, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_DECIMALS:
-            DISPLAY_ITEM(IDX_CONFIG_DECIMALS, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_ASSET_NAME:
-            DISPLAY_ITEM(IDX_CONFIG_ASSET_NAME, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_URL:
-            DISPLAY_ITEM(IDX_CONFIG_URL, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_METADATA_HASH:
-            DISPLAY_ITEM(IDX_CONFIG_METADATA_HASH, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_MANAGER:
-            DISPLAY_ITEM(IDX_CONFIG_MANAGER, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_RESERVE:
-            DISPLAY_ITEM(IDX_CONFIG_RESERVE, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_FREEZER:
-            DISPLAY_ITEM(IDX_CONFIG_FREEZER, 1, tx_num_items)
-            break;
-        case IDX_CONFIG_CLAWBACK:
-            DISPLAY_ITEM(IDX_CONFIG_CLAWBACK, 1, tx_num_items)
-            break;
-        default:
-            break;
-        }
-    }
-    return parser_ok;
-}
-
 parser_error_t _verifyAppArgs(parser_context_t *c, uint16_t args_len[], uint8_t *args_array_len, size_t max_array_len)
 {
     CHECK_ERROR(_readArraySize(c, args_array_len))
@@ -871,90 +739,6 @@ parser_error_t _readBoxes(parser_context_t *c, box boxes[], uint8_t *num_element
     return parser_ok;
 }
 
-static parser_error_t _readTxType(parser_context_t *c, parser_tx_t *v)
-{
-    char typeStr[10] = {0};
-    CHECK_ERROR(_findKey(c, KEY_COMMON_TYPE))
-    CHECK_ERROR(_readString(c, (uint8_t*) typeStr, sizeof(typeStr)))
-
-    if (strncmp(typeStr, KEY_TX_PAY, sizeof(KEY_TX_PAY)) == 0) {
-        v->type = TX_PAYMENT;
-    } else if (strncmp(typeStr, KEY_TX_KEYREG, sizeof(KEY_TX_KEYREG)) == 0) {
-        v->type = TX_KEYREG;
-    } else if (strncmp(typeStr, KEY_TX_ASSET_XFER, sizeof(KEY_TX_ASSET_XFER)) == 0) {
-        v->type = TX_ASSET_XFER;
-    } else if (strncmp(typeStr, KEY_TX_ASSET_FREEZE, sizeof(KEY_TX_ASSET_FREEZE)) == 0) {
-        v->type = TX_ASSET_FREEZE;
-    } else if (strncmp(typeStr, KEY_TX_ASSET_CONFIG, sizeof(KEY_TX_ASSET_CONFIG)) == 0) {
-        v->type = TX_ASSET_CONFIG;
-    } else if (strncmp(typeStr, KEY_TX_APPLICATION, sizeof(KEY_TX_APPLICATION)) == 0) {
-        v->type = TX_APPLICATION;
-    } else {
-        v->type = TX_UNKNOWN;
-        return parser_no_data;
-    }
-
-    return parser_ok;
-}
-
-static parser_error_t _readTxCommonParams(parser_context_t *c, parser_tx_t *v)
-{
-    common_num_items = 0;
-
-    MEMZERO(v->rekey, sizeof(v->rekey));
-
-    CHECK_ERROR(_findKey(c, KEY_COMMON_SENDER))
-    CHECK_ERROR(_readBinFixed(c, v->sender, sizeof(v->sender)))
-    DISPLAY_ITEM(IDX_COMMON_SENDER, 1, common_num_items)
-
-    if (_findKey(c, KEY_COMMON_LEASE) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->lease, sizeof(v->lease)))
-        DISPLAY_ITEM(IDX_COMMON_LEASE, 1, common_num_items)
-    }
-
-    if (_findKey(c, KEY_COMMON_REKEY) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->rekey, sizeof(v->rekey)))
-        DISPLAY_ITEM(IDX_COMMON_REKEY_TO, 1, common_num_items)
-    }
-
-    v->fee = 0;
-    if (_findKey(c, KEY_COMMON_FEE) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &v->fee))
-    }
-    DISPLAY_ITEM(IDX_COMMON_FEE, 1, common_num_items)
-
-    if (_findKey(c, KEY_COMMON_GEN_ID) == parser_ok) {
-        CHECK_ERROR(_readString(c, (uint8_t*)v->genesisID, sizeof(v->genesisID)))
-        DISPLAY_ITEM(IDX_COMMON_GEN_ID, 1, common_num_items)
-    }
-
-    CHECK_ERROR(_findKey(c, KEY_COMMON_GEN_HASH))
-    CHECK_ERROR(_readBinFixed(c, v->genesisHash, sizeof(v->genesisHash)))
-    DISPLAY_ITEM(IDX_COMMON_GEN_HASH, 1, common_num_items)
-
-    if (_findKey(c, KEY_COMMON_GROUP_ID) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->groupID, sizeof(v->groupID)))
-        DISPLAY_ITEM(IDX_COMMON_GROUP_ID, 1, common_num_items)
-    }
-
-    if (_findKey(c, KEY_COMMON_NOTE) == parser_ok) {
-        CHECK_ERROR(_readBinSize(c, &v->note_len))
-        if(v->note_len > MAX_NOTE_LEN) {
-            return parser_unexpected_value;
-        }
-        DISPLAY_ITEM(IDX_COMMON_NOTE, 1, common_num_items)
-    }
-
-    // First and Last valid won't be display --> don't count them
-    CHECK_ERROR(_findKey(c, KEY_COMMON_FIRST_VALID))
-    CHECK_ERROR(_readInteger(c, &v->firstValid))
-
-    CHECK_ERROR(_findKey(c, KEY_COMMON_LAST_VALID))
-    CHECK_ERROR(_readInteger(c, &v->lastValid))
-
-    return parser_ok;
-}
-
 static parser_error_t _verifyValue(parser_context_t *c) {
     if (c == NULL) return parser_unexpected_error;
 
@@ -1017,6 +801,7 @@ static parser_error_t _verifyValue(parser_context_t *c) {
 }
 parser_error_t _findKey(parser_context_t *c, const char *key) {
     uint8_t tmpKey[20] = {0};
+    PROFILE_COUNT(PROFILE_FIND_KEY);
 
     // Process buffer from start
     c->offset = 0;
@@ -1027,196 +812,426 @@ parser_error_t _findKey(parser_context_t *c, const char *key) {
         if (strncmp((char*)tmpKey, key, strlen(key)) == 0) {
             return parser_ok;
         }
+        const uint16_t skipStart = c->offset;
         CHECK_ERROR(_verifyValue(c))
+        PROFILE_ADD(PROFILE_FIND_KEY_SKIPPED_BYTES, c->offset - skipStart);
     }
 
     return parser_no_data;
 }
 
-static parser_error_t _readTxPayment(parser_context_t *c, parser_tx_t *v)
-{
-    tx_num_items = 0;
-    MEMZERO(v->payment.close, sizeof(v->payment.close));
-
-    CHECK_ERROR(_findKey(c, KEY_PAY_RECEIVER))
-    CHECK_ERROR(_readBinFixed(c, v->payment.receiver, sizeof(v->payment.receiver)))
-    DISPLAY_ITEM(IDX_PAYMENT_RECEIVER, 1, tx_num_items)
-
-    v->payment.amount = 0;
-    if (_findKey(c, KEY_PAY_AMOUNT) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &v->payment.amount))
-    }
-    DISPLAY_ITEM(IDX_PAYMENT_AMOUNT, 1, tx_num_items)
+// Locates a top-level key (exact match) and returns the byte range [start, end) covering
+// the key and its value
+parser_error_t _findKeyRange(parser_context_t *c, const char *key, uint16_t *start, uint16_t *end) {
+    uint8_t tmpKey[20] = {0};
 
-    if (_findKey(c, KEY_PAY_CLOSE) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->payment.close, sizeof(v->payment.close)))
-        DISPLAY_ITEM(IDX_PAYMENT_CLOSE_TO, 1, tx_num_items)
+    c->offset = 0;
+    uint16_t keysLen = 0;
+    CHECK_ERROR(_readMapSize(c, &keysLen))
+    for (uint16_t i = 0; i < keysLen; i++) {
+        const uint16_t keyStart = c->offset;
+        CHECK_ERROR(_readString(c, tmpKey, sizeof(tmpKey)))
+        const bool found = strncmp((char*)tmpKey, key, sizeof(tmpKey)) == 0;
+        CHECK_ERROR(_verifyValue(c))
+        if (found) {
+            *start = keyStart;
+            *end = c->offset;
+            return parser_ok;
+        }
     }
 
-    return parser_ok;
+    return parser_no_data;
 }
 
-static parser_error_t _readTxKeyreg(parser_context_t *c, parser_tx_t *v)
-{
-    tx_num_items = 0;
-    if (_findKey(c, KEY_VOTE_PK) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->keyreg.votepk, sizeof(v->keyreg.votepk)))
-        DISPLAY_ITEM(IDX_KEYREG_VOTE_PK, 1, tx_num_items)
-    }
+typedef struct {
+    uint64_t present;
+    uint16_t valueOffset[SCHEMA_MAX_KEYS];
+} schema_index_t;
 
-    if (_findKey(c, KEY_VRF_PK) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->keyreg.vrfpk, sizeof(v->keyreg.vrfpk)))
-        DISPLAY_ITEM(IDX_KEYREG_VRF_PK, 1, tx_num_items)
-    }
+#define SCHEMA_KEY_BIT(KEY) ((uint64_t) 1u << (KEY))
 
-    if (_findKey(c, KEY_SPRF_PK) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->keyreg.sprfkey, sizeof(v->keyreg.sprfkey)))
-        DISPLAY_ITEM(IDX_KEYREG_SPRF_PK, 1, tx_num_items)
+// Algorand signs the canonical MsgPack encoding: keys sorted and unique, the shortest header
+// for every integer, string, bin, array and map, and no field holding its zero value (0, false
+// or empty), since those are omitted. On a violation the offset points at the offending item.
+static parser_error_t _verifyCanonicalValue(parser_context_t *c, bool field);
+
+// Keys are a few bytes long, too short to amortize a call to memcmp
+static int _compareKeys(const uint8_t *a, uint8_t aLen, const uint8_t *b, uint8_t bLen)
+{
+    const uint8_t len = aLen < bLen ? aLen : bLen;
+    for (uint8_t i = 0; i < len; i++) {
+        if (a[i] != b[i]) {
+            return (int) a[i] - (int) b[i];
+        }
     }
+    return (int) aLen - (int) bLen;
+}
 
-    if (_findKey(c, KEY_VOTE_FIRST) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &v->keyreg.voteFirst))
-        DISPLAY_ITEM(IDX_KEYREG_VOTE_FIRST, 1, tx_num_items)
+static parser_error_t _readCanonicalKey(parser_context_t *c, const uint8_t **key, uint8_t *keyLen)
+{
+    const uint16_t start = c->offset;
+    uint8_t byte = 0;
+    CHECK_ERROR(_readUInt8(c, &byte))
 
-        CHECK_ERROR(_findKey(c, KEY_VOTE_LAST))
-        CHECK_ERROR(_readInteger(c, &v->keyreg.voteLast))
-        DISPLAY_ITEM(IDX_KEYREG_VOTE_LAST, 1, tx_num_items)
+    switch (getMsgPackType(byte)) {
+        case FIXSTR_0:
+            *keyLen = byte - FIXSTR_0;
+            break;
+        case STR8:
+            CHECK_ERROR(_readUInt8(c, keyLen))
+            if (*keyLen <= FIXSTR_31 - FIXSTR_0) {
+                c->offset = start;
+                return parser_msgpack_non_minimal_encoding;
+            }
+            break;
+        case STR16:
+        case STR32:
+            return parser_msgpack_str_type_not_supported;
+        default:
+            return parser_msgpack_str_type_expected;
     }
+    return _getPointerBytes(c, key, *keyLen);
+}
 
-    if (_findKey(c, KEY_VOTE_KEY_DILUTION) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &v->keyreg.keyDilution))
-        DISPLAY_ITEM(IDX_KEYREG_KEY_DILUTION, 1, tx_num_items)
-    }
+// First two bytes of a key, zero padded, which order keys like their full bytes do. Schema
+// key names are already zero padded.
+#define KEY_PREFIX(KEY, LEN) ((uint16_t) (((KEY)[0] << 8) | ((LEN) > 1 ? (KEY)[1] : 0)))
+#define SCHEMA_KEY_PREFIX(KEY) ((uint16_t) (((uint8_t) (KEY)->name[0] << 8) | (uint8_t) (KEY)->name[1]))
 
-    if (_findKey(c, KEY_VOTE_NON_PART_FLAG) == parser_ok) {
-        CHECK_ERROR(_readBool(c, &v->keyreg.nonpartFlag))
-    }
-    DISPLAY_ITEM(IDX_KEYREG_PARTICIPATION, 1, tx_num_items)
+// Checks the entries of a map whose header was just read. With an index, the values of the
+// keys listed in the schema are recorded on the way; other keys are ignored.
+static parser_error_t _verifyCanonicalEntries(parser_context_t *c, uint16_t entries,
+                                              const schema_map_t *map, schema_index_t *index)
+{
+    const uint8_t *prevKey = NULL;
+    uint8_t prevKeyLen = 0;
+    uint8_t next = 0;
+
+    if (index != NULL) {
+        index->present = 0;
+    }
+
+    for (uint16_t i = 0; i < entries; i++) {
+        const uint16_t keyStart = c->offset;
+        const uint8_t *key = NULL;
+        uint8_t keyLen = 0;
+        CHECK_ERROR(_readCanonicalKey(c, &key, &keyLen))
+        if (prevKey != NULL && _compareKeys(prevKey, prevKeyLen, key, keyLen) >= 0) {
+            c->offset = keyStart;
+            return parser_msgpack_unsorted_keys;
+        }
+        prevKey = key;
+        prevKeyLen = keyLen;
+
+        // An empty key names no field, and may be the last byte of the buffer
+        if (index != NULL && keyLen > 0) {
+            // Sorted keys only ever move the table cursor forward. It skips the keys whose
+            // first two bytes sort lower before comparing whole keys.
+            const uint16_t prefix = KEY_PREFIX(key, keyLen);
+            int cmp = -1;
+            while (next < map->keyCount && SCHEMA_KEY_PREFIX(&map->keys[next]) < prefix) {
+                next++;
+            }
+            while (next < map->keyCount &&
+                   (cmp = _compareKeys((const uint8_t*) map->keys[next].name, map->keys[next].len, key, keyLen)) < 0) {
+                next++;
+            }
+            if (next < map->keyCount && cmp == 0) {
+                index->valueOffset[next] = c->offset;
+                index->present |= SCHEMA_KEY_BIT(next);
+                next++;
+            }
+        }
 
+        CHECK_ERROR(_verifyCanonicalValue(c, true))
+    }
     return parser_ok;
 }
 
-static parser_error_t _readTxAssetXfer(parser_context_t *c, parser_tx_t *v)
+static parser_error_t _verifyCanonicalValue(parser_context_t *c, bool field)
 {
-    tx_num_items = 0;
-    MEMZERO(v->asset_xfer.close, sizeof(v->asset_xfer.close));
+    CHECK_APP_CANARY()
 
-    CHECK_ERROR(_findKey(c, KEY_XFER_ID))
-    CHECK_ERROR(_readInteger(c, &v->asset_xfer.id))
-    DISPLAY_ITEM(IDX_XFER_ASSET_ID, 1, tx_num_items)
+    const uint16_t start = c->offset;
+    uint8_t valueType = 0;
+    CHECK_ERROR(_readUInt8(c, &valueType))
+    c->offset = start;
 
-    v->asset_xfer.amount = 0;
-    if (_findKey(c, KEY_XFER_AMOUNT) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &v->asset_xfer.amount))
-    }
-    DISPLAY_ITEM(IDX_XFER_AMOUNT, 1, tx_num_items)
+    // Smallest length or value that needs the header found, and the length or value read
+    uint64_t minimal = 0;
+    uint64_t value = 0;
 
-    CHECK_ERROR(_findKey(c, KEY_XFER_RECEIVER))
-    CHECK_ERROR(_readBinFixed(c, v->asset_xfer.receiver, sizeof(v->asset_xfer.receiver)))
-    DISPLAY_ITEM(IDX_XFER_DESTINATION, 1, tx_num_items)
+    if (valueType <= FIXINT_127 || (valueType >= UINT8 && valueType <= UINT64)) {
+        CHECK_ERROR(_readInteger(c, &value))
+        minimal = valueType == UINT8 ? 0x80 : valueType == UINT16 ? 0x100 :
+                  valueType == UINT32 ? 0x10000 : valueType == UINT64 ? 0x100000000 : 0;
 
-    if (_findKey(c, KEY_XFER_SENDER) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->asset_xfer.sender, sizeof(v->asset_xfer.sender)))
-        DISPLAY_ITEM(IDX_XFER_SOURCE, 1, tx_num_items)
-    }
+    } else if (valueType <= FIXMAP_15 || valueType == MAP16) {
+        uint16_t entries = 0;
+        CHECK_ERROR(_readMapSize(c, &entries))
+        value = entries;
+        minimal = valueType == MAP16 ? FIXMAP_15 - FIXMAP_0 + 1 : 0;
+        if (value >= minimal && !(field && value == 0)) {
+            CHECK_ERROR(_verifyCanonicalEntries(c, entries, NULL, NULL))
+        }
+
+    } else if (valueType <= FIXARR_15 || valueType == ARR16) {
+        uint8_t elements = 0;
+        CHECK_ERROR(_readArraySize(c, &elements))
+        value = elements;
+        minimal = valueType == ARR16 ? FIXARR_15 - FIXARR_0 + 1 : 0;
+        if (value >= minimal && !(field && value == 0)) {
+            for (uint8_t i = 0; i < elements; i++) {
+                CHECK_ERROR(_verifyCanonicalValue(c, false))
+            }
+        }
 
-    if (_findKey(c, KEY_XFER_CLOSE) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->asset_xfer.close, sizeof(v->asset_xfer.close)))
-        DISPLAY_ITEM(IDX_XFER_CLOSE, 1, tx_num_items)
+    } else if (valueType <= FIXSTR_31 || valueType == STR8) {
+        const uint8_t *str = NULL;
+        uint8_t strLen = 0;
+        CHECK_ERROR(_readCanonicalKey(c, &str, &strLen))
+        value = strLen;
+
+    } else if (valueType == BOOL_FALSE || valueType == BOOL_TRUE) {
+        c->offset++;
+        value = valueType == BOOL_TRUE;
+
+    } else if (valueType == BIN8 || valueType == BIN16) {
+        uint16_t binLen = 0;
+        CHECK_ERROR(_verifyBin(c, &binLen, UINT16_MAX))
+        value = binLen;
+        minimal = valueType == BIN16 ? 0x100 : 0;
+
+    } else {
+        return parser_unexpected_value;
     }
 
+    if (value < minimal) {
+        c->offset = start;
+        return parser_msgpack_non_minimal_encoding;
+    }
+    if (field && value == 0) {
+        c->offset = start;
+        return parser_msgpack_zero_value;
+    }
     return parser_ok;
 }
 
-static parser_error_t _readTxAssetFreeze(parser_context_t *c, parser_tx_t *v)
+// Walks the transaction map once: checks it is canonical and indexes the transaction keys
+static parser_error_t _verifyCanonicalTx(parser_context_t *c, const schema_map_t *map, schema_index_t *index)
 {
-    tx_num_items = 0;
-    CHECK_ERROR(_findKey(c, KEY_FREEZE_ID))
-    CHECK_ERROR(_readInteger(c, &v->asset_freeze.id))
-    DISPLAY_ITEM(IDX_FREEZE_ASSET_ID, 1, tx_num_items)
-
-    CHECK_ERROR(_findKey(c, KEY_FREEZE_ACCOUNT))
-    CHECK_ERROR(_readBinFixed(c, v->asset_freeze.account, sizeof(v->asset_freeze.account)))
-    DISPLAY_ITEM(IDX_FREEZE_ACCOUNT, 1, tx_num_items)
+    c->offset = 0;
 
-    if (_findKey(c, KEY_FREEZE_FLAG) == parser_ok) {
-        if (_readBool(c, &v->asset_freeze.flag) != parser_ok) {
-            v->asset_freeze.flag = 0x00;
-        }
+    uint16_t entries = 0;
+    CHECK_ERROR(_readMapSize(c, &entries))
+    if (c->buffer[0] == MAP16 && entries <= FIXMAP_15 - FIXMAP_0) {
+        c->offset = 0;
+        return parser_msgpack_non_minimal_encoding;
     }
-    DISPLAY_ITEM(IDX_FREEZE_FLAG, 1, tx_num_items)
-
-    return parser_ok;
+    return _verifyCanonicalEntries(c, entries, map, index);
 }
 
-static parser_error_t _readTxAssetConfig(parser_context_t *c, parser_tx_t *v)
+static parser_error_t _readTxType(parser_context_t *c, parser_tx_t *v, const schema_index_t *index)
 {
-    tx_num_items = 0;
-    if (_findKey(c, KEY_CONFIG_ID) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &v->asset_config.id))
-        DISPLAY_ITEM(IDX_CONFIG_ASSET_ID, 1, tx_num_items)
+    char typeStr[10] = {0};
+    if ((index->present & SCHEMA_KEY_BIT(TX_KEY_TYPE)) == 0) {
+        return parser_no_data;
     }
+    c->offset = index->valueOffset[TX_KEY_TYPE];
+    CHECK_ERROR(_readString(c, (uint8_t*) typeStr, sizeof(typeStr)))
 
-    if (_findKey(c, KEY_CONFIG_PARAMS) == parser_ok) {
-        CHECK_ERROR(_readAssetParams(c, &v->asset_config))
+    // Most common types first
+    if (strncmp(typeStr, KEY_TX_PAY, sizeof(KEY_TX_PAY)) == 0) {
+        v->type = TX_PAYMENT;
+    } else if (strncmp(typeStr, KEY_TX_ASSET_XFER, sizeof(KEY_TX_ASSET_XFER)) == 0) {
+        v->type = TX_ASSET_XFER;
+    } else if (strncmp(typeStr, KEY_TX_KEYREG, sizeof(KEY_TX_KEYREG)) == 0) {
+        v->type = TX_KEYREG;
+    } else if (strncmp(typeStr, KEY_TX_ASSET_FREEZE, sizeof(KEY_TX_ASSET_FREEZE)) == 0) {
+        v->type = TX_ASSET_FREEZE;
+    } else if (strncmp(typeStr, KEY_TX_ASSET_CONFIG, sizeof(KEY_TX_ASSET_CONFIG)) == 0) {
+        v->type = TX_ASSET_CONFIG;
+    } else if (strncmp(typeStr, KEY_TX_APPLICATION, sizeof(KEY_TX_APPLICATION)) == 0) {
+        v->type = TX_APPLICATION;
+    } else {
+        v->type = TX_UNKNOWN;
+        return parser_no_data;
     }
 
     return parser_ok;
 }
 
-static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
+// A genesis ID that contradicts a known genesis hash targets another network
+static parser_error_t _checkNetwork(parser_tx_t *v)
 {
-    tx_num_items = 0;
-    txn_application *application = &v->application;
-    application->num_boxes = 0;
-    application->num_foreign_apps = 0;
-    application->num_foreign_assets = 0;
-    application->num_accounts = 0;
-    application->num_app_args = 0;
-    application->extra_pages = 0;
-    application->oncompletion = NOOPOC;
-    application->aprog_len = 0;
-    application->cprog_len = 0;
-
-    if (_findKey(c, KEY_APP_ID) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &application->id))
+    v->network = algo_network_get(v->genesisHash);
+    if (v->network != NULL && v->genesisID[0] != 0 &&
+        strncmp(v->genesisID, v->network->genesisID, sizeof(v->genesisID)) != 0) {
+        return parser_unexpected_chain;
     }
-    DISPLAY_ITEM(IDX_APP_ID, 1, tx_num_items)
+    return parser_ok;
+}
+
+static parser_error_t _readSchemaFields(parser_context_t *c, const schema_index_t *index, uint8_t *base,
+                                        const schema_map_t *map, uint8_t *numItems);
 
-    if (_findKey(c, KEY_APP_ONCOMPLETION) == parser_ok) {
-        CHECK_ERROR(_readInteger(c, &application->oncompletion))
+// Absent fields hold their zero value. Most are integers or 32-byte addresses and hashes,
+// which are cleared with a constant size so the compiler can expand it inline.
+static void _clearSchemaField(uint8_t *base, const schema_field_t *field)
+{
+    uint8_t *value = base + field->dest;
+    switch (field->kind) {
+        case SCHEMA_UINT64:
+            *(uint64_t*) value = 0;
+            return;
+        case SCHEMA_BYTES:
+            if (field->size == ACCT_SIZE) {
+                memset(value, 0, ACCT_SIZE);
+                return;
+            }
+            break;
+        case SCHEMA_BIN_PTR:
+            memset(base + field->count, 0, sizeof(uint16_t));
+            break;
+        case SCHEMA_UINT64_ARRAY:
+        case SCHEMA_ACCOUNTS:
+        case SCHEMA_APP_ARGS:
+        case SCHEMA_BOXES:
+            base[field->count] = 0;
+            break;
+        default:
+            break;
     }
-    DISPLAY_ITEM(IDX_ON_COMPLETION, 1, tx_num_items)
+    memset(value, 0, field->size);
+}
+
+static parser_error_t _readSchemaValue(parser_context_t *c, uint8_t *base, const schema_field_t *field,
+                                       uint8_t *numItems)
+{
+    uint8_t *value = base + field->dest;
+    uint8_t *count = base + field->count;
+    uint8_t items = 1;
 
-    if (_findKey(c, KEY_APP_BOXES) == parser_ok) {
-        CHECK_ERROR(_readBoxes(c, application->boxes, &application->num_boxes))
-        DISPLAY_ITEM(IDX_BOXES, application->num_boxes, tx_num_items)
+    switch (field->kind) {
+        case SCHEMA_UINT64:
+            CHECK_ERROR(_readInteger(c, (uint64_t*) value))
+            break;
+        case SCHEMA_UINT8: {
+            uint64_t tmp = 0;
+            CHECK_ERROR(_readInteger(c, &tmp))
+            if (tmp > field->max) {
+                return (parser_error_t) field->maxError;
+            }
+            *value = (uint8_t) tmp;
+            break;
+        }
+        case SCHEMA_BOOL:
+            CHECK_ERROR(_readBool(c, value))
+            break;
+        case SCHEMA_BYTES:
+            CHECK_ERROR(_readBinFixed(c, value, field->size))
+            break;
+        case SCHEMA_STRING:
+            CHECK_ERROR(_readString(c, value, field->size))
+            break;
+        case SCHEMA_BIN_LEN:
+            CHECK_ERROR(_readBinSize(c, (uint16_t*) value))
+            if (*(uint16_t*) value > field->max) {
+                return (parser_error_t) field->maxError;
+            }
+            break;
+        case SCHEMA_BIN_PTR:
+            CHECK_ERROR(_getPointerBin(c, (const uint8_t**) value, (uint16_t*) count))
+            break;
+        case SCHEMA_UINT64_ARRAY:
+            CHECK_ERROR(_readArrayU64(c, (uint64_t*) value, count, field->max))
+            items = *count;
+            break;
+        case SCHEMA_ACCOUNTS:
+            CHECK_ERROR(_verifyAccounts(c, count, field->max))
+            items = *count;
+            break;
+        case SCHEMA_APP_ARGS:
+            CHECK_ERROR(_verifyAppArgs(c, (uint16_t*) value, count, field->max))
+            items = *count;
+            break;
+        case SCHEMA_BOXES:
+            CHECK_ERROR(_readBoxes(c, (box*) value, count))
+            items = *count;
+            break;
+        case SCHEMA_STATE_SCHEMA:
+            CHECK_ERROR(_readStateSchema(c, (state_schema*) value))
+            break;
+        case SCHEMA_ASSET_PARAMS: {
+            // A nested map, whose fields display their own items
+            schema_map_t params;
+            schema_index_t paramsIndex;
+            uint16_t entries = 0;
+            parser_schema_asset_params(&params);
+            CHECK_ERROR(_readMapSize(c, &entries))
+            if (entries > field->max) {
+                return (parser_error_t) field->maxError;
+            }
+            CHECK_ERROR(_verifyCanonicalEntries(c, entries, &params, &paramsIndex))
+            CHECK_ERROR(_readSchemaFields(c, &paramsIndex, value, &params, numItems))
+            break;
+        }
+        default:
+            return parser_unexpected_type;
     }
 
-    if (_findKey(c, KEY_APP_FOREIGN_APPS) == parser_ok) {
-        CHECK_ERROR(_readArrayU64(c, application->foreign_apps, &application->num_foreign_apps, MAX_FOREIGN_APPS))
-        DISPLAY_ITEM(IDX_FOREIGN_APP, application->num_foreign_apps, tx_num_items)
+    if (field->displayIdx != SCHEMA_HIDDEN) {
+        DISPLAY_ITEM(field->displayIdx, items, (*numItems))
     }
+    return parser_ok;
+}
 
-    if (_findKey(c, KEY_APP_FOREIGN_ASSETS) == parser_ok) {
-        CHECK_ERROR(_readArrayU64(c, application->foreign_assets, &application->num_foreign_assets, MAX_FOREIGN_ASSETS))
-        DISPLAY_ITEM(IDX_FOREIGN_ASSET, application->num_foreign_assets, tx_num_items)
+// Decodes the fields of a map from the value offsets recorded by the canonical walk, and
+// lists the display items in the order of the schema
+static parser_error_t _readSchemaFields(parser_context_t *c, const schema_index_t *index, uint8_t *base,
+                                        const schema_map_t *map, uint8_t *numItems)
+{
+    bool previousPresent = false;
+
+    for (uint8_t i = 0; i < map->fieldCount; i++) {
+        const schema_field_t *field = &map->fields[i];
+        const bool withPrevious = (field->flags & SCHEMA_WITH_PREVIOUS) != 0;
+
+        if (withPrevious && !previousPresent) {
+            _clearSchemaField(base, field);
+            continue;
+        }
+
+        previousPresent = (index->present & SCHEMA_KEY_BIT(field->key)) != 0;
+        if (!previousPresent) {
+            if (withPrevious || (field->flags & SCHEMA_REQUIRED) != 0) {
+                return parser_no_data;
+            }
+            _clearSchemaField(base, field);
+            if ((field->flags & SCHEMA_SHOW_DEFAULT) != 0) {
+                DISPLAY_ITEM(field->displayIdx, 1, (*numItems))
+            }
+            continue;
+        }
+
+        c->offset = index->valueOffset[field->key];
+        CHECK_ERROR(_readSchemaValue(c, base, field, numItems))
     }
+    return parser_ok;
+}
 
-    if (_findKey(c, KEY_APP_ACCOUNTS) == parser_ok) {
-        CHECK_ERROR(_verifyAccounts(c, &application->num_accounts, MAX_ACCT))
-        DISPLAY_ITEM(IDX_ACCOUNTS, application->num_accounts, tx_num_items)
+// Limits that span several fields
+static parser_error_t _checkTxFields(const parser_tx_t *v)
+{
+    if (v->type != TX_APPLICATION) {
+        return parser_ok;
     }
 
+    const txn_application *application = &v->application;
     if(application->num_accounts + application->num_foreign_apps + application->num_foreign_assets > ACCT_FOREIGN_LIMIT) {
         return parser_unexpected_number_items;
     }
 
-    if (_findKey(c, KEY_APP_ARGS) == parser_ok) {
-        CHECK_ERROR(_verifyAppArgs(c, application->app_args_len, &application->num_app_args, MAX_ARG))
-        DISPLAY_ITEM(IDX_APP_ARGS, application->num_app_args, tx_num_items)
-    }
-
     uint16_t app_args_total_len = 0;
     for(uint8_t i = 0; i< application->num_app_args; i++) {
         app_args_total_len += application->app_args_len[i];
@@ -1225,34 +1240,6 @@ static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
         }
     }
 
-    if (_findKey(c, KEY_APP_GLOBAL_SCHEMA) == parser_ok) {
-        CHECK_ERROR(_readStateSchema(c, &application->global_schema))
-        DISPLAY_ITEM(IDX_GLOBAL_SCHEMA, 1, tx_num_items)
-    }
-
-    if (_findKey(c, KEY_APP_LOCAL_SCHEMA) == parser_ok) {
-        CHECK_ERROR(_readStateSchema(c, &application->local_schema))
-        DISPLAY_ITEM(IDX_LOCAL_SCHEMA, 1, tx_num_items)
-    }
-
-    if (_findKey(c, KEY_APP_EXTRA_PAGES) == parser_ok) {
-        CHECK_ERROR(_readUInt8(c, &application->extra_pages))
-        if (application->extra_pages > 3){
-            return parser_too_many_extra_pages;
-        }
-        DISPLAY_ITEM(IDX_EXTRA_PAGES, 1, tx_num_items)
-    }
-
-    if (_findKey(c, KEY_APP_APROG_LEN) == parser_ok) {
-        CHECK_ERROR(_getPointerBin(c, &application->aprog, &application->aprog_len))
-        DISPLAY_ITEM(IDX_APPROVE, 1, tx_num_items)
-    }
-
-   if (_findKey(c, KEY_APP_CPROG_LEN) == parser_ok) {
-       CHECK_ERROR(_getPointerBin(c, &application->cprog, &application->cprog_len))
-       DISPLAY_ITEM(IDX_CLEAR, 1, tx_num_items)
-   }
-
     if (application->id == 0 && application->cprog_len + application->aprog_len > PAGE_LEN *(1+application->extra_pages)){
         // ExtraPages needs to be checked only on application creation
         return parser_program_fields_too_long;
@@ -1271,36 +1258,27 @@ parser_error_t _read(parser_context_t *c, parser_tx_t *v)
         return parser_unexpected_number_items;
     }
 
+    // Every field is decoded from the single walk over the map, as its schema describes it
+    schema_map_t map;
+    schema_index_t index;
+    parser_schema_common(&map);
+    CHECK_ERROR(_verifyCanonicalTx(c, &map, &index))
+
     // Read Tx type
-    CHECK_ERROR(_readTxType(c, v))
+    CHECK_ERROR(_readTxType(c, v, &index))
 
     // Read common params
-    CHECK_ERROR(_readTxCommonParams(c, v));
+    common_num_items = 0;
+    CHECK_ERROR(_readSchemaFields(c, &index, (uint8_t*) v, &map, &common_num_items))
+    CHECK_ERROR(_checkNetwork(v))
 
     // Read Tx specifics params
-    switch (v->type) {
-    case TX_PAYMENT:
-        CHECK_ERROR(_readTxPayment(c, v))
-        break;
-    case TX_KEYREG:
-        CHECK_ERROR(_readTxKeyreg(c, v))
-        break;
-    case TX_ASSET_XFER:
-        CHECK_ERROR(_readTxAssetXfer(c, v))
-        break;
-    case TX_ASSET_FREEZE:
-        CHECK_ERROR(_readTxAssetFreeze(c, v))
-        break;
-    case TX_ASSET_CONFIG:
-        CHECK_ERROR(_readTxAssetConfig(c, v))
-        break;
-    case TX_APPLICATION:
-        CHECK_ERROR(_readTxApplication(c, v))
-        break;
-    default:
+    if (!parser_schema_tx(v->type, &map)) {
         return parser_unknown_transaction;
-        break;
     }
+    tx_num_items = 0;
+    CHECK_ERROR(_readSchemaFields(c, &index, (uint8_t*) v, &map, &tx_num_items))
+    CHECK_ERROR(_checkTxFields(v))
 
     num_items = common_num_items + tx_num_items + 1;
     return parser_ok;
@@ -1337,6 +1315,54 @@ parser_error_t _read_arbitrary_data(parser_context_t *c, parser_arbitrary_data_t
     CHECK_ERROR(_readDomain(c, v))
     CHECK_ERROR(_readRequestId(c, v))
     CHECK_ERROR(_readAuthData(c, v))
+
+    return parser_ok;
+}
+
+// Signer, scope, encoding and domain are shared; each item carries its own data, request ID
+// and authenticated data, checked exactly as a single INS_SIGN_DATA payload would be
+parser_error_t _read_arbitrary_batch(parser_context_t *c, parser_arbitrary_batch_t *v)
+{
+    parser_arbitrary_data_t item;
+    MEMZERO(&item, sizeof(item));
+
+    #if !defined(LEDGER_SPECIFIC)
+    CHECK_ERROR(_readSerializedHdPath(c, &item))
+    #endif
+    CHECK_ERROR(_readSigner(c, &item))
+    CHECK_ERROR(_readScope(c))
+    CHECK_ERROR(_readEncoding(c))
+    CHECK_ERROR(_readDomain(c, &item))
+    CHECK_ERROR(_readUInt8(c, &v->itemCount))
+
+    if (v->itemCount == 0 || v->itemCount > ARBITRARY_BATCH_MAX_ITEMS) {
+        return parser_unexpected_number_items;
+    }
+
+    v->signerBuffer = item.signerBuffer;
+    v->domainBuffer = item.domainBuffer;
+    v->domainLen = item.domainLen;
+
+    for (uint8_t i = 0; i < v->itemCount; i++) {
+        CHECK_ERROR(_readData(c, &item))
+        CHECK_ERROR(_readRequestId(c, &item))
+        CHECK_ERROR(_readAuthData(c, &item))
+
+        v->items[i].dataBuffer = item.dataBuffer;
+        v->items[i].dataLen = item.dataLen;
+        v->items[i].requestIdBuffer = item.requestIdLen != 0 ? item.requestIdBuffer : NULL;
+        v->items[i].requestIdLen = item.requestIdLen;
+        v->items[i].authDataBuffer = item.authDataBuffer;
+        v->items[i].authDataLen = item.authDataLen;
+        MEMCPY(v->items[i].dataDigest, item.dataDigest, sizeof(item.dataDigest));
+        MEMCPY(v->items[i].authDataDigest, item.authDataDigest, sizeof(item.authDataDigest));
+    }
+
+    if (c->offset != c->bufferLen) {
+        return parser_unexpected_characters;
+    }
+
+    num_items = ARBITRARY_BATCH_NUM_ITEMS;
     return parser_ok;
 }
 
@@ -1346,22 +1372,10 @@ static parser_error_t _readSigner(parser_context_t *c, parser_arbitrary_data_t *
 
     
     uint8_t raw_pubkey[PK_LEN_25519];
-    #if defined(LEDGER_SPECIFIC)
     zxerr_t err = crypto_extractPublicKey(raw_pubkey, PK_LEN_25519);
     if (err != zxerr_ok) {
         return parser_invalid_signer;
     }
-    #else
-    // in cpp_test we cannot compute the pubkey from the hdPath
-    const char *pubkeyAcc0 = "1eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8";
-    const char *pubkeyAcc123 = "0dfdbcdb8eebed628cfb4ef70207b86fd0deddca78e90e8c59d6f441e383b377";
-
-    if (hdPath[2] == (HDPATH_2_DEFAULT | 0x00000000)) {
-        hexstr_to_array(raw_pubkey, PK_LEN_25519, pubkeyAcc0, strlen(pubkeyAcc0));
-    } else {
-        hexstr_to_array(raw_pubkey, PK_LEN_25519, pubkeyAcc123, strlen(pubkeyAcc123));
-    }
-    #endif
 
     if (memcmp(raw_pubkey, v->signerBuffer, PK_LEN_25519) != 0) {
         return parser_invalid_signer;
@@ -1410,6 +1424,11 @@ static parser_error_t _readData(parser_context_t *c, parser_arbitrary_data_t *v)
 
     CHECK_ERROR(parser_json_check_canonical((const char*)v->dataBuffer, v->dataLen))
 
+    // Signing after approval only needs the digest
+    if (crypto_sha256(v->dataBuffer, v->dataLen, v->dataDigest, SHA256_DIGEST_SIZE) != zxerr_ok) {
+        return parser_unexpected_error;
+    }
+
     return parser_ok;
 }
 
@@ -1424,15 +1443,17 @@ static parser_error_t _readDomain(parser_context_t *c, parser_arbitrary_data_t *
     }
 
     v->domainBuffer = c->buffer + c->offset;
+    CTX_CHECK_AND_ADVANCE(c, domainLen)
 
-    for (uint32_t i = 0; i < domainLen; i++) {
-        // Check for representable ASCII (32-126)
-        if (v->domainBuffer[i] < 32 || v->domainBuffer[i] > 126) {
-            return parser_invalid_domain;
-        }
+    // Check for representable ASCII (32-126)
+    if (!bytes_printable(v->domainBuffer, domainLen)) {
+        return parser_invalid_domain;
     }
 
-    CTX_CHECK_AND_ADVANCE(c, domainLen)
+    // Every authData starts with this digest, batches share it across their challenges
+    if (crypto_sha256(v->domainBuffer, domainLen, v->domainDigest, SHA256_DIGEST_SIZE) != zxerr_ok) {
+        return parser_unexpected_error;
+    }
 
     num_items++;
 
@@ -1453,11 +1474,6 @@ static parser_error_t _readRequestId(parser_context_t *c, parser_arbitrary_data_
     // RequestId is optional
     if (requestIdLen != 0) {
         v->requestIdBuffer = c->buffer + c->offset;
-        char base64ReqId[BASE64_REQUEST_ID_MAX_LEN] = {0};
-        // Check it can be encoded as base64
-        if (base64_encode(base64ReqId, (uint16_t)sizeof(base64ReqId), v->requestIdBuffer, v->requestIdLen) == 0) {
-            return parser_invalid_request_id;
-        }
         CTX_CHECK_AND_ADVANCE(c, requestIdLen)
         num_items++;
     }
@@ -1465,24 +1481,56 @@ static parser_error_t _readRequestId(parser_context_t *c, parser_arbitrary_data_
     return parser_ok;
 }
 
+static parser_error_t _readCredentialPublicKey(cbor_reader_t *reader)
+{
+    credential_public_key_t key;
+    MEMZERO(&key, sizeof(credential_public_key_t));
+
+    uint64_t entries = 0;
+    CHECK_ERROR(cbor_read_container(reader, CBOR_MAJOR_MAP, &entries))
+    for (uint64_t i = 0; i < entries; i++) {
+        CHECK_ERROR(checkCredentialPublicKeyItem(reader, &key))
+    }
+
+    if (!key.found_alg) {
+        return parser_failed_domain_auth;
+    }
+    return parser_ok;
+}
+
+static parser_error_t _readExtensions(cbor_reader_t *reader)
+{
+    uint64_t entries = 0;
+    CHECK_ERROR(cbor_read_container(reader, CBOR_MAJOR_MAP, &entries))
+    for (uint64_t i = 0; i < entries; i++) {
+        CHECK_ERROR(checkExtensionsItem(reader))
+    }
+    return parser_ok;
+}
+
 static parser_error_t _readAuthData(parser_context_t *c, parser_arbitrary_data_t *v)
 {
-    size_t authDataLen = 0;
-    CHECK_ERROR(_readUInt16(c, (uint16_t*)&authDataLen))
-    uint32_t startOffset = c->offset;
-    v->authDataLen = (uint16_t)authDataLen;
+    uint16_t authDataLen = 0;
+    CHECK_ERROR(_readUInt16(c, &authDataLen))
+    const uint32_t startOffset = c->offset;
+    v->authDataLen = authDataLen;
 
     if (authDataLen == 0) {
         return parser_missing_authenticated_data;
     }
+    CTX_CHECK_AVAIL(c, authDataLen)
 
     v->authDataBuffer = c->buffer + c->offset;
+    const uint8_t *authDataEnd = v->authDataBuffer + authDataLen;
 
-    // authData first 32 bytes should be the sha256 of the domain
-    uint8_t domainHash[SHA256_DIGEST_SIZE];
-    crypto_sha256(v->domainBuffer, v->domainLen, domainHash, SHA256_DIGEST_SIZE);
+    // Signing after approval only needs the digest, which is only used once all of authData
+    // has been checked below
+    if (crypto_sha256(v->authDataBuffer, authDataLen, v->authDataDigest, SHA256_DIGEST_SIZE) != zxerr_ok) {
+        return parser_unexpected_error;
+    }
 
-    if (memcmp(domainHash, v->authDataBuffer, SHA256_DIGEST_SIZE) != 0) {
+    // authData first 32 bytes should be the sha256 of the domain
+    if (authDataLen < SHA256_DIGEST_SIZE || memcmp(v->domainDigest, v->authDataBuffer, SHA256_DIGEST_SIZE) != 0) {
         return parser_failed_domain_auth;
     }
 
@@ -1504,259 +1552,239 @@ static parser_error_t _readAuthData(parser_context_t *c, parser_arbitrary_data_t
     uint32_t signCount;
     CHECK_ERROR(_readUInt32(c, &signCount))
 
-    cbor_parser_t parser;
-    cbor_value_t value;
-
     if (flags.at) {
-        // read AAGUID
-        uint8_t aaguid[AAGUID_LEN];
-        CHECK_ERROR(_readBytes(c, aaguid, AAGUID_LEN))
+        // skip AAGUID
+        CTX_CHECK_AND_ADVANCE(c, AAGUID_LEN)
 
-        // read credentialIdLength
+        // skip credentialId
         uint16_t credentialIdLen;
         CHECK_ERROR(_readUInt16(c, &credentialIdLen))
+        CTX_CHECK_AND_ADVANCE(c, credentialIdLen)
+    }
 
-        // read credentialId
-        uint8_t credentialId[400];
-        CHECK_ERROR(_readBytes(c, credentialId, credentialIdLen))
-
-        parser_init_cbor(&parser, &value, c->buffer + c->offset, authDataLen);
-
-        // read credentialPublicKey
-        MEMZERO(&credential_public_key, sizeof(credential_public_key_t));
-        CHECK_ERROR(parser_traverse_map_entries(&value, checkCredentialPublicKeyItem))
-
-        if (!credential_public_key.found_alg) {
-            return parser_failed_domain_auth;
-        }
-        
-        const uint8_t *next_byte = cbor_value_get_next_byte(&value);
-        size_t bytesConsumed = 0;
+    if (c->buffer + c->offset > authDataEnd) {
+        return parser_failed_domain_auth;
+    }
 
-        if (next_byte < (c->buffer + c->offset)) {
-            return parser_failed_domain_auth;
-        }
+    // The CBOR items can only span what is left of authData
+    cbor_reader_t reader;
+    cbor_reader_init(&reader, c->buffer + c->offset, authDataEnd - (c->buffer + c->offset));
 
-        bytesConsumed = next_byte - (c->buffer + c->offset);
-            
-        // Advance the parser as many bytes as were consumed by the CBOR parser
-        CTX_CHECK_AND_ADVANCE(c, bytesConsumed)
+    if (flags.at) {
+        CHECK_ERROR(_readCredentialPublicKey(&reader))
     }
 
     if (flags.ed) {
-        parser_init_cbor(&parser, &value, c->buffer + c->offset, authDataLen);
-        // read extensions
-        CHECK_ERROR(parser_traverse_map_entries(&value, checkExtensionsItem))
-
-        const uint8_t *next_byte = cbor_value_get_next_byte(&value);
-        size_t bytesConsumed = 0;
-        
-        if (next_byte < (c->buffer + c->offset)) {
-            return parser_failed_domain_auth;
-        }
-
-        bytesConsumed = next_byte - (c->buffer + c->offset);
-            
-        // Advance the parser as many bytes as were consumed by the CBOR parser
-        CTX_CHECK_AND_ADVANCE(c, bytesConsumed)
+        CHECK_ERROR(_readExtensions(&reader))
     }
 
-    if (startOffset + authDataLen != c->offset) {
+    if (reader.ptr != authDataEnd) {
         return parser_failed_domain_auth;
     }
+    c->offset = startOffset + authDataLen;
 
     num_items++;
 
     return parser_ok;
 }
 
-static parser_error_t checkCredentialPublicKeyItem(cbor_value_t *key, cbor_value_t *value) {
-    if (cbor_value_is_integer(key)) {
-        int keyValue = 0;
-        CHECK_ERROR(cbor_value_get_int(key, &keyValue))
-        
-        if (keyValue == KEY_VALUE_CRV) {
-            int valueValue = 0;
-            if (cbor_value_is_text_string(value) || cbor_value_is_byte_string(value)) {
-                // Valid value, but it won't be used
-                credential_public_key.found_crv = true;
-                return parser_ok;
-            }
-            if (cbor_value_is_integer(value)) {
-                CHECK_ERROR(cbor_value_get_int(value, &valueValue))
-                credential_public_key.crv = valueValue;
-                credential_public_key.found_crv = true;
-            } else {
-                return parser_failed_domain_auth;
-            }
+static parser_error_t checkCredentialPublicKeyItem(cbor_reader_t *reader, credential_public_key_t *key) {
+    uint8_t major = 0;
+    CHECK_ERROR(cbor_peek_type(reader, &major))
+    if (major != CBOR_MAJOR_UINT && major != CBOR_MAJOR_NINT) {
+        // Only integer labels are checked, skip the label and its value
+        CHECK_ERROR(cbor_skip_item(reader))
+        return cbor_skip_item(reader);
+    }
+
+    int64_t keyValue = 0;
+    CHECK_ERROR(cbor_read_int(reader, &keyValue))
+    CHECK_ERROR(cbor_peek_type(reader, &major))
+    const bool isInteger = major == CBOR_MAJOR_UINT || major == CBOR_MAJOR_NINT;
+
+    if (keyValue == KEY_VALUE_CRV) {
+        if (major == CBOR_MAJOR_TEXT || major == CBOR_MAJOR_BYTES) {
+            // Valid value, but it won't be used
+            key->found_crv = true;
+            return cbor_skip_item(reader);
         }
+        if (!isInteger) {
+            return parser_failed_domain_auth;
+        }
+        CHECK_ERROR(cbor_read_int(reader, &key->crv))
+        key->found_crv = true;
+        return parser_ok;
+    }
 
-        // Key is "kty"
-        else if (keyValue == KEY_VALUE_KTY) {
-            int valueValue = 0;
-            if (cbor_value_is_integer(value)) {
-                CHECK_ERROR(cbor_value_get_int(value, &valueValue))
-            } else {
-                return parser_failed_domain_auth;
-            }
-
-            credential_public_key.kty = valueValue;
+    // Key is "kty"
+    if (keyValue == KEY_VALUE_KTY) {
+        if (!isInteger) {
+            return parser_failed_domain_auth;
         }
+        return cbor_read_int(reader, &key->kty);
+    }
 
-        // Check if key is "alg" (COSE key 3), which is mandatory for FIDO2
-        else if (keyValue == KEY_VALUE_ALG) {
-            int valueValue = 0;
-            if (cbor_value_is_integer(value)) {
-                CHECK_ERROR(cbor_value_get_int(value, &valueValue))
-            }
-            // Check if the algorithm value is a valid CoseAlgorithm_e
-            switch (valueValue) {
-                case UNASSIGNED_MINUS_65536:
-                case RS1:
-                case A128CTR:
-                case A192CTR:
-                case A256CTR:
-                case A128CBC:
-                case A192CBC:
-                case A256CBC:
-                case KT256:
-                case KT128:
-                case TURBOSHAKE256:
-                case TURBOSHAKE128:
-                case WALNUTDSA:
-                case RS512:
-                case RS384:
-                case RS256:
-                case ML_DSA_87:
-                case ML_DSA_65:
-                case ML_DSA_44:
-                case ES256K:
-                case HSS_LMS:
-                case SHAKE256:
-                case SHA_512:
-                case SHA_384:
-                case RSAES_OAEP_W_SHA_512:
-                case RSAES_OAEP_W_SHA_256:
-                case RSAES_OAEP_W_RFC_8017_DEFAULT_PARAMETERS:
-                case PS512:
-                case PS384:
-                case PS256:
-                case ECDH_SS_A256KW:
-                case ECDH_SS_A192KW:
-                case ECDH_SS_A128KW:
-                case ECDH_ES_A256KW:
-                case ECDH_ES_A192KW:
-                case ECDH_ES_A128KW:
-                case ECDH_SS_HKDF_512:
-                case ECDH_SS_HKDF_256:
-                case ECDH_ES_HKDF_512:
-                case ECDH_ES_HKDF_256:
-                case SHAKE128:
-                case SHA_512_256:
-                case SHA_256:
-                case SHA_256_64:
-                case SHA_1:
-                case DIRECT_HKDF_AES_256:
-                case DIRECT_HKDF_AES_128:
-                case DIRECT_HKDF_SHA_512:
-                case DIRECT_HKDF_SHA_256:
-                case DIRECT:
-                case A256KW:
-                case A192KW:
-                case A128KW:
-                case A128GCM:
-                case A192GCM:
-                case A256GCM:
-                case HMAC_256_64:
-                case HMAC_256_256:
-                case HMAC_384_384:
-                case HMAC_512_512:
-                case AES_CCM_16_64_128:
-                case AES_CCM_16_64_256:
-                case AES_CCM_64_64_128:
-                case AES_CCM_64_64_256:
-                case AES_MAC_128_64:
-                case AES_MAC_256_64:
-                case CHACHA20_POLY1305:
-                case AES_MAC_128_128:
-                case AES_MAC_256_128:
-                case AES_CCM_16_128_128:
-                case AES_CCM_16_128_256:
-                case AES_CCM_64_128_128:
-                case AES_CCM_64_128_256:
-                case IV_GENERATION:
-                    credential_public_key.found_alg = true;
-                    credential_public_key.alg = valueValue;
-                    break;
-                case ES256:
-                case ES384:
-                case ES512:
-                    // Value of "kty" must be "2" (EC2)
-                    // RFC8152 - Section 8.1 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.1
-                    if (credential_public_key.kty != 2) {
-                        return parser_failed_domain_auth;
-                    }
-                    credential_public_key.found_alg = true;
-                    credential_public_key.alg = valueValue;
-                    break;
-                case EDDSA:
-                    // Value of "kty" must be "1" (OKP)
-                    // RFC8152 - Section 8.2 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.2
-                    if (credential_public_key.kty != 1) {
-                        return parser_failed_domain_auth;
-                    }
-                    // Value of "crv" must be a valid curve (Table 22 )
-                    // RFC8152 - Section 8.2 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.2
-                    if (!credential_public_key.found_crv) {
-                        return parser_failed_domain_auth;
-                    }
-                    if (credential_public_key.crv != CRV_ED25519 && credential_public_key.crv != CRV_ED448) {
-                        return parser_failed_domain_auth;
-                    }
-                    credential_public_key.found_alg = true;
-                    credential_public_key.alg = valueValue;
+    // Check if key is "alg" (COSE key 3), which is mandatory for FIDO2
+    if (keyValue == KEY_VALUE_ALG) {
+        // Values other than integers are not valid algorithms
+        if (!isInteger) {
+            return parser_failed_domain_auth;
+        }
+        int64_t valueValue = 0;
+        CHECK_ERROR(cbor_read_int(reader, &valueValue))
+
+        // Check if the algorithm value is a valid CoseAlgorithm_e
+        switch (valueValue) {
+            case UNASSIGNED_MINUS_65536:
+            case RS1:
+            case A128CTR:
+            case A192CTR:
+            case A256CTR:
+            case A128CBC:
+            case A192CBC:
+            case A256CBC:
+            case KT256:
+            case KT128:
+            case TURBOSHAKE256:
+            case TURBOSHAKE128:
+            case WALNUTDSA:
+            case RS512:
+            case RS384:
+            case RS256:
+            case ML_DSA_87:
+            case ML_DSA_65:
+            case ML_DSA_44:
+            case ES256K:
+            case HSS_LMS:
+            case SHAKE256:
+            case SHA_512:
+            case SHA_384:
+            case RSAES_OAEP_W_SHA_512:
+            case RSAES_OAEP_W_SHA_256:
+            case RSAES_OAEP_W_RFC_8017_DEFAULT_PARAMETERS:
+            case PS512:
+            case PS384:
+            case PS256:
+            case ECDH_SS_A256KW:
+            case ECDH_SS_A192KW:
+            case ECDH_SS_A128KW:
+            case ECDH_ES_A256KW:
+            case ECDH_ES_A192KW:
+            case ECDH_ES_A128KW:
+            case ECDH_SS_HKDF_512:
+            case ECDH_SS_HKDF_256:
+            case ECDH_ES_HKDF_512:
+            case ECDH_ES_HKDF_256:
+            case SHAKE128:
+            case SHA_512_256:
+            case SHA_256:
+            case SHA_256_64:
+            case SHA_1:
+            case DIRECT_HKDF_AES_256:
+            case DIRECT_HKDF_AES_128:
+            case DIRECT_HKDF_SHA_512:
+            case DIRECT_HKDF_SHA_256:
+            case DIRECT:
+            case A256KW:
+            case A192KW:
+            case A128KW:
+            case A128GCM:
+            case A192GCM:
+            case A256GCM:
+            case HMAC_256_64:
+            case HMAC_256_256:
+            case HMAC_384_384:
+            case HMAC_512_512:
+            case AES_CCM_16_64_128:
+            case AES_CCM_16_64_256:
+            case AES_CCM_64_64_128:
+            case AES_CCM_64_64_256:
+            case AES_MAC_128_64:
+            case AES_MAC_256_64:
+            case CHACHA20_POLY1305:
+            case AES_MAC_128_128:
+            case AES_MAC_256_128:
+            case AES_CCM_16_128_128:
+            case AES_CCM_16_128_256:
+            case AES_CCM_64_128_128:
+            case AES_CCM_64_128_256:
+            case IV_GENERATION:
+                key->found_alg = true;
+                key->alg = valueValue;
                 break;
-                default:
+            case ES256:
+            case ES384:
+            case ES512:
+                // Value of "kty" must be "2" (EC2)
+                // RFC8152 - Section 8.1 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.1
+                if (key->kty != 2) {
                     return parser_failed_domain_auth;
-            }
-        }
-    
-        // Key is "key_ops"
-        else if (keyValue == KEY_VALUE_KEY_OPS) {
-            // Value is an array and must contain "sign" and "verify" when using ECDSA
-            // RFC8152 - Section 8.1 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.1
-            if (credential_public_key.alg == ES256 || credential_public_key.alg == ES384 || credential_public_key.alg == ES512 || credential_public_key.alg == EDDSA) {
-                int values[30];
-                size_t count = 0;
-                bool found_sign = false;
-                bool found_verify = false;
-
-                CHECK_ERROR(read_int_array(value, values, &count))
-
-                // "key_ops" values explained in https://datatracker.ietf.org/doc/html/rfc8152#section-7.1 Table 4
-                for (size_t i = 0; i < count; i++) {
-                    if (values[i] == INT_VAULE_SIGN) {
-                        found_sign = true;
-                    } else if (values[i] == INT_VAULE_VERIFY) {
-                        found_verify = true;
-                    }
                 }
-
-                if (!found_sign || !found_verify) {
+                key->found_alg = true;
+                key->alg = valueValue;
+                break;
+            case EDDSA:
+                // Value of "kty" must be "1" (OKP)
+                // RFC8152 - Section 8.2 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.2
+                if (key->kty != 1) {
+                    return parser_failed_domain_auth;
+                }
+                // Value of "crv" must be a valid curve (Table 22 )
+                // RFC8152 - Section 8.2 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.2
+                if (!key->found_crv) {
                     return parser_failed_domain_auth;
                 }
+                if (key->crv != CRV_ED25519 && key->crv != CRV_ED448) {
+                    return parser_failed_domain_auth;
+                }
+                key->found_alg = true;
+                key->alg = valueValue;
+                break;
+            default:
+                return parser_failed_domain_auth;
+        }
+        return parser_ok;
+    }
+
+    // Key is "key_ops"
+    // Value is an array and must contain "sign" and "verify" when using ECDSA
+    // RFC8152 - Section 8.1 : https://datatracker.ietf.org/doc/html/rfc8152#section-8.1
+    if (keyValue == KEY_VALUE_KEY_OPS &&
+        (key->alg == ES256 || key->alg == ES384 || key->alg == ES512 || key->alg == EDDSA)) {
+        uint64_t count = 0;
+        bool found_sign = false;
+        bool found_verify = false;
+
+        CHECK_ERROR(cbor_read_container(reader, CBOR_MAJOR_ARRAY, &count))
+
+        // "key_ops" values explained in https://datatracker.ietf.org/doc/html/rfc8152#section-7.1 Table 4
+        for (uint64_t i = 0; i < count; i++) {
+            int64_t op = 0;
+            CHECK_ERROR(cbor_read_int(reader, &op))
+            if (op == INT_VAULE_SIGN) {
+                found_sign = true;
+            } else if (op == INT_VAULE_VERIFY) {
+                found_verify = true;
             }
         }
+
+        if (!found_sign || !found_verify) {
+            return parser_failed_domain_auth;
+        }
+        return parser_ok;
     }
 
-    return parser_ok;
+    return cbor_skip_item(reader);
 }
 
-static parser_error_t checkExtensionsItem(cbor_value_t *key, __Z_UNUSED cbor_value_t *value) {
-    if (key->type != CborTextStringType) {
+static parser_error_t checkExtensionsItem(cbor_reader_t *reader) {
+    uint8_t major = 0;
+    CHECK_ERROR(cbor_peek_type(reader, &major))
+    if (major != CBOR_MAJOR_TEXT) {
         return parser_failed_domain_auth;
     }
-    return parser_ok;
+    CHECK_ERROR(cbor_skip_item(reader))
+    return cbor_skip_item(reader);
 }
 
 uint8_t _getNumItems()
@@ -1913,6 +1941,14 @@ const char *parser_getErrorDescription(parser_error_t err) {
             return "CBOR map entry error";
         case parser_cbor_error_unexpected:
             return "CBOR unexpected error";
+        case parser_invalid_group:
+            return "Invalid group";
+        case parser_msgpack_unsorted_keys:
+            return "Unsorted or duplicated keys";
+        case parser_msgpack_non_minimal_encoding:
+            return "Non-minimal encoding";
+        case parser_msgpack_zero_value:
+            return "Field holds its default value";
         default:
             return "Unrecognized error code";
     }
@@ -1963,31 +1999,9 @@ parser_error_t parser_jsonGetNthKey(parser_context_t *ctx, uint8_t displayIdx, c
     return parser_ok;
 }
 
-parser_error_t parser_jsonGetNthValue(parser_context_t *ctx, uint8_t displayIdx, char *outVal, uint16_t outValLen) {
+parser_error_t parser_jsonGetNthValue(parser_context_t *ctx, uint8_t displayIdx, const char **value, uint16_t *valueLen) {
     uint16_t token_index = 0;
     CHECK_ERROR(parser_json_object_get_nth_value(0, displayIdx, &token_index));
-    CHECK_ERROR(parser_getJsonItemFromTokenIndex((const char*)ctx->parser_arbitrary_data_obj->dataBuffer, token_index, outVal, outValLen));
-
-    // Remove backslashes from JSON string values
-    // This is needed because we don't want to display backslashes in the UI
-    uint16_t writePos = 0;
-    uint16_t readPos = 0;
-    uint16_t currentLen = strlen(outVal);
-    
-    while (readPos < currentLen) {
-        if (outVal[readPos] == '\\') {
-            // Skip the backslash
-            readPos++;
-        } else {
-            // Copy character if not a backslash
-            outVal[writePos] = outVal[readPos];
-            writePos++;
-            readPos++;
-        }
-    }
-    
-    // Add null terminator at the new end of string
-    outVal[writePos] = '\0';
-
+    CHECK_ERROR(parser_getJsonTokenSpan((const char*)ctx->parser_arbitrary_data_obj->dataBuffer, token_index, value, valueLen));
     return parser_ok;
 }
@@ -64,12 +64,14 @@ uint8_t _getNumJsonItems();
 
 parser_error_t _read(parser_context_t *c, parser_tx_t *v);
 parser_error_t _read_arbitrary_data(parser_context_t *c, parser_arbitrary_data_t *v);
+parser_error_t _read_arbitrary_batch(parser_context_t *c, parser_arbitrary_batch_t *v);
 parser_error_t _readMapSize(parser_context_t *c, uint16_t *mapItems);
 parser_error_t _readArraySize(parser_context_t *c, uint8_t *mapItems);
 parser_error_t _readString(parser_context_t *c, uint8_t *buff, uint16_t buffLen);
 parser_error_t _readInteger(parser_context_t *c, uint64_t* value);
 parser_error_t _readBool(parser_context_t *c, uint8_t *value);
 parser_error_t _readBinFixed(parser_context_t *c, uint8_t *buff, uint16_t bufferLen);
+parser_error_t _findKeyRange(parser_context_t *c, const char *key, uint16_t *start, uint16_t *end);
 
 parser_error_t _getAccount(parser_context_t *c, uint8_t* account, uint8_t account_idx, uint8_t num_accounts);
 parser_error_t _getAppArg(parser_context_t *c, uint8_t **args, uint16_t* args_len, uint8_t args_idx, uint16_t max_args_len, uint8_t max_array_len);
@@ -80,9 +82,9 @@ DEF_READFIX_UNSIGNED(32);
 DEF_READFIX_UNSIGNED(64);
 
 typedef struct {
-    uint8_t kty;
-    int alg;
-    uint8_t crv;
+    int64_t kty;
+    int64_t alg;
+    int64_t crv;
     bool found_alg;
     bool found_crv;
 } credential_public_key_t;
@@ -0,0 +1,199 @@
+/*******************************************************************************
+*  (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "parser_schema.h"
+#include "parser_common.h"
+
+#define ARRAY_SIZE(__arr)   (sizeof(__arr) / sizeof(__arr[0]))
+
+#define MAX_PARAM_SIZE      12
+
+#define KEY(__key)          {__key, sizeof(__key) - 1}
+
+#define AT(__struct, __member)      offsetof(__struct, __member)
+#define SIZE(__struct, __member)    sizeof(((__struct *) 0)->__member)
+
+// A value stored in the member, as large as the member
+#define FIELD(__key, __kind, __flags, __idx, __struct, __member) \
+    {__key, __kind, __flags, __idx, AT(__struct, __member), 0, SIZE(__struct, __member), 0, parser_ok}
+
+// A value checked against a maximum
+#define LIMITED(__key, __kind, __flags, __idx, __struct, __member, __max, __error) \
+    {__key, __kind, __flags, __idx, AT(__struct, __member), 0, SIZE(__struct, __member), __max, __error}
+
+// A value whose length or element count is kept in another member
+#define COUNTED(__key, __kind, __idx, __struct, __member, __count, __max) \
+    {__key, __kind, 0, __idx, AT(__struct, __member), AT(__struct, __count), SIZE(__struct, __member), __max, parser_ok}
+
+#define TX_FIELD(__key, __kind, __flags, __idx, __member) \
+    FIELD(__key, __kind, __flags, __idx, parser_tx_t, __member)
+
+#define TX_COUNTED(__key, __kind, __idx, __member, __count, __max) \
+    COUNTED(__key, __kind, __idx, parser_tx_t, __member, __count, __max)
+
+static const schema_key_t tx_keys[TX_KEY_COUNT] = {
+    KEY(KEY_XFER_AMOUNT), KEY(KEY_XFER_CLOSE), KEY(KEY_FREEZE_FLAG), KEY(KEY_PAY_AMOUNT),
+    KEY(KEY_APP_ARGS), KEY(KEY_APP_ONCOMPLETION), KEY(KEY_APP_APROG_LEN), KEY(KEY_CONFIG_PARAMS),
+    KEY(KEY_APP_FOREIGN_ASSETS), KEY(KEY_APP_ACCOUNTS), KEY(KEY_APP_BOXES), KEY(KEY_APP_EXTRA_PAGES),
+    KEY(KEY_APP_FOREIGN_APPS), KEY(KEY_APP_GLOBAL_SCHEMA), KEY(KEY_APP_ID), KEY(KEY_APP_LOCAL_SCHEMA),
+    KEY(KEY_APP_CPROG_LEN), KEY(KEY_XFER_RECEIVER), KEY(KEY_XFER_SENDER), KEY(KEY_CONFIG_ID),
+    KEY(KEY_PAY_CLOSE), KEY(KEY_FREEZE_ACCOUNT), KEY(KEY_FREEZE_ID), KEY(KEY_COMMON_FEE),
+    KEY(KEY_COMMON_FIRST_VALID), KEY(KEY_COMMON_GEN_ID), KEY(KEY_COMMON_GEN_HASH), KEY(KEY_COMMON_GROUP_ID),
+    KEY(KEY_COMMON_LAST_VALID), KEY(KEY_COMMON_LEASE), KEY(KEY_VOTE_NON_PART_FLAG), KEY(KEY_COMMON_NOTE),
+    KEY(KEY_PAY_RECEIVER), KEY(KEY_COMMON_REKEY), KEY(KEY_VRF_PK), KEY(KEY_COMMON_SENDER),
+    KEY(KEY_SPRF_PK), KEY(KEY_COMMON_TYPE), KEY(KEY_VOTE_FIRST), KEY(KEY_VOTE_KEY_DILUTION),
+    KEY(KEY_VOTE_PK), KEY(KEY_VOTE_LAST), KEY(KEY_XFER_ID),
+};
+
+static const schema_key_t aparams_keys[APARAMS_KEY_COUNT] = {
+    KEY(KEY_APARAMS_METADATA_HASH), KEY(KEY_APARAMS_ASSET_NAME), KEY(KEY_APARAMS_URL),
+    KEY(KEY_APARAMS_CLAWBACK), KEY(KEY_APARAMS_DECIMALS), KEY(KEY_APARAMS_DEF_FROZEN),
+    KEY(KEY_APARAMS_FREEZE), KEY(KEY_APARAMS_MANAGER), KEY(KEY_APARAMS_RESERVE),
+    KEY(KEY_APARAMS_TOTAL), KEY(KEY_APARAMS_UNIT_NAME),
+};
+
+// First and last valid are not displayed
+static const schema_field_t common_fields[] = {
+    TX_FIELD(TX_KEY_SENDER, SCHEMA_BYTES, SCHEMA_REQUIRED, IDX_COMMON_SENDER, sender),
+    TX_FIELD(TX_KEY_LEASE, SCHEMA_BYTES, 0, IDX_COMMON_LEASE, lease),
+    TX_FIELD(TX_KEY_REKEY, SCHEMA_BYTES, 0, IDX_COMMON_REKEY_TO, rekey),
+    TX_FIELD(TX_KEY_FEE, SCHEMA_UINT64, SCHEMA_SHOW_DEFAULT, IDX_COMMON_FEE, fee),
+    TX_FIELD(TX_KEY_GEN_ID, SCHEMA_STRING, 0, IDX_COMMON_GEN_ID, genesisID),
+    TX_FIELD(TX_KEY_GEN_HASH, SCHEMA_BYTES, SCHEMA_REQUIRED, IDX_COMMON_GEN_HASH, genesisHash),
+    TX_FIELD(TX_KEY_GROUP_ID, SCHEMA_BYTES, 0, IDX_COMMON_GROUP_ID, groupID),
+    LIMITED(TX_KEY_NOTE, SCHEMA_BIN_LEN, 0, IDX_COMMON_NOTE, parser_tx_t, note_len,
+            MAX_NOTE_LEN, parser_unexpected_value),
+    TX_FIELD(TX_KEY_FIRST_VALID, SCHEMA_UINT64, SCHEMA_REQUIRED, SCHEMA_HIDDEN, firstValid),
+    TX_FIELD(TX_KEY_LAST_VALID, SCHEMA_UINT64, SCHEMA_REQUIRED, SCHEMA_HIDDEN, lastValid),
+};
+
+static const schema_field_t payment_fields[] = {
+    TX_FIELD(TX_KEY_PAY_RECEIVER, SCHEMA_BYTES, SCHEMA_REQUIRED, IDX_PAYMENT_RECEIVER, payment.receiver),
+    TX_FIELD(TX_KEY_PAY_AMOUNT, SCHEMA_UINT64, SCHEMA_SHOW_DEFAULT, IDX_PAYMENT_AMOUNT, payment.amount),
+    TX_FIELD(TX_KEY_PAY_CLOSE, SCHEMA_BYTES, 0, IDX_PAYMENT_CLOSE_TO, payment.close),
+};
+
+static const schema_field_t keyreg_fields[] = {
+    TX_FIELD(TX_KEY_VOTE_PK, SCHEMA_BYTES, 0, IDX_KEYREG_VOTE_PK, keyreg.votepk),
+    TX_FIELD(TX_KEY_VRF_PK, SCHEMA_BYTES, 0, IDX_KEYREG_VRF_PK, keyreg.vrfpk),
+    TX_FIELD(TX_KEY_SPRF_PK, SCHEMA_BYTES, 0, IDX_KEYREG_SPRF_PK, keyreg.sprfkey),
+    TX_FIELD(TX_KEY_VOTE_FIRST, SCHEMA_UINT64, 0, IDX_KEYREG_VOTE_FIRST, keyreg.voteFirst),
+    TX_FIELD(TX_KEY_VOTE_LAST, SCHEMA_UINT64, SCHEMA_WITH_PREVIOUS, IDX_KEYREG_VOTE_LAST, keyreg.voteLast),
+    TX_FIELD(TX_KEY_VOTE_KEY_DILUTION, SCHEMA_UINT64, 0, IDX_KEYREG_KEY_DILUTION, keyreg.keyDilution),
+    TX_FIELD(TX_KEY_VOTE_NON_PART_FLAG, SCHEMA_BOOL, SCHEMA_SHOW_DEFAULT, IDX_KEYREG_PARTICIPATION, keyreg.nonpartFlag),
+};
+
+static const schema_field_t asset_xfer_fields[] = {
+    TX_FIELD(TX_KEY_XFER_ID, SCHEMA_UINT64, SCHEMA_REQUIRED, IDX_XFER_ASSET_ID, asset_xfer.id),
+    TX_FIELD(TX_KEY_XFER_AMOUNT, SCHEMA_UINT64, SCHEMA_SHOW_DEFAULT, IDX_XFER_AMOUNT, asset_xfer.amount),
+    TX_FIELD(TX_KEY_XFER_RECEIVER, SCHEMA_BYTES, SCHEMA_REQUIRED, IDX_XFER_DESTINATION, asset_xfer.receiver),
+    TX_FIELD(TX_KEY_XFER_SENDER, SCHEMA_BYTES, 0, IDX_XFER_SOURCE, asset_xfer.sender),
+    TX_FIELD(TX_KEY_XFER_CLOSE, SCHEMA_BYTES, 0, IDX_XFER_CLOSE, asset_xfer.close),
+};
+
+static const schema_field_t asset_freeze_fields[] = {
+    TX_FIELD(TX_KEY_FREEZE_ID, SCHEMA_UINT64, SCHEMA_REQUIRED, IDX_FREEZE_ASSET_ID, asset_freeze.id),
+    TX_FIELD(TX_KEY_FREEZE_ACCOUNT, SCHEMA_BYTES, SCHEMA_REQUIRED, IDX_FREEZE_ACCOUNT, asset_freeze.account),
+    TX_FIELD(TX_KEY_FREEZE_FLAG, SCHEMA_BOOL, SCHEMA_SHOW_DEFAULT, IDX_FREEZE_FLAG, asset_freeze.flag),
+};
+
+// The parameters display their own items
+static const schema_field_t asset_config_fields[] = {
+    TX_FIELD(TX_KEY_CONFIG_ID, SCHEMA_UINT64, 0, IDX_CONFIG_ASSET_ID, asset_config.id),
+    LIMITED(TX_KEY_CONFIG_PARAMS, SCHEMA_ASSET_PARAMS, 0, SCHEMA_HIDDEN, parser_tx_t, asset_config.params,
+            MAX_PARAM_SIZE, parser_unexpected_number_items),
+};
+
+// Displayed in IDX_CONFIG order
+static const schema_field_t aparams_fields[] = {
+    FIELD(APARAMS_KEY_TOTAL, SCHEMA_UINT64, 0, IDX_CONFIG_TOTAL_UNITS, asset_params, total),
+    FIELD(APARAMS_KEY_DEF_FROZEN, SCHEMA_BOOL, 0, IDX_CONFIG_FROZEN, asset_params, default_frozen),
+    FIELD(APARAMS_KEY_UNIT_NAME, SCHEMA_STRING, 0, IDX_CONFIG_UNIT_NAME, asset_params, unitname),
+    FIELD(APARAMS_KEY_DECIMALS, SCHEMA_UINT64, 0, IDX_CONFIG_DECIMALS, asset_params, decimals),
+    FIELD(APARAMS_KEY_ASSET_NAME, SCHEMA_STRING, 0, IDX_CONFIG_ASSET_NAME, asset_params, assetname),
+    FIELD(APARAMS_KEY_URL, SCHEMA_STRING, 0, IDX_CONFIG_URL, asset_params, url),
+    FIELD(APARAMS_KEY_METADATA_HASH, SCHEMA_BYTES, 0, IDX_CONFIG_METADATA_HASH, asset_params, metadata_hash),
+    FIELD(APARAMS_KEY_MANAGER, SCHEMA_BYTES, 0, IDX_CONFIG_MANAGER, asset_params, manager),
+    FIELD(APARAMS_KEY_RESERVE, SCHEMA_BYTES, 0, IDX_CONFIG_RESERVE, asset_params, reserve),
+    FIELD(APARAMS_KEY_FREEZE, SCHEMA_BYTES, 0, IDX_CONFIG_FREEZER, asset_params, freeze),
+    FIELD(APARAMS_KEY_CLAWBACK, SCHEMA_BYTES, 0, IDX_CONFIG_CLAWBACK, asset_params, clawback),
+};
+
+static const schema_field_t application_fields[] = {
+    TX_FIELD(TX_KEY_APP_ID, SCHEMA_UINT64, SCHEMA_SHOW_DEFAULT, IDX_APP_ID, application.id),
+    TX_FIELD(TX_KEY_APP_ONCOMPLETION, SCHEMA_UINT64, SCHEMA_SHOW_DEFAULT, IDX_ON_COMPLETION, application.oncompletion),
+    TX_COUNTED(TX_KEY_APP_BOXES, SCHEMA_BOXES, IDX_BOXES,
+               application.boxes, application.num_boxes, MAX_FOREIGN_APPS),
+    TX_COUNTED(TX_KEY_APP_FOREIGN_APPS, SCHEMA_UINT64_ARRAY, IDX_FOREIGN_APP,
+               application.foreign_apps, application.num_foreign_apps, MAX_FOREIGN_APPS),
+    TX_COUNTED(TX_KEY_APP_FOREIGN_ASSETS, SCHEMA_UINT64_ARRAY, IDX_FOREIGN_ASSET,
+               application.foreign_assets, application.num_foreign_assets, MAX_FOREIGN_ASSETS),
+    TX_COUNTED(TX_KEY_APP_ACCOUNTS, SCHEMA_ACCOUNTS, IDX_ACCOUNTS,
+               application.num_accounts, application.num_accounts, MAX_ACCT),
+    TX_COUNTED(TX_KEY_APP_ARGS, SCHEMA_APP_ARGS, IDX_APP_ARGS,
+               application.app_args_len, application.num_app_args, MAX_ARG),
+    TX_FIELD(TX_KEY_APP_GLOBAL_SCHEMA, SCHEMA_STATE_SCHEMA, 0, IDX_GLOBAL_SCHEMA, application.global_schema),
+    TX_FIELD(TX_KEY_APP_LOCAL_SCHEMA, SCHEMA_STATE_SCHEMA, 0, IDX_LOCAL_SCHEMA, application.local_schema),
+    LIMITED(TX_KEY_APP_EXTRA_PAGES, SCHEMA_UINT8, 0, IDX_EXTRA_PAGES, parser_tx_t, application.extra_pages,
+            3, parser_too_many_extra_pages),
+    TX_COUNTED(TX_KEY_APP_APROG, SCHEMA_BIN_PTR, IDX_APPROVE,
+               application.aprog, application.aprog_len, UINT16_MAX),
+    TX_COUNTED(TX_KEY_APP_CPROG, SCHEMA_BIN_PTR, IDX_CLEAR,
+               application.cprog, application.cprog_len, UINT16_MAX),
+};
+
+#define SCHEMA_MAP(__map, __keys, __fields)         \
+    do {                                            \
+        (__map)->keys = __keys;                     \
+        (__map)->keyCount = ARRAY_SIZE(__keys);     \
+        (__map)->fields = __fields;                 \
+        (__map)->fieldCount = ARRAY_SIZE(__fields); \
+    } while (0)
+
+void parser_schema_common(schema_map_t *map)
+{
+    SCHEMA_MAP(map, tx_keys, common_fields);
+}
+
+bool parser_schema_tx(tx_type_e type, schema_map_t *map)
+{
+    switch (type) {
+        case TX_PAYMENT:
+            SCHEMA_MAP(map, tx_keys, payment_fields);
+            return true;
+        case TX_KEYREG:
+            SCHEMA_MAP(map, tx_keys, keyreg_fields);
+            return true;
+        case TX_ASSET_XFER:
+            SCHEMA_MAP(map, tx_keys, asset_xfer_fields);
+            return true;
+        case TX_ASSET_FREEZE:
+            SCHEMA_MAP(map, tx_keys, asset_freeze_fields);
+            return true;
+        case TX_ASSET_CONFIG:
+            SCHEMA_MAP(map, tx_keys, asset_config_fields);
+            return true;
+        case TX_APPLICATION:
+            SCHEMA_MAP(map, tx_keys, application_fields);
+            return true;
+        default:
+            return false;
+    }
+}
+
+void parser_schema_asset_params(schema_map_t *map)
+{
+    SCHEMA_MAP(map, aparams_keys, aparams_fields);
+}
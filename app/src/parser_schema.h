@@ -0,0 +1,152 @@
+/*******************************************************************************
+*  (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "parser_txdef.h"
+
+// Top-level transaction keys, in canonical (sorted) order
+typedef enum {
+    TX_KEY_XFER_AMOUNT = 0,
+    TX_KEY_XFER_CLOSE,
+    TX_KEY_FREEZE_FLAG,
+    TX_KEY_PAY_AMOUNT,
+    TX_KEY_APP_ARGS,
+    TX_KEY_APP_ONCOMPLETION,
+    TX_KEY_APP_APROG,
+    TX_KEY_CONFIG_PARAMS,
+    TX_KEY_APP_FOREIGN_ASSETS,
+    TX_KEY_APP_ACCOUNTS,
+    TX_KEY_APP_BOXES,
+    TX_KEY_APP_EXTRA_PAGES,
+    TX_KEY_APP_FOREIGN_APPS,
+    TX_KEY_APP_GLOBAL_SCHEMA,
+    TX_KEY_APP_ID,
+    TX_KEY_APP_LOCAL_SCHEMA,
+    TX_KEY_APP_CPROG,
+    TX_KEY_XFER_RECEIVER,
+    TX_KEY_XFER_SENDER,
+    TX_KEY_CONFIG_ID,
+    TX_KEY_PAY_CLOSE,
+    TX_KEY_FREEZE_ACCOUNT,
+    TX_KEY_FREEZE_ID,
+    TX_KEY_FEE,
+    TX_KEY_FIRST_VALID,
+    TX_KEY_GEN_ID,
+    TX_KEY_GEN_HASH,
+    TX_KEY_GROUP_ID,
+    TX_KEY_LAST_VALID,
+    TX_KEY_LEASE,
+    TX_KEY_VOTE_NON_PART_FLAG,
+    TX_KEY_NOTE,
+    TX_KEY_PAY_RECEIVER,
+    TX_KEY_REKEY,
+    TX_KEY_VRF_PK,
+    TX_KEY_SENDER,
+    TX_KEY_SPRF_PK,
+    TX_KEY_TYPE,
+    TX_KEY_VOTE_FIRST,
+    TX_KEY_VOTE_KEY_DILUTION,
+    TX_KEY_VOTE_PK,
+    TX_KEY_VOTE_LAST,
+    TX_KEY_XFER_ID,
+    TX_KEY_COUNT
+} tx_key_e;
+
+// Asset parameter keys, in canonical (sorted) order
+typedef enum {
+    APARAMS_KEY_METADATA_HASH = 0,
+    APARAMS_KEY_ASSET_NAME,
+    APARAMS_KEY_URL,
+    APARAMS_KEY_CLAWBACK,
+    APARAMS_KEY_DECIMALS,
+    APARAMS_KEY_DEF_FROZEN,
+    APARAMS_KEY_FREEZE,
+    APARAMS_KEY_MANAGER,
+    APARAMS_KEY_RESERVE,
+    APARAMS_KEY_TOTAL,
+    APARAMS_KEY_UNIT_NAME,
+    APARAMS_KEY_COUNT
+} aparams_key_e;
+
+// Largest key table. Presence is tracked in a 64-bit mask, which caps tables at 64 keys.
+#define SCHEMA_MAX_KEYS TX_KEY_COUNT
+
+typedef enum {
+    SCHEMA_UINT64,          // uint64_t
+    SCHEMA_UINT8,           // uint8_t no larger than max, maxError otherwise
+    SCHEMA_BOOL,            // uint8_t set to 0 or 1
+    SCHEMA_BYTES,           // bin of exactly size bytes
+    SCHEMA_STRING,          // NUL terminated string of at most size - 1 characters
+    SCHEMA_BIN_LEN,         // uint16_t length of a bin of at most max bytes, maxError otherwise
+    SCHEMA_BIN_PTR,         // pointer to a bin, its uint16_t length at count
+    SCHEMA_UINT64_ARRAY,    // uint64_t[] of at most max elements, the uint8_t count at count
+    SCHEMA_ACCOUNTS,        // array of at most max accounts, only the uint8_t count is kept
+    SCHEMA_APP_ARGS,        // uint16_t lengths of at most max app args, the uint8_t count at count
+    SCHEMA_BOXES,           // box[], the uint8_t count at count
+    SCHEMA_STATE_SCHEMA,    // state_schema
+    SCHEMA_ASSET_PARAMS,    // asset_params map of at most max entries, decoded with its own schema
+} schema_kind_e;
+
+// Decoding fails when a required field is missing
+#define SCHEMA_REQUIRED         0x01
+// Displayed with its zero value when absent
+#define SCHEMA_SHOW_DEFAULT     0x02
+// Only read along with the previous field, which then requires it
+#define SCHEMA_WITH_PREVIOUS    0x04
+
+#define SCHEMA_HIDDEN           0xFF
+
+// Names are stored inline so the tables hold no pointers
+typedef struct {
+    char name[8];
+    uint8_t len;
+} schema_key_t;
+
+// One field of a map: where its value goes and how it is checked and displayed. Arrays
+// display one item per element.
+typedef struct {
+    uint8_t key;            // index in the key table of the map
+    uint8_t kind;           // schema_kind_e
+    uint8_t flags;          // SCHEMA_* flags
+    uint8_t displayIdx;     // IDX_* of the item, SCHEMA_HIDDEN when never displayed
+    uint16_t dest;          // offset of the value in the decoded struct
+    uint16_t count;         // offset of the length or element count, when the kind has one
+    uint16_t size;          // size of the value at dest
+    uint16_t max;           // most elements or bytes accepted
+    uint8_t maxError;       // parser_error_t returned above max, when the kind does not fix it
+} schema_field_t;
+
+// Fields of a map, listed in display order
+typedef struct {
+    const schema_key_t *keys;
+    const schema_field_t *fields;
+    uint8_t keyCount;
+    uint8_t fieldCount;
+} schema_map_t;
+
+void parser_schema_common(schema_map_t *map);
+bool parser_schema_tx(tx_type_e type, schema_map_t *map);
+void parser_schema_asset_params(schema_map_t *map);
+
+#ifdef __cplusplus
+}
+#endif
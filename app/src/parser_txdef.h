@@ -21,6 +21,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include "algo_network.h"
 
 typedef enum tx_type_e {
   TX_UNKNOWN,
@@ -237,6 +238,8 @@ typedef struct{
   uint64_t lastValid;
   char genesisID[32];
   uint8_t genesisHash[32];
+  // Registry entry matching genesisHash, NULL for unknown networks
+  const algo_network_info_t *network;
   uint8_t groupID[32];
   uint8_t lease[32];
 
@@ -321,6 +324,7 @@ typedef enum {
 typedef enum {
   MsgPack = 0,
   ArbitraryData,
+  ArbitraryDataBatch,
 } txn_content_e;
 
 typedef struct {
@@ -333,8 +337,35 @@ typedef struct {
   uint16_t requestIdLen;
   const uint8_t* authDataBuffer;
   uint16_t authDataLen;
+  // SHA256 of the domain, data and authData, taken while parsing
+  uint8_t domainDigest[32];
+  uint8_t dataDigest[32];
+  uint8_t authDataDigest[32];
 } parser_arbitrary_data_t;
 
+#define ARBITRARY_BATCH_MAX_ITEMS 8
+
+typedef struct {
+  const uint8_t* dataBuffer;
+  uint16_t dataLen;
+  const uint8_t* requestIdBuffer;
+  uint16_t requestIdLen;
+  const uint8_t* authDataBuffer;
+  uint16_t authDataLen;
+  // SHA256 of data and authData, taken while parsing
+  uint8_t dataDigest[32];
+  uint8_t authDataDigest[32];
+} parser_arbitrary_item_t;
+
+// Several challenges sharing the same signer, scope, encoding and domain
+typedef struct {
+  const uint8_t* signerBuffer;
+  const uint8_t* domainBuffer;
+  uint16_t domainLen;
+  uint8_t itemCount;
+  parser_arbitrary_item_t items[ARBITRARY_BATCH_MAX_ITEMS];
+} parser_arbitrary_batch_t;
+
 #define MAX_NOTE_LEN 1024
 #define PAGE_LEN 2048
 
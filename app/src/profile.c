@@ -0,0 +1,98 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#if !defined(LEDGER_SPECIFIC)
+#include "profile.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static profile_t profile;
+
+static const char *const counter_names[PROFILE_COUNTER_COUNT] = {
+    "find_key", "find_key_skipped_bytes", "encode_pubkey", "sha256", "base64_encode", "page_string",
+};
+
+static const char *const stage_names[PROFILE_STAGE_COUNT] = {
+    "parse", "validate", "get_item",
+};
+
+#if defined(APP_PROFILE)
+void profile_add(profile_counter_e counter, uint64_t value) {
+    profile.counters[counter] += value;
+}
+
+uint64_t profile_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+void profile_stage_add(profile_stage_e stage, uint64_t startNs) {
+    profile.stages[stage].calls++;
+    profile.stages[stage].ns += profile_now_ns() - startNs;
+}
+#endif
+
+void profile_reset(void) {
+    memset(&profile, 0, sizeof(profile));
+}
+
+void profile_get(profile_t *out) {
+    *out = profile;
+}
+
+// Appends to out at *offset; returns false once it no longer fits
+static bool append(char *out, size_t outLen, size_t *offset, const char *format,
+                   const char *name, unsigned long long a, unsigned long long b) {
+    const int written = snprintf(out + *offset, outLen - *offset, format, name, a, b);
+    if (written < 0 || (size_t) written >= outLen - *offset) {
+        return false;
+    }
+    *offset += (size_t) written;
+    return true;
+}
+
+size_t profile_to_json(char *out, size_t outLen) {
+    if (out == NULL || outLen == 0) {
+        return 0;
+    }
+#if defined(APP_PROFILE)
+    const char *enabled = "true";
+#else
+    const char *enabled = "false";
+#endif
+
+    size_t offset = 0;
+    bool ok = append(out, outLen, &offset, "{\"enabled\":%s,\"counters\":{", enabled, 0, 0);
+    for (uint8_t i = 0; ok && i < PROFILE_COUNTER_COUNT; i++) {
+        ok = append(out, outLen, &offset, i == 0 ? "\"%s\":%llu" : ",\"%s\":%llu", counter_names[i],
+                    (unsigned long long) profile.counters[i], 0);
+    }
+    ok = ok && append(out, outLen, &offset, "%s", "},\"stages\":{", 0, 0);
+    for (uint8_t i = 0; ok && i < PROFILE_STAGE_COUNT; i++) {
+        ok = append(out, outLen, &offset, i == 0 ? "\"%s\":{\"calls\":%llu,\"ns\":%llu}" : ",\"%s\":{\"calls\":%llu,\"ns\":%llu}",
+                    stage_names[i], profile.stages[i].calls, (unsigned long long) profile.stages[i].ns);
+    }
+    ok = ok && append(out, outLen, &offset, "%s", "}}", 0, 0);
+
+    if (!ok) {
+        out[0] = 0;
+        return 0;
+    }
+    return offset;
+}
+#endif
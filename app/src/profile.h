@@ -0,0 +1,98 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Hot-path counters and stage timers for host builds configured with -DENABLE_PROFILE=ON
+// (APP_PROFILE). Otherwise the PROFILE_* macros expand to nothing and the counters stay at 0.
+// Counters accumulate until profile_reset(), which tx_parse() calls for every new transaction.
+
+typedef enum {
+    PROFILE_FIND_KEY = 0,
+    PROFILE_FIND_KEY_SKIPPED_BYTES,     // value bytes _findKey walked past before the match
+    PROFILE_ENCODE_PUBKEY,
+    PROFILE_SHA256,
+    PROFILE_BASE64_ENCODE,
+    PROFILE_PAGE_STRING,
+    PROFILE_COUNTER_COUNT,
+} profile_counter_e;
+
+// Stage times are inclusive: parser_validate renders every item through parser_getItem
+typedef enum {
+    PROFILE_STAGE_PARSE = 0,
+    PROFILE_STAGE_VALIDATE,
+    PROFILE_STAGE_GET_ITEM,
+    PROFILE_STAGE_COUNT,
+} profile_stage_e;
+
+typedef struct {
+    uint32_t calls;
+    uint64_t ns;
+} profile_timer_t;
+
+typedef struct {
+    uint64_t counters[PROFILE_COUNTER_COUNT];
+    profile_timer_t stages[PROFILE_STAGE_COUNT];
+} profile_t;
+
+#if defined(APP_PROFILE)
+#if defined(LEDGER_SPECIFIC)
+#error "APP_PROFILE is only available in host builds"
+#endif
+
+#include "zxformat.h"
+#include "base64.h"
+
+void profile_add(profile_counter_e counter, uint64_t value);
+uint64_t profile_now_ns(void);
+void profile_stage_add(profile_stage_e stage, uint64_t startNs);
+
+#define PROFILE_COUNT(COUNTER)          profile_add((COUNTER), 1)
+#define PROFILE_ADD(COUNTER, VALUE)     profile_add((COUNTER), (VALUE))
+#define PROFILE_STAGE_BEGIN()           const uint64_t profileStartNs = profile_now_ns()
+#define PROFILE_STAGE_END(STAGE)        profile_stage_add((STAGE), profileStartNs)
+
+// zxlib is not instrumented, so its helpers are counted where the app calls them.
+// zxformat.h and base64.h are included above, so these never rename their declarations.
+#define pageString(...)     (PROFILE_COUNT(PROFILE_PAGE_STRING), pageString(__VA_ARGS__))
+#define base64_encode(...)  (PROFILE_COUNT(PROFILE_BASE64_ENCODE), base64_encode(__VA_ARGS__))
+#else
+#define PROFILE_COUNT(COUNTER)          do {} while (0)
+#define PROFILE_ADD(COUNTER, VALUE)     ((void) sizeof(VALUE))
+#define PROFILE_STAGE_BEGIN()           do {} while (0)
+#define PROFILE_STAGE_END(STAGE)        do {} while (0)
+#endif
+
+#if !defined(LEDGER_SPECIFIC)
+void profile_reset(void);
+void profile_get(profile_t *profile);
+
+/// Writes the counters and stage timers as a JSON object; returns its length, 0 if outLen is too small.
+/// "enabled" tells whether this build was instrumented at all.
+size_t profile_to_json(char *out, size_t outLen);
+#else
+#define profile_reset() do {} while (0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,117 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "trace.h"
+
+#if defined(APP_TESTING) || !defined(LEDGER_SPECIFIC)
+#include <string.h>
+#include "zxmacros.h"
+
+typedef struct {
+    uint32_t timestamp;
+    uint8_t event;
+    uint8_t exchange;
+    uint16_t arg;
+} trace_entry_t;
+
+typedef struct {
+    trace_entry_t entries[TRACE_ENTRIES];
+    uint16_t head;          // oldest record
+    uint16_t count;
+    uint16_t dropped;
+    uint8_t exchange;
+    uint32_t sequence;
+} trace_ring_t;
+
+static trace_ring_t trace;
+
+#if defined(TRACE_CLOCK)
+uint32_t TRACE_CLOCK(void);
+#elif !defined(LEDGER_SPECIFIC)
+#include <time.h>
+
+static uint32_t trace_host_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) ((uint64_t) ts.tv_sec * 1000000u + (uint64_t) ts.tv_nsec / 1000u);
+}
+#define TRACE_CLOCK() trace_host_clock()
+#else
+#define TRACE_CLOCK() trace.sequence
+#endif
+
+void trace_record(trace_event_e event, uint16_t arg) {
+    // Full: the oldest record makes room, as the latest exchange is the interesting one
+    if (trace.count == TRACE_ENTRIES) {
+        trace.head = (uint16_t) ((trace.head + 1) % TRACE_ENTRIES);
+        trace.count--;
+        if (trace.dropped < UINT16_MAX) {
+            trace.dropped++;
+        }
+    }
+
+    trace_entry_t *entry = &trace.entries[(trace.head + trace.count) % TRACE_ENTRIES];
+    entry->timestamp = TRACE_CLOCK();
+    entry->event = (uint8_t) event;
+    entry->exchange = trace.exchange;
+    entry->arg = arg;
+    trace.count++;
+    trace.sequence++;
+}
+
+void trace_next_exchange(void) {
+    trace.exchange++;
+}
+
+uint16_t trace_drain(uint8_t *out, uint16_t outLen) {
+    if (out == NULL || outLen < TRACE_HEADER_LEN) {
+        return 0;
+    }
+
+    uint16_t returned = (uint16_t) ((outLen - TRACE_HEADER_LEN) / TRACE_RECORD_LEN);
+    if (returned > trace.count) {
+        returned = trace.count;
+    }
+    if (returned > UINT8_MAX) {
+        returned = UINT8_MAX;
+    }
+
+    out[0] = (uint8_t) returned;
+    out[1] = (uint8_t) (trace.dropped >> 8);
+    out[2] = (uint8_t) trace.dropped;
+    trace.dropped = 0;
+
+    uint8_t *record = out + TRACE_HEADER_LEN;
+    for (uint16_t i = 0; i < returned; i++, record += TRACE_RECORD_LEN) {
+        const trace_entry_t *entry = &trace.entries[trace.head];
+        record[0] = (uint8_t) (entry->timestamp >> 24);
+        record[1] = (uint8_t) (entry->timestamp >> 16);
+        record[2] = (uint8_t) (entry->timestamp >> 8);
+        record[3] = (uint8_t) entry->timestamp;
+        record[4] = entry->event;
+        record[5] = entry->exchange;
+        record[6] = (uint8_t) (entry->arg >> 8);
+        record[7] = (uint8_t) entry->arg;
+        trace.head = (uint16_t) ((trace.head + 1) % TRACE_ENTRIES);
+        trace.count--;
+    }
+
+    return (uint16_t) (TRACE_HEADER_LEN + returned * TRACE_RECORD_LEN);
+}
+
+void trace_reset(void) {
+    MEMZERO(&trace, sizeof(trace));
+}
+#endif
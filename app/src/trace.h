@@ -0,0 +1,79 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Ring buffer of compact timing events for APP_TESTING builds, drained with INS_GET_TRACE.
+// Outside APP_TESTING the TRACE_* macros expand to nothing.
+//
+// Timestamps come from TRACE_CLOCK(), which a build can point at a platform tick counter
+// (DEFINES += TRACE_CLOCK=fn, fn being a uint32_t (void) function). Without one, host builds
+// use microseconds and device builds the event sequence number, so a drained trace still
+// orders the events of each exchange.
+
+typedef enum {
+    TRACE_APDU = 1,         // arg: INS
+    TRACE_CHUNK,            // arg: payload bytes
+    TRACE_NVM_WRITE,        // arg: bytes buffered in flash
+    TRACE_PARSE_START,      // arg: txn_content_e
+    TRACE_PARSE_END,        // arg: parser_error_t
+    TRACE_VALIDATE_END,     // arg: parser_error_t
+    TRACE_FIRST_RENDER,     // first page of the first item requested by the UI
+    TRACE_KEY_DERIVE_START,
+    TRACE_KEY_DERIVE_END,   // arg: zxerr_t
+    TRACE_SIGN_START,
+    TRACE_SIGN_END,         // arg: zxerr_t
+} trace_event_e;
+
+// Record: timestamp (4) | event (1) | exchange (1) | arg (2), big endian
+#define TRACE_RECORD_LEN    8
+// Reply header: records returned (1) | records dropped since the last drain (2)
+#define TRACE_HEADER_LEN    3
+
+#if defined(TARGET_NANOS)
+#define TRACE_ENTRIES       32
+#else
+#define TRACE_ENTRIES       128
+#endif
+
+#if defined(APP_TESTING) || !defined(LEDGER_SPECIFIC)
+void trace_record(trace_event_e event, uint16_t arg);
+
+/// Starts a new exchange; the events that follow carry its sequence number
+void trace_next_exchange(void);
+
+/// Moves the oldest records that fit into out, after the header. Returns the reply length.
+uint16_t trace_drain(uint8_t *out, uint16_t outLen);
+
+void trace_reset(void);
+#endif
+
+#if defined(APP_TESTING)
+#define TRACE_EVENT(EVENT, ARG)     trace_record((EVENT), (uint16_t) (ARG))
+#define TRACE_EXCHANGE()            trace_next_exchange()
+#else
+#define TRACE_EVENT(EVENT, ARG)     do {} while (0)
+#define TRACE_EXCHANGE()            do {} while (0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,62 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    class Runner {
+    public:
+        Runner(std::vector<std::string> filters, bool profile)
+                : filters_(std::move(filters)), profile_(profile) {}
+
+        // Times `body` until enough iterations have run to be stable and prints one line.
+        // `bytesPerOp` is only used to report throughput; pass 0 when it does not apply.
+        // When profiling, one more run of `body` is captured with the app_lib counters (see profile.h).
+        void run(const std::string &name, uint64_t bytesPerOp, const std::function<void()> &body);
+
+        // { benchmark: profile } for the benchmarks run so far
+        std::string profileJson() const;
+
+    private:
+        bool selected(const std::string &name) const;
+
+        std::vector<std::string> filters_;
+        bool profile_;
+        std::vector<std::pair<std::string, std::string>> profiles_;
+    };
+
+    using bench_fn = void (*)(Runner &);
+
+    struct Registrar {
+        Registrar(const char *group, bench_fn fn);
+    };
+
+    // Keeps the optimizer from discarding results that are never read
+    template<typename T>
+    inline void doNotOptimize(T const &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+}
+
+#define BENCHMARK_GROUP(NAME)                                                   \
+    static void bench_group_##NAME(bench::Runner &runner);                      \
+    static const bench::Registrar bench_registrar_##NAME(#NAME, bench_group_##NAME); \
+    static void bench_group_##NAME(bench::Runner &runner)
@@ -0,0 +1,47 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bench.h"
+
+#include <zxformat.h>
+#include "coin.h"
+#include "parser_encoding.h"
+
+// Fee and amount shapes seen on screen: round ALGO, micro-ALGO fractions and large ASA balances
+static const uint64_t amounts[] = {1000, 1234567, 5000000, 18446744073709551615ULL};
+
+// What _toStringBalance ran before _formatAmount, kept to compare against
+static void legacyFormat(char *bufferUI, size_t bufferLen, uint64_t amount, uint8_t decimalPlaces, const char *prefix) {
+    memset(bufferUI, 0, bufferLen);
+    uint64_to_str(bufferUI, (int) bufferLen, amount);
+    intstr_to_fpstr_inplace(bufferUI, bufferLen, decimalPlaces);
+    z_str3join(bufferUI, bufferLen, prefix, "");
+    number_inplace_trimming(bufferUI, 1);
+}
+
+BENCHMARK_GROUP(amount) {
+    for (const uint64_t amount : amounts) {
+        runner.run("amount/legacy/" + std::to_string(amount), 0, [&] {
+            char bufferUI[200];
+            legacyFormat(bufferUI, sizeof(bufferUI), amount, COIN_AMOUNT_DECIMAL_PLACES, COIN_TICKER);
+            bench::doNotOptimize(bufferUI);
+        });
+        runner.run("amount/format/" + std::to_string(amount), 0, [&] {
+            char bufferUI[MAX_AMOUNT_STR_LEN];
+            _formatAmount(bufferUI, sizeof(bufferUI), amount, COIN_AMOUNT_DECIMAL_PLACES, COIN_TICKER, "");
+            bench::doNotOptimize(bufferUI);
+        });
+    }
+}
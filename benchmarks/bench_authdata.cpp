@@ -0,0 +1,94 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bench.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "common/parser.h"
+#include "crypto.h"
+#include "crypto_utils.h"
+#include "coin.h"
+
+namespace {
+    typedef std::vector<uint8_t> bytes;
+
+    void appendU16(bytes &out, uint16_t v) {
+        out.push_back((uint8_t) (v >> 8));
+        out.push_back((uint8_t) v);
+    }
+
+    // Arbitrary data signing request whose authData carries flags, signCount and the given
+    // attested credential data and extensions after the domain hash
+    bytes request(uint8_t flags, const bytes &cbor) {
+        const std::string domain = "arc60.io";
+        const std::string json = R"({"challenge":"eSZVsYmvNCjJGH5a9WWIjKp5jm5DFxlwBBAw9zc8FZM=","type":"arc60.create"})";
+
+        bytes auth(SHA256_DIGEST_SIZE);
+        crypto_sha256((const uint8_t *) domain.data(), (uint16_t) domain.size(), auth.data(), (uint16_t) auth.size());
+        auth.insert(auth.end(), {flags, 0, 0, 0, 1});
+        if (flags & 0x40) {
+            auth.insert(auth.end(), 16, 0xAA);      // AAGUID
+            appendU16(auth, 64);
+            auth.insert(auth.end(), 64, 0x11);      // credentialId
+        }
+        auth.insert(auth.end(), cbor.begin(), cbor.end());
+
+        const uint32_t path[HDPATH_LEN_DEFAULT] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT, HDPATH_2_DEFAULT, 0, 0};
+        bytes out((const uint8_t *) path, (const uint8_t *) path + sizeof(path));
+        memcpy(hdPath, path, sizeof(path));
+        bytes signer(PK_LEN_25519);
+        crypto_extractPublicKey(signer.data(), (uint16_t) signer.size());
+        out.insert(out.end(), signer.begin(), signer.end());
+        out.push_back(0x01);    // AUTH scope
+        out.push_back(0x01);    // Base64 encoding
+
+        const std::string authString(auth.begin(), auth.end());
+        for (const std::string &field : {json, domain, std::string(), authString}) {
+            appendU16(out, (uint16_t) field.size());
+            out.insert(out.end(), field.begin(), field.end());
+        }
+        return out;
+    }
+}
+
+BENCHMARK_GROUP(authdata) {
+    // {1: 2, 3: -7, 4: [1, 2], -1: 1, -2: h'..', -3: h'..'}, a P-256 credential public key
+    bytes es256 = {0xA6, 0x01, 0x02, 0x03, 0x26, 0x04, 0x82, 0x01, 0x02, 0x20, 0x01, 0x21, 0x58, 0x20};
+    es256.insert(es256.end(), 32, 0x33);
+    es256.insert(es256.end(), {0x22, 0x58, 0x20});
+    es256.insert(es256.end(), 32, 0x44);
+    // {"credProtect": 2, "hmac-secret": true}
+    const bytes extensions = {0xA2, 0x6B, 'c', 'r', 'e', 'd', 'P', 'r', 'o', 't', 'e', 'c', 't', 0x02,
+                              0x6B, 'h', 'm', 'a', 'c', '-', 's', 'e', 'c', 'r', 'e', 't', 0xF5};
+    bytes both = es256;
+    both.insert(both.end(), extensions.begin(), extensions.end());
+
+    const std::pair<std::string, bytes> cases[] = {
+            {"domain_only", request(0x01, {})},
+            {"credential_key", request(0x41, es256)},
+            {"credential_key_extensions", request(0xC1, both)},
+    };
+
+    for (const auto &c : cases) {
+        runner.run("authdata/parse/" + c.first, c.second.size(), [&] {
+            parser_context_t ctx;
+            parser_arbitrary_data_t obj;
+            const parser_error_t err = parser_parse(&ctx, c.second.data(), c.second.size(), &obj, ArbitraryData);
+            bench::doNotOptimize(err);
+        });
+    }
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bench.h"
+
+#include <vector>
+#include "byte_class.h"
+
+// Domains are short, JSON challenges and arbitrary data reach the KB range
+static const uint16_t checked_sizes[] = {1024, 2048, 4096, 8192, 16384};
+
+// The byte at a time loop the call sites ran before
+static bool legacyPrintable(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] < 32 || data[i] > 126) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BENCHMARK_GROUP(byte_class) {
+    const byte_class_backend_e initial = byte_class_get_backend();
+
+    std::vector<uint8_t> text(16384);
+    for (size_t i = 0; i < text.size(); i++) {
+        text[i] = static_cast<uint8_t>(0x20 + i % 95);
+    }
+    const std::vector<uint8_t> zeros(16384, 0);
+
+    for (const uint16_t size : checked_sizes) {
+        runner.run("byte_class/printable/legacy/" + std::to_string(size), size, [&] {
+            bench::doNotOptimize(legacyPrintable(text.data(), size));
+        });
+    }
+
+    const std::pair<byte_class_backend_e, const char *> backends[] = {
+        {byte_class_backend_portable, "portable"},
+        {byte_class_backend_sse2, "sse2"},
+        {byte_class_backend_avx2, "avx2"},
+    };
+    for (const auto &backend : backends) {
+        if (byte_class_set_backend(backend.first) != zxerr_ok) {
+            continue;
+        }
+        for (const uint16_t size : checked_sizes) {
+            runner.run(std::string("byte_class/printable/") + backend.second + "/" + std::to_string(size), size, [&] {
+                bench::doNotOptimize(bytes_printable(text.data(), size));
+            });
+            runner.run(std::string("byte_class/all_zero/") + backend.second + "/" + std::to_string(size), size, [&] {
+                bench::doNotOptimize(bytes_all_zero(zeros.data(), size));
+            });
+        }
+    }
+
+    byte_class_set_backend(initial);
+}
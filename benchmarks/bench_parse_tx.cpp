@@ -0,0 +1,106 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bench.h"
+
+#include <string>
+#include <vector>
+#include <hexutils.h>
+#include "common/parser.h"
+
+namespace {
+    struct tx_vector_t {
+        const char *name;
+        const char *blob;
+    };
+
+    const tx_vector_t vectors[] = {
+        // Payment from the Zemu account 0 to itself
+        {"payment",
+             "88a3616d74cd03e8a3666565cd03e8a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac"
+             "20dec62f7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79"
+             "ca25c0da60f8a3736e64c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a4747970"
+             "65a3706179"},
+        // Payment with close-to, genesis ID and note
+        {"payment_close_note",
+             "8ba3616d74cd03e8a5636c6f7365c42040e93492882564cbce9c59a69b67542689e9a1c3a2a9ea5b65a6e8a4421ffc57"
+             "a3666565cd03e8a26676cd3039a367656eac6465766e65742d7633382e30a26768c420feb36c3910143900c3da5542ca"
+             "1836b00fd2f819591257cd23f6042f98c8369da26c76cdf6fda46e6f7465c40845262200185286fba3726376c4207b6c"
+             "e24feb5bacc0b164e29c222c57f5f63dc387d439048258411c5fe10f7c02a3736e64c4208d92b489900173a04dfa4359"
+             "a3666a6afcea2c42a05dd9c1f73eeba5478037e9a474797065a3706179"},
+        // Asset transfer of 10 units of asset 1234
+        {"axfer",
+             "89a461616d740aa461726376c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a366"
+             "6565cd0910a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22"
+             "a26c76cd07d0a3736e64c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a4747970"
+             "65a56178666572a478616964cd04d2"},
+        // Opt-in to asset 1234: no amount, sender and receiver are the same account
+        {"axfer_opt_in",
+             "88a461726376c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a3666565cd0910a2"
+             "6676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0"
+             "a3736e64c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a474797065a561786665"
+             "72a478616964cd04d2"},
+        // Key registration with participation keys
+        {"keyreg",
+             "8ca3666565cd0e42a26676cd03e7a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5"
+             "093a22a26c76cd0d80a673656c6b6579c420f66af5dd18bcac57a9c4dde084852b64dba2e8baaa339844cc1e3946b8b9"
+             "9645a3736e64c420bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfa7737072666b6579"
+             "c44099847419510e6cc4d235db0a33a470632c0760fa950ea837138245cf164eade1fd354f01fad2b351a9f263c010d7"
+             "8e21113812317edf5d6c2305d1f3e805a4f7a474797065a66b6579726567a7766f746566737401a6766f74656b640aa7"
+             "766f74656b6579c420f66af5dd18bcac57a9c4dde084852b64dba2e8baaa339844cc1e3946b8b99645a7766f74656c73"
+             "74cd07d0"},
+        // Asset creation with every parameter set
+        {"acfg",
+             "8da4617061728ba2616dc4200707070707070707070707070707070707070707070707070707070707070707a2616ea8"
+             "55534420436f696ea26175b868747470733a2f2f6578616d706c652e636f6d2f75736463a163c4200001020304050607"
+             "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e1fa2646306a26466c3a166c420070707070707070707070707"
+             "0707070707070707070707070707070707070707a16dc420000102030405060708090a0b0c0d0e0f1011121314151617"
+             "18191a1b1c1d1e1fa172c420202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3fa174cf00"
+             "0000e8d4a51000a2756ea455534443a4636169644da3666565cd03e8a26676cd03e8a367656eac746573746e65742d76"
+             "312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c4200707"
+             "070707070707070707070707070707070707070707070707070707070707a26c76cd07d0a26c78c42007070707070707"
+             "07070707070707070707070707070707070707070707070707a46e6f7465c40a68656c6c6f206e6f7465a572656b6579"
+             "c420202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3fa3736e64c4200001020304050607"
+             "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e1fa474797065a461636667"},
+        // Application call with boxes, foreign apps and assets, accounts, args and programs
+        {"appl",
+             "de0017a46170616192c40461726731c42878787878787878787878787878787878787878787878787878787878787878"
+             "787878787878787878a46170616e01a461706170c403068101a4617061739107a46170617492c4200001020304050607"
+             "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e1fc420202122232425262728292a2b2c2d2e2f303132333435"
+             "363738393a3b3c3d3e3fa4617062789282a16901a16ec403626f7881a16ec4026232a46170657002a461706661920506"
+             "a46170677382a36e627302a36e756901a4617069647ba461706c7381a36e627303a461707375c403068101a3666565cd"
+             "03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71"
+             "f059a7ac20dec62f7f70e5093a22a3677270c42007070707070707070707070707070707070707070707070707070707"
+             "07070707a26c76cd07d0a26c78c4200707070707070707070707070707070707070707070707070707070707070707a4"
+             "6e6f7465c40a68656c6c6f206e6f7465a572656b6579c420202122232425262728292a2b2c2d2e2f3031323334353637"
+             "38393a3b3c3d3e3fa3736e64c420000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1fa474"
+             "797065a46170706c"},
+    };
+}
+
+BENCHMARK_GROUP(parse_tx) {
+    for (const auto &v : vectors) {
+        const std::string hex = v.blob;
+        std::vector<uint8_t> blob(hex.size() / 2);
+        parseHexString(blob.data(), (uint16_t) blob.size(), hex.c_str());
+
+        runner.run(std::string("parse_tx/") + v.name, blob.size(), [&] {
+            parser_context_t ctx;
+            parser_tx_t tx;
+            const parser_error_t err = parser_parse(&ctx, blob.data(), (uint16_t) blob.size(), &tx, MsgPack);
+            bench::doNotOptimize(err);
+        });
+    }
+}
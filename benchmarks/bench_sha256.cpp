@@ -0,0 +1,54 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bench.h"
+
+#include <vector>
+#include "coin.h"
+#include "crypto_utils.h"
+#include "crypto_sha256_shani.h"
+
+// Sizes we actually hash: domains and authenticator data (tens of bytes), app args,
+// notes and arbitrary-sign payloads (hundreds of bytes), and TEAL programs (up to a few KB)
+static const uint16_t hashed_sizes[] = {32, 37, 64, 128, 256, 512, 1024, 2048, 4096, 8192};
+
+BENCHMARK_GROUP(sha256) {
+    const crypto_sha256_backend_e initial = crypto_sha256_get_backend();
+
+    std::vector<uint8_t> input(8192);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<uint8_t>(i);
+    }
+
+    std::vector<std::pair<crypto_sha256_backend_e, const char *>> backends = {
+        {crypto_sha256_backend_portable, "portable"},
+    };
+    if (sha256_shani_supported()) {
+        backends.emplace_back(crypto_sha256_backend_shani, "shani");
+    }
+
+    for (const auto &backend : backends) {
+        crypto_sha256_set_backend(backend.first);
+        for (const uint16_t size : hashed_sizes) {
+            runner.run(std::string("sha256/") + backend.second + "/" + std::to_string(size), size, [&] {
+                uint8_t digest[SHA256_DIGEST_SIZE];
+                crypto_sha256(input.data(), size, digest, sizeof(digest));
+                bench::doNotOptimize(digest);
+            });
+        }
+    }
+
+    crypto_sha256_set_backend(initial);
+}
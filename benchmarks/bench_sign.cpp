@@ -0,0 +1,126 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bench.h"
+
+#include <cstring>
+#include <vector>
+#include "coin.h"
+#include "crypto.h"
+#include "key_cache.h"
+#include "parser.h"
+#include "parser_txdef.h"
+
+// Payment from the Zemu account 0 to itself, as buffered by the app ("TX" || msgpack)
+static const uint8_t payment_tx[] = {
+    0x54, 0x58, 0x88, 0xa3, 0x61, 0x6d, 0x74, 0xcd, 0x03, 0xe8, 0xa3, 0x66, 0x65, 0x65, 0xcd, 0x03,
+    0xe8, 0xa2, 0x66, 0x76, 0xcd, 0x03, 0xe8, 0xa2, 0x67, 0x68, 0xc4, 0x20, 0x48, 0x63, 0xb5, 0x18,
+    0xa4, 0xb3, 0xc8, 0x4e, 0xc8, 0x10, 0xf2, 0x2d, 0x4f, 0x10, 0x81, 0xcb, 0x0f, 0x71, 0xf0, 0x59,
+    0xa7, 0xac, 0x20, 0xde, 0xc6, 0x2f, 0x7f, 0x70, 0xe5, 0x09, 0x3a, 0x22, 0xa2, 0x6c, 0x76, 0xcd,
+    0x07, 0xd0, 0xa3, 0x72, 0x63, 0x76, 0xc4, 0x20, 0x1e, 0xcc, 0xfd, 0x1e, 0xc0, 0x5e, 0x41, 0x25,
+    0xfa, 0xe6, 0x90, 0xce, 0xc2, 0xa7, 0x78, 0x39, 0xa9, 0xa3, 0x62, 0x35, 0xdd, 0x6e, 0x2e, 0xaf,
+    0xba, 0x79, 0xca, 0x25, 0xc0, 0xda, 0x60, 0xf8, 0xa3, 0x73, 0x6e, 0x64, 0xc4, 0x20, 0x1e, 0xcc,
+    0xfd, 0x1e, 0xc0, 0x5e, 0x41, 0x25, 0xfa, 0xe6, 0x90, 0xce, 0xc2, 0xa7, 0x78, 0x39, 0xa9, 0xa3,
+    0x62, 0x35, 0xdd, 0x6e, 0x2e, 0xaf, 0xba, 0x79, 0xca, 0x25, 0xc0, 0xda, 0x60, 0xf8, 0xa4, 0x74,
+    0x79, 0x70, 0x65, 0xa3, 0x70, 0x61, 0x79,
+};
+
+static void setAccount(uint32_t account) {
+    hdPath[0] = HDPATH_0_DEFAULT;
+    hdPath[1] = HDPATH_1_DEFAULT;
+    hdPath[2] = HDPATH_2_DEFAULT | account;
+    hdPath[3] = HDPATH_3_DEFAULT;
+    hdPath[4] = HDPATH_4_DEFAULT;
+}
+
+BENCHMARK_GROUP(sign) {
+    setAccount(0);
+
+    runner.run("sign/derive_pubkey/cold", 0, [&] {
+        uint8_t publicKey[PK_LEN_25519];
+        key_cache_reset();
+        crypto_extractPublicKey(publicKey, sizeof(publicKey));
+        bench::doNotOptimize(publicKey);
+    });
+
+    runner.run("sign/derive_pubkey/cached", 0, [&] {
+        uint8_t publicKey[PK_LEN_25519];
+        crypto_extractPublicKey(publicKey, sizeof(publicKey));
+        bench::doNotOptimize(publicKey);
+    });
+
+    // Eight addresses: one APDU of INS_GET_PUBLIC_KEYS vs eight INS_GET_PUBLIC_KEY
+    runner.run("sign/pubkeys_x8/bulk", 0, [&] {
+        uint8_t keys[8 * PK_LEN_25519];
+        crypto_extractPublicKeys(0, 8, keys, sizeof(keys));
+        bench::doNotOptimize(keys);
+    });
+
+    runner.run("sign/pubkeys_x8/single", 0, [&] {
+        uint8_t publicKey[PK_LEN_25519];
+        for (uint32_t account = 0; account < 8; account++) {
+            setAccount(account);
+            key_cache_reset();
+            crypto_extractPublicKey(publicKey, sizeof(publicKey));
+            bench::doNotOptimize(publicKey);
+        }
+        setAccount(0);
+    });
+
+    runner.run("sign/ed25519_sign_payment/cold", sizeof(payment_tx), [&] {
+        uint8_t signature[ED25519_SIGNATURE_SIZE];
+        key_cache_reset();
+        crypto_sign(signature, sizeof(signature), payment_tx, sizeof(payment_tx));
+        bench::doNotOptimize(signature);
+    });
+
+    runner.run("sign/ed25519_sign_payment/cached", sizeof(payment_tx), [&] {
+        uint8_t signature[ED25519_SIGNATURE_SIZE];
+        crypto_sign(signature, sizeof(signature), payment_tx, sizeof(payment_tx));
+        bench::doNotOptimize(signature);
+    });
+
+    // What the device does between receiving the last chunk and returning the signature
+    runner.run("sign/full_flow_payment", sizeof(payment_tx), [&] {
+        key_cache_reset();
+        parser_context_t ctx;
+        parser_tx_t tx;
+        memset(&ctx, 0, sizeof(ctx));
+        memset(&tx, 0, sizeof(tx));
+        ctx.content = MsgPack;
+
+        if (parser_parse(&ctx, payment_tx + 2, sizeof(payment_tx) - 2, &tx, MsgPack) != parser_ok ||
+            parser_validate(&ctx) != parser_ok) {
+            return;
+        }
+
+        uint8_t numItems = 0;
+        parser_getNumItems(&numItems);
+        char key[40];
+        char value[40];
+        for (uint8_t idx = 0; idx < numItems; idx++) {
+            uint8_t pageCount = 1;
+            for (uint8_t page = 0; page < pageCount; page++) {
+                parser_getItem(&ctx, idx, key, sizeof(key), value, sizeof(value), page, &pageCount);
+            }
+        }
+
+        uint8_t signature[ED25519_SIGNATURE_SIZE];
+        crypto_sign(signature, sizeof(signature), payment_tx, sizeof(payment_tx));
+        bench::doNotOptimize(signature);
+    });
+
+    key_cache_reset();
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include "profile.h"
+
+namespace {
+    constexpr double MIN_RUNTIME_SEC = 0.2;
+    constexpr uint64_t MAX_ITERATIONS = 1ULL << 30;
+
+    std::vector<std::pair<const char *, bench::bench_fn>> &registry() {
+        static std::vector<std::pair<const char *, bench::bench_fn>> groups;
+        return groups;
+    }
+}
+
+namespace bench {
+    Registrar::Registrar(const char *group, bench_fn fn) {
+        registry().emplace_back(group, fn);
+    }
+
+    bool Runner::selected(const std::string &name) const {
+        if (filters_.empty()) {
+            return true;
+        }
+        for (const auto &filter : filters_) {
+            if (name.find(filter) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Runner::run(const std::string &name, uint64_t bytesPerOp, const std::function<void()> &body) {
+        if (!selected(name)) {
+            return;
+        }
+
+        uint64_t iterations = 1;
+        double elapsed = 0;
+        while (true) {
+            const auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < iterations; i++) {
+                body();
+            }
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= MIN_RUNTIME_SEC || iterations >= MAX_ITERATIONS) {
+                break;
+            }
+            // Aim a little past the target so the next round is usually the last one
+            const double scale = elapsed > 0 ? (MIN_RUNTIME_SEC * 1.2) / elapsed : 100.0;
+            iterations = static_cast<uint64_t>(static_cast<double>(iterations) * (scale > 100.0 ? 100.0 : scale)) + 1;
+        }
+
+        const double nsPerOp = elapsed * 1e9 / static_cast<double>(iterations);
+        if (bytesPerOp > 0) {
+            const double mbPerSec = static_cast<double>(bytesPerOp) * static_cast<double>(iterations) / elapsed / 1e6;
+            printf("%-56s %12.1f ns/op %10.1f MB/s %12llu iter\n", name.c_str(), nsPerOp, mbPerSec,
+                   static_cast<unsigned long long>(iterations));
+        } else {
+            printf("%-56s %12.1f ns/op %10s      %12llu iter\n", name.c_str(), nsPerOp, "",
+                   static_cast<unsigned long long>(iterations));
+        }
+        fflush(stdout);
+
+        if (profile_) {
+            char json[1024];
+            profile_reset();
+            body();
+            if (profile_to_json(json, sizeof(json)) > 0) {
+                profiles_.emplace_back(name, json);
+            }
+        }
+    }
+
+    std::string Runner::profileJson() const {
+        std::string out = "{";
+        for (const auto &entry : profiles_) {
+            out += (out.size() > 1 ? ",\n\"" : "\n\"") + entry.first + "\":" + entry.second;
+        }
+        return out + "\n}\n";
+    }
+}
+
+// benchmarks [--profile FILE] [filter ...]
+int main(int argc, char **argv) {
+    std::vector<std::string> filters;
+    const char *profilePath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else {
+            filters.emplace_back(argv[i]);
+        }
+    }
+
+    bench::Runner runner(filters, profilePath != nullptr);
+    for (const auto &group : registry()) {
+        group.second(runner);
+    }
+
+    if (profilePath != nullptr) {
+        FILE *file = fopen(profilePath, "w");
+        if (file == nullptr) {
+            fprintf(stderr, "%s: cannot create\n", profilePath);
+            return 1;
+        }
+        fputs(runner.profileJson().c_str(), file);
+        fclose(file);
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+# Records the APDUs exchanged with a ledgerblue dongle as an apdu_harness trace
+# (see tools/apdu_harness/session.h), so device sessions can be replayed on the host.
+
+import struct
+import time
+
+from ledgerblue.commException import CommException
+
+MAGIC = b"APDUTRC1"
+
+
+class TraceRecorder(object):
+  def __init__(self, dongle, path):
+    self.dongle = dongle
+    self.out = open(path, "wb")
+    self.out.write(MAGIC)
+    self.start = time.time()
+
+  def _record(self, kind, data):
+    ts = int((time.time() - self.start) * 1000000)
+    self.out.write(kind + struct.pack(">QH", ts, len(data)) + bytes(data))
+
+  def exchange(self, apdu, timeout=20000):
+    self._record(b"C", apdu)
+    try:
+      reply = self.dongle.exchange(apdu, timeout)
+    except CommException as comm:
+      self._record(b"R", bytearray(comm.data or b"") + struct.pack(">H", comm.sw))
+      raise
+    # ledgerblue strips the status word of successful replies
+    self._record(b"R", bytearray(reply) + b"\x90\x00")
+    return reply
+
+  def end_transaction(self):
+    self._record(b"E", b"")
+
+  def close(self):
+    self.out.close()
+    self.dongle.close()
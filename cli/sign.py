@@ -10,14 +10,19 @@ import sys
 import os
 import struct
 import algomsgpack
+from apdu_trace import TraceRecorder
 
 def checksummed(pk):
   sum = sha512_256.new(str(pk)).digest()
   return base64.b32encode(pk + sum[28:32]).replace("=", "")
 
 dongle = getDongle(debug=False)
+if os.environ.get("APDU_TRACE"):
+  dongle = TraceRecorder(dongle, os.environ["APDU_TRACE"])
 
 publicKey = dongle.exchange(bytes("8003000000".decode('hex')))
+if isinstance(dongle, TraceRecorder):
+  dongle.end_transaction()
 print "Ledger app address:", checksummed(publicKey)
 
 if len(sys.argv) != 3:
@@ -61,6 +66,9 @@ try:
     tosend = tosend[len(thischunk):]
     p1 = 0x80
 
+  if isinstance(dongle, TraceRecorder):
+    dongle.end_transaction()
+
   if len(signature) > 64:
     raise Exception("Error: %s" % signature[65:])
 
@@ -64,15 +64,6 @@ void secure_wipe(uint8_t *v, uint32_t n) {
 #endif
 }
 
-/*
- * SHA-512 context structure
- */
-typedef struct {
-    uint64_t total[2];         /*!< number of bytes processed  */
-    uint64_t state[8];         /*!< intermediate digest state  */
-    unsigned char buffer[128]; /*!< data block being processed */
-} mbedtls_sha512_context;
-
 /*
  * 64-bit integer manipulation macros (big endian)
  */
@@ -107,27 +98,24 @@ static void mbedtls_sha512_init(mbedtls_sha512_context *ctx) {
 /*
  * SHA-512 context setup
  */
-static void mbedtls_sha512_starts(mbedtls_sha512_context *ctx) {
+static const uint64_t sha512_iv[8] = {
+    UL64(0x6A09E667F3BCC908), UL64(0xBB67AE8584CAA73B),
+    UL64(0x3C6EF372FE94F82B), UL64(0xA54FF53A5F1D36F1),
+    UL64(0x510E527FADE682D1), UL64(0x9B05688C2B3E6C1F),
+    UL64(0x1F83D9ABFB41BD6B), UL64(0x5BE0CD19137E2179),
+};
+
+static const uint64_t sha512_256_iv[8] = {
+    UL64(0x22312194fc2bf72c), UL64(0x9f555fa3c84c64c2),
+    UL64(0x2393b86b6f53b151), UL64(0x963877195940eabd),
+    UL64(0x96283ee2a88effe3), UL64(0xbe5e1e2553863992),
+    UL64(0x2b0199fc2c85b8aa), UL64(0x0eb72ddc81c52ca2),
+};
+
+static void mbedtls_sha512_starts(mbedtls_sha512_context *ctx, const uint64_t iv[8]) {
     ctx->total[0] = 0;
     ctx->total[1] = 0;
-
-//    ctx->state[0] = UL64(0x6A09E667F3BCC908);
-//    ctx->state[1] = UL64(0xBB67AE8584CAA73B);
-//    ctx->state[2] = UL64(0x3C6EF372FE94F82B);
-//    ctx->state[3] = UL64(0xA54FF53A5F1D36F1);
-//    ctx->state[4] = UL64(0x510E527FADE682D1);
-//    ctx->state[5] = UL64(0x9B05688C2B3E6C1F);
-//    ctx->state[6] = UL64(0x1F83D9ABFB41BD6B);
-//    ctx->state[7] = UL64(0x5BE0CD19137E2179);
-
-    ctx->state[0] = UL64(0x22312194fc2bf72c);
-    ctx->state[1] = UL64(0x9f555fa3c84c64c2);
-    ctx->state[2] = UL64(0x2393b86b6f53b151);
-    ctx->state[3] = UL64(0x963877195940eabd);
-    ctx->state[4] = UL64(0x96283ee2a88effe3);
-    ctx->state[5] = UL64(0xbe5e1e2553863992);
-    ctx->state[6] = UL64(0x2b0199fc2c85b8aa);
-    ctx->state[7] = UL64(0x0eb72ddc81c52ca2);
+    memcpy(ctx->state, iv, sizeof(ctx->state));
 }
 
 /*
@@ -328,7 +316,7 @@ void SHA512_256(const uint8_t *in, size_t n, uint8_t out[SHA512_DIGEST_LENGTH])
     mbedtls_sha512_context ctx;
 
     mbedtls_sha512_init(&ctx);
-    mbedtls_sha512_starts(&ctx);
+    mbedtls_sha512_starts(&ctx, sha512_256_iv);
     mbedtls_sha512_update(&ctx, in, n);
     mbedtls_sha512_finish(&ctx, out);
     secure_wipe((uint8_t *) &ctx, sizeof(ctx));
@@ -340,10 +328,40 @@ void SHA512_256_with_context_version(const uint8_t *in_ctx, size_t n_ctx,
     mbedtls_sha512_context ctx;
 
     mbedtls_sha512_init(&ctx);
-    mbedtls_sha512_starts(&ctx);
+    mbedtls_sha512_starts(&ctx, sha512_256_iv);
     mbedtls_sha512_update(&ctx, in_ctx, n_ctx);
     mbedtls_sha512_update(&ctx, &version, 1);
     mbedtls_sha512_update(&ctx, in, n);
     mbedtls_sha512_finish(&ctx, out);
     secure_wipe((uint8_t *) &ctx, sizeof(ctx));
 }
+
+void SHA512_256_init(mbedtls_sha512_context *ctx) {
+    mbedtls_sha512_init(ctx);
+    mbedtls_sha512_starts(ctx, sha512_256_iv);
+}
+
+void SHA512_init(mbedtls_sha512_context *ctx) {
+    mbedtls_sha512_init(ctx);
+    mbedtls_sha512_starts(ctx, sha512_iv);
+}
+
+void SHA512_update(mbedtls_sha512_context *ctx, const uint8_t *in, size_t n) {
+    mbedtls_sha512_update(ctx, in, n);
+}
+
+void SHA512_final(mbedtls_sha512_context *ctx, uint8_t out[SHA512_DIGEST_LENGTH]) {
+    mbedtls_sha512_finish(ctx, out);
+    secure_wipe((uint8_t *) ctx, sizeof(*ctx));
+}
+
+/*
+ * output = SHA-512( input buffer ), standard initial state
+ */
+void SHA512(const uint8_t *in, size_t n, uint8_t out[SHA512_DIGEST_LENGTH]) {
+    mbedtls_sha512_context ctx;
+
+    SHA512_init(&ctx);
+    mbedtls_sha512_update(&ctx, in, n);
+    SHA512_final(&ctx, out);
+}
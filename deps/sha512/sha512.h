@@ -25,6 +25,15 @@
 
 #define SHA512_DIGEST_LENGTH 64
 
+/*
+ * SHA-512 context structure
+ */
+typedef struct {
+    uint64_t total[2];         /*!< number of bytes processed  */
+    uint64_t state[8];         /*!< intermediate digest state  */
+    unsigned char buffer[128]; /*!< data block being processed */
+} mbedtls_sha512_context;
+
 extern void SHA512_256(const uint8_t* in, size_t n,
                        uint8_t out[SHA512_DIGEST_LENGTH]);
 
@@ -32,6 +41,16 @@ void SHA512_256_with_context_version(const uint8_t *in_ctx, size_t n_ctx,
                                      uint8_t version,
                                      const uint8_t *in, size_t n, uint8_t out[SHA512_DIGEST_LENGTH]);
 
+// Streaming interface. SHA512_256_init and SHA512_init only differ in the
+// initial state; SHA512_final writes the full 64-byte state and wipes ctx.
+void SHA512_256_init(mbedtls_sha512_context *ctx);
+void SHA512_init(mbedtls_sha512_context *ctx);
+void SHA512_update(mbedtls_sha512_context *ctx, const uint8_t *in, size_t n);
+void SHA512_final(mbedtls_sha512_context *ctx, uint8_t out[SHA512_DIGEST_LENGTH]);
+
+extern void SHA512(const uint8_t* in, size_t n,
+                   uint8_t out[SHA512_DIGEST_LENGTH]);
+
 // Zero the memory pointed to by v; this will not be optimized away.
 extern void secure_wipe(uint8_t* v, uint32_t n);
 
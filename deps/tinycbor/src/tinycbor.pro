@@ -1,6 +0,0 @@
-TEMPLATE = lib
-CONFIG += static
-CONFIG -= qt
-DESTDIR = ../lib
-
-include(src.pri)
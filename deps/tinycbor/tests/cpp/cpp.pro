@@ -1,5 +0,0 @@
-CONFIG += testcase parallel_test c++11
-QT = core testlib
-
-SOURCES = tst_cpp.cpp
-INCLUDEPATH += ../../src
@@ -0,0 +1,106 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <hexutils.h>
+#include "common/parser.h"
+#include "parser_txdef.h"
+#include "algo_network.h"
+
+namespace {
+    // Payment of 1000 on TestNet, with genesis ID "testnet-v1.0"
+    const std::string testnetPayment =
+        "89a3616d74cd03e8a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c8"
+        "4ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae690cec2"
+        "a77839a9a36235dd6e2eafba79ca25c0da60f8a3736e64c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba"
+        "79ca25c0da60f8a474797065a3706179";
+    const size_t genesisIdOffset = 26;
+    const size_t genesisHashOffset = 43;
+
+    std::vector<uint8_t> fromHex(const std::string &hex) {
+        std::vector<uint8_t> out(hex.size() / 2);
+        parseHexString(out.data(), static_cast<uint16_t>(out.size()), hex.c_str());
+        return out;
+    }
+
+    parser_error_t parse(const std::vector<uint8_t> &blob, parser_context_t &ctx, parser_tx_t &tx) {
+        memset(&tx, 0, sizeof(tx));
+        CHECK_ERROR(parser_parse(&ctx, blob.data(), blob.size(), &tx, MsgPack))
+        return parser_validate(&ctx);
+    }
+
+    std::map<std::string, std::string> items(parser_context_t &ctx) {
+        std::map<std::string, std::string> out;
+        uint8_t numItems = 0;
+        EXPECT_EQ(parser_getNumItems(&numItems), parser_ok);
+        for (uint8_t idx = 0; idx < numItems; idx++) {
+            char key[40];
+            char value[100];
+            uint8_t pageCount = 0;
+            EXPECT_EQ(parser_getItem(&ctx, idx, key, sizeof(key), value, sizeof(value), 0, &pageCount), parser_ok);
+            out[key] = value;
+        }
+        return out;
+    }
+}
+
+TEST(AlgoNetwork, Lookup) {
+    const std::vector<uint8_t> blob = fromHex(testnetPayment);
+    const algo_network_info_t *network = algo_network_get(blob.data() + genesisHashOffset);
+    ASSERT_NE(network, nullptr);
+    EXPECT_STREQ(network->name, "TestNet");
+    EXPECT_STREQ(network->genesisID, "testnet-v1.0");
+
+    uint8_t unknown[GENESIS_HASH_LEN] = {0};
+    EXPECT_EQ(algo_network_get(unknown), nullptr);
+    EXPECT_EQ(algo_network_get(nullptr), nullptr);
+}
+
+TEST(AlgoNetwork, KnownNetworkShownByName) {
+    const std::vector<uint8_t> blob = fromHex(testnetPayment);
+    parser_context_t ctx;
+    parser_tx_t tx;
+    ASSERT_EQ(parse(blob, ctx, tx), parser_ok);
+
+    const auto shown = items(ctx);
+    EXPECT_EQ(shown.at("Network"), "TestNet");
+    EXPECT_EQ(shown.at("Genesis ID"), "testnet-v1.0");
+    EXPECT_EQ(shown.count("Genesis hash"), 0u);
+}
+
+TEST(AlgoNetwork, UnknownNetworkShowsHash) {
+    std::vector<uint8_t> blob = fromHex(testnetPayment);
+    blob[genesisHashOffset] ^= 0xFF;
+    parser_context_t ctx;
+    parser_tx_t tx;
+    ASSERT_EQ(parse(blob, ctx, tx), parser_ok);
+
+    const auto shown = items(ctx);
+    EXPECT_EQ(shown.at("Genesis hash"), "t2O1GKSzyE7IEPItTxCByw9x8FmnrCDexi9/cOUJOiI=");
+    EXPECT_EQ(shown.count("Network"), 0u);
+}
+
+TEST(AlgoNetwork, GenesisIdMustMatchKnownHash) {
+    std::vector<uint8_t> blob = fromHex(testnetPayment);
+    memcpy(blob.data() + genesisIdOffset, "mainnet", 7);
+    parser_context_t ctx;
+    parser_tx_t tx;
+    EXPECT_EQ(parse(blob, ctx, tx), parser_unexpected_chain);
+}
@@ -0,0 +1,128 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include <zxformat.h>
+#include "coin.h"
+#include "parser_encoding.h"
+
+namespace {
+    // The uint64_to_str / intstr_to_fpstr_inplace / z_str3join / number_inplace_trimming
+    // pipeline that _toStringBalance used before _formatAmount
+    std::string legacyFormat(uint64_t amount, uint8_t decimalPlaces, const char *prefix) {
+        char bufferUI[200] = {0};
+        if (uint64_to_str(bufferUI, sizeof(bufferUI), amount) != NULL ||
+            intstr_to_fpstr_inplace(bufferUI, sizeof(bufferUI), decimalPlaces) == 0 ||
+            z_str3join(bufferUI, sizeof(bufferUI), prefix, "") != zxerr_ok) {
+            return "<error>";
+        }
+        number_inplace_trimming(bufferUI, 1);
+        return bufferUI;
+    }
+
+    std::string format(uint64_t amount, uint8_t decimalPlaces, const char *prefix) {
+        char out[MAX_AMOUNT_STR_LEN];
+        if (_formatAmount(out, sizeof(out), amount, decimalPlaces, prefix, "") == 0) {
+            return "<error>";
+        }
+        return out;
+    }
+
+    // Every digit count, with and without trailing zeros, around each power of ten
+    std::vector<uint64_t> amounts() {
+        std::vector<uint64_t> values = {0, 1, 9, 10, 11, 99, 100, 101, UINT64_MAX, UINT64_MAX - 1};
+        uint64_t power = 1;
+        for (uint8_t exp = 0; exp < 20; exp++) {
+            values.push_back(power - 1);
+            values.push_back(power);
+            values.push_back(power + 1);
+            for (uint64_t lead = 2; lead <= 9 && power <= UINT64_MAX / lead; lead++) {
+                values.push_back(lead * power);
+                values.push_back(lead * power + 5);
+            }
+            if (exp < 19) {
+                power *= 10;
+            }
+        }
+
+        // splitmix64, with a random number of trailing zeros
+        uint64_t state = 0x5eed;
+        for (int i = 0; i < 100000; i++) {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            z ^= z >> 31;
+            uint64_t value = z >> (z % 64);
+            for (uint64_t zeros = z % 7; zeros > 0 && value <= UINT64_MAX / 10; zeros--) {
+                value *= 10;
+            }
+            values.push_back(value);
+        }
+        return values;
+    }
+}
+
+TEST(AmountFormat, MatchesLegacyPipeline) {
+    const char *prefixes[] = {"", COIN_TICKER, "Base unit ", "USD-MESE ", "LTBX "};
+    const std::vector<uint64_t> values = amounts();
+
+    for (uint8_t decimals = 0; decimals <= 19; decimals++) {
+        for (const char *prefix : prefixes) {
+            for (const uint64_t value : values) {
+                ASSERT_EQ(format(value, decimals, prefix), legacyFormat(value, decimals, prefix))
+                    << value << " with " << (int) decimals << " decimals";
+            }
+        }
+    }
+}
+
+TEST(AmountFormat, Examples) {
+    EXPECT_EQ(format(0, 6, COIN_TICKER), "ALGO 0.0");
+    EXPECT_EQ(format(1000, 6, COIN_TICKER), "ALGO 0.001");
+    EXPECT_EQ(format(1234567, 6, COIN_TICKER), "ALGO 1.234567");
+    EXPECT_EQ(format(5000000, 6, COIN_TICKER), "ALGO 5.0");
+    EXPECT_EQ(format(42, 0, "Base unit "), "Base unit 42");
+    EXPECT_EQ(format(UINT64_MAX, 19, ""), "1.8446744073709551615");
+    EXPECT_EQ(format(1, 19, ""), "0.0000000000000000001");
+
+    char out[MAX_AMOUNT_STR_LEN];
+    EXPECT_EQ(_formatAmount(out, sizeof(out), 25, 1, "", " units"), 9u);
+    EXPECT_STREQ(out, "2.5 units");
+}
+
+TEST(AmountFormat, TooSmallBuffer) {
+    char out[9];
+    EXPECT_EQ(_formatAmount(out, sizeof(out), 1234567, 6, "", ""), 8u);
+    EXPECT_EQ(_formatAmount(out, sizeof(out), 1234567, 6, COIN_TICKER, ""), 0u);
+    EXPECT_EQ(_formatAmount(out, sizeof(out), 123456789, 0, "", ""), 0u);
+    EXPECT_EQ(_formatAmount(out, 0, 1, 0, "", ""), 0u);
+}
+
+TEST(AmountFormat, ToStringBalancePages) {
+    uint64_t amount = 123456789012345;
+    char page[8];
+    uint8_t pageCount = 0;
+    std::string joined;
+    for (uint8_t idx = 0; idx == 0 || idx < pageCount; idx++) {
+        ASSERT_EQ(_toStringBalance(&amount, 6, "", COIN_TICKER, page, sizeof(page), idx, &pageCount), parser_ok);
+        joined += page;
+    }
+    EXPECT_EQ(pageCount, 3);
+    EXPECT_EQ(joined, "ALGO 123456789.012345");
+}
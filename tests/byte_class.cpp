@@ -0,0 +1,137 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "gmock/gmock.h"
+
+#include <random>
+#include <vector>
+#include "byte_class.h"
+
+using namespace std;
+
+namespace {
+    bool inRangeReference(const vector<uint8_t> &data, size_t offset, size_t len, uint8_t lo, uint8_t hi) {
+        for (size_t i = offset; i < offset + len; i++) {
+            if (data[i] < lo || data[i] > hi) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    vector<byte_class_backend_e> availableBackends() {
+        vector<byte_class_backend_e> backends;
+        for (const byte_class_backend_e backend : {byte_class_backend_portable, byte_class_backend_sse2, byte_class_backend_avx2}) {
+            if (byte_class_set_backend(backend) == zxerr_ok) {
+                backends.push_back(backend);
+            }
+        }
+        return backends;
+    }
+
+    const pair<uint8_t, uint8_t> ranges[] = {{0x20, 0x7E}, {0x00, 0x7F}, {0x30, 0x39}, {0x00, 0x00}, {0x80, 0xFF}, {0x00, 0xFF}};
+}
+
+// Every length up to a few vector blocks, at every alignment, with one offending byte at each position
+TEST(ByteClass, InRangeMatchesReference) {
+    const byte_class_backend_e initial = byte_class_get_backend();
+    mt19937 rng(46);
+
+    for (const byte_class_backend_e backend : availableBackends()) {
+        ASSERT_EQ(byte_class_set_backend(backend), zxerr_ok);
+        for (const auto &range : ranges) {
+            const uint8_t lo = range.first;
+            const uint8_t hi = range.second;
+            uniform_int_distribution<int> inside(lo, hi);
+
+            for (size_t len = 0; len <= 300; len += (len < 70 ? 1 : 23)) {
+                for (size_t offset = 0; offset < 8; offset++) {
+                    vector<uint8_t> data(offset + len);
+                    for (uint8_t &b : data) {
+                        b = (uint8_t) inside(rng);
+                    }
+                    ASSERT_TRUE(bytes_in_range(data.data() + offset, len, lo, hi)) << backend << " " << len;
+
+                    for (size_t bad = 0; bad < len; bad++) {
+                        if (lo == 0x00 && hi == 0xFF) {
+                            break;
+                        }
+                        // Alternate between bytes below lo and above hi when both exist
+                        const bool below = lo > 0 && (bad % 2 == 0 || hi == 0xFF);
+                        const uint8_t saved = data[offset + bad];
+                        data[offset + bad] = below ? (uint8_t) (bad % lo) : (uint8_t) (0xFF - bad % (0xFF - hi));
+                        ASSERT_FALSE(bytes_in_range(data.data() + offset, len, lo, hi)) << backend << " " << len << " " << bad;
+                        data[offset + bad] = saved;
+                    }
+                }
+            }
+        }
+    }
+
+    byte_class_set_backend(initial);
+}
+
+TEST(ByteClass, RandomBuffers) {
+    const byte_class_backend_e initial = byte_class_get_backend();
+    mt19937 rng(7);
+
+    for (const byte_class_backend_e backend : availableBackends()) {
+        ASSERT_EQ(byte_class_set_backend(backend), zxerr_ok);
+        for (int round = 0; round < 2000; round++) {
+            vector<uint8_t> data(rng() % 600);
+            const uint8_t mask = (uint8_t) rng();
+            for (uint8_t &b : data) {
+                b = (uint8_t) rng() & mask;
+            }
+            for (const auto &range : ranges) {
+                ASSERT_EQ(bytes_in_range(data.data(), data.size(), range.first, range.second),
+                          inRangeReference(data, 0, data.size(), range.first, range.second));
+            }
+        }
+    }
+
+    byte_class_set_backend(initial);
+}
+
+TEST(ByteClass, AllZero) {
+    const byte_class_backend_e initial = byte_class_get_backend();
+
+    for (const byte_class_backend_e backend : availableBackends()) {
+        ASSERT_EQ(byte_class_set_backend(backend), zxerr_ok);
+        for (size_t len = 0; len <= 200; len++) {
+            for (size_t offset = 0; offset < 8; offset++) {
+                vector<uint8_t> data(offset + len + 8, 0xFF);
+                fill(data.begin() + offset, data.begin() + offset + len, 0);
+                ASSERT_TRUE(bytes_all_zero(data.data() + offset, len)) << backend << " " << len;
+                for (size_t bad = 0; bad < len; bad++) {
+                    data[offset + bad] = (uint8_t) (1 << (bad % 8));
+                    ASSERT_FALSE(bytes_all_zero(data.data() + offset, len)) << backend << " " << len << " " << bad;
+                    data[offset + bad] = 0;
+                }
+            }
+        }
+    }
+
+    byte_class_set_backend(initial);
+}
+
+TEST(ByteClass, EmptyAndInvertedRanges) {
+    const uint8_t data[] = {'a', 'b'};
+    EXPECT_TRUE(bytes_in_range(nullptr, 0, 0x20, 0x7E));
+    EXPECT_TRUE(bytes_all_zero(nullptr, 0));
+    EXPECT_TRUE(bytes_in_range(data, 0, 0x7E, 0x20));
+    EXPECT_FALSE(bytes_in_range(data, sizeof(data), 0x7E, 0x20));
+    EXPECT_TRUE(bytes_printable(data, sizeof(data)));
+}
@@ -0,0 +1,193 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include <hexutils.h>
+#include <zxformat.h>
+#include "coin.h"
+#include "crypto.h"
+#include "crypto_utils.h"
+#include "ed25519.h"
+
+using namespace std;
+
+namespace {
+    vector<uint8_t> fromHex(const string &hex) {
+        vector<uint8_t> out(hex.size() / 2);
+        parseHexString(out.data(), (uint16_t) out.size(), hex.c_str());
+        return out;
+    }
+
+    string toHex(const uint8_t *data, size_t len) {
+        string out(2 * len + 1, '\0');
+        array_to_hexstr(&out[0], out.size(), data, (uint16_t) len);
+        out.resize(2 * len);
+        return out;
+    }
+
+    void setAccount(uint32_t account) {
+        hdPath[0] = HDPATH_0_DEFAULT;
+        hdPath[1] = HDPATH_1_DEFAULT;
+        hdPath[2] = HDPATH_2_DEFAULT | account;
+        hdPath[3] = HDPATH_3_DEFAULT;
+        hdPath[4] = HDPATH_4_DEFAULT;
+    }
+}
+
+TEST(Ed25519, Rfc8032Vectors) {
+    struct {
+        string seed;
+        string publicKey;
+        string message;
+        string signature;
+    } vectors[] = {
+        {"9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+         "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+         "",
+         "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"},
+        {"4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+         "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+         "72",
+         "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"},
+    };
+
+    for (const auto &tc : vectors) {
+        const auto seed = fromHex(tc.seed);
+        const auto message = fromHex(tc.message);
+
+        uint8_t publicKey[ED25519_PUBLIC_KEY_SIZE];
+        ed25519_publickey(publicKey, seed.data());
+        EXPECT_EQ(toHex(publicKey, sizeof(publicKey)), tc.publicKey);
+
+        uint8_t signature[ED25519_SIG_SIZE];
+        ed25519_sign(signature, message.data(), message.size(), seed.data(), publicKey);
+        EXPECT_EQ(toHex(signature, sizeof(signature)), tc.signature);
+        EXPECT_TRUE(ed25519_verify(signature, message.data(), message.size(), publicKey));
+
+        signature[10] ^= 0x01;
+        EXPECT_FALSE(ed25519_verify(signature, message.data(), message.size(), publicKey));
+    }
+}
+
+TEST(CryptoHost, DerivationMatchesDevice) {
+    // Public keys reported by the device for the Zemu test mnemonic
+    const struct {
+        uint32_t account;
+        string publicKey;
+    } vectors[] = {
+        {0, "1eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8"},
+        {123, "0dfdbcdb8eebed628cfb4ef70207b86fd0deddca78e90e8c59d6f441e383b377"},
+    };
+
+    for (const auto &tc : vectors) {
+        setAccount(tc.account);
+        uint8_t publicKey[PK_LEN_25519];
+        ASSERT_EQ(crypto_extractPublicKey(publicKey, sizeof(publicKey)), zxerr_ok);
+        EXPECT_EQ(toHex(publicKey, sizeof(publicKey)), tc.publicKey);
+    }
+
+    setAccount(123);
+    uint8_t buffer[PK_LEN_25519 + 2 * PK_LEN_25519 + 1];
+    uint16_t responseLen = 0;
+    ASSERT_EQ(crypto_fillAddress(buffer, sizeof(buffer), &responseLen), zxerr_ok);
+    EXPECT_EQ(string((const char *) buffer + PK_LEN_25519, responseLen - PK_LEN_25519),
+              "BX63ZW4O5PWWFDH3J33QEB5YN7IN5XOKPDUQ5DCZ232EDY4DWN3XKUQRCA");
+}
+
+TEST(CryptoHost, SignTransactionVerifies) {
+    // "TX" || msgpack, as buffered by the app before signing
+    const vector<uint8_t> message = fromHex(
+        "5458"
+        "88a3616d74cd03e8a3666565cd03e8a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f10"
+        "81cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae6"
+        "90cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a3736e64c4201eccfd1ec05e4125fae690ce"
+        "c2a77839a9a36235dd6e2eafba79ca25c0da60f8a474797065a3706179");
+
+    setAccount(0);
+    uint8_t publicKey[PK_LEN_25519];
+    ASSERT_EQ(crypto_extractPublicKey(publicKey, sizeof(publicKey)), zxerr_ok);
+
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    ASSERT_EQ(crypto_sign(signature, sizeof(signature), message.data(), (uint16_t) message.size()), zxerr_ok);
+    EXPECT_TRUE(ed25519_verify(signature, message.data(), message.size(), publicKey));
+
+    setAccount(123);
+    uint8_t otherKey[PK_LEN_25519];
+    ASSERT_EQ(crypto_extractPublicKey(otherKey, sizeof(otherKey)), zxerr_ok);
+    EXPECT_FALSE(ed25519_verify(signature, message.data(), message.size(), otherKey));
+}
+
+TEST(CryptoHost, TxidOfSignedBuffer) {
+    const vector<uint8_t> message = fromHex(
+        "5458"
+        "88a3616d74cd03e8a3666565cd03e8a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f10"
+        "81cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae6"
+        "90cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a3736e64c4201eccfd1ec05e4125fae690ce"
+        "c2a77839a9a36235dd6e2eafba79ca25c0da60f8a474797065a3706179");
+
+    // ZN6WKA5IHJTB2QY5OQHV7MZF5CKUY6DW3JU5Z2IU5W7SMJUAC6JQ
+    uint8_t txid[TXID_LEN];
+    ASSERT_EQ(crypto_txid(message.data(), (uint16_t) message.size(), txid, sizeof(txid)), zxerr_ok);
+    EXPECT_EQ(toHex(txid, sizeof(txid)), "cb7d6503a83a661d431d740f5fb325e8954c7876da69dce914edbf2626801793");
+
+    EXPECT_EQ(crypto_txid(message.data(), (uint16_t) message.size(), txid, sizeof(txid) - 1), zxerr_unknown);
+}
+
+TEST(CryptoHost, SignArbitraryDataVerifies) {
+    const string data = R"({"type":"arc60.create","challenge":"eSZVsYmvNCjJGH5a9WWIjKp5jm5DFxlwBBAw9zc8FZM="})";
+    const vector<uint8_t> authData = fromHex("49960de5880e8c687434170f6476605b8fe4aeb9a28632c7995cf3ba831d97630500000000");
+
+    setAccount(0);
+    uint8_t publicKey[PK_LEN_25519];
+    ASSERT_EQ(crypto_extractPublicKey(publicKey, sizeof(publicKey)), zxerr_ok);
+
+    uint8_t message[2 * SHA256_DIGEST_SIZE];
+    ASSERT_EQ(crypto_sha256((const uint8_t *) data.data(), (uint16_t) data.size(), message, SHA256_DIGEST_SIZE), zxerr_ok);
+    ASSERT_EQ(crypto_sha256(authData.data(), (uint16_t) authData.size(), message + SHA256_DIGEST_SIZE, SHA256_DIGEST_SIZE), zxerr_ok);
+
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    ASSERT_EQ(crypto_signArbitraryData(signature, sizeof(signature), message, message + SHA256_DIGEST_SIZE), zxerr_ok);
+    EXPECT_TRUE(ed25519_verify(signature, message, sizeof(message), publicKey));
+    EXPECT_EQ(crypto_signArbitraryData(signature, sizeof(signature), message, nullptr), zxerr_unknown);
+}
+
+TEST(CryptoHost, BulkPublicKeysMatchSingleDerivation) {
+    const uint32_t firstAccount = 120;
+    const uint8_t count = 8;
+    uint8_t keys[count * PK_LEN_25519];
+    ASSERT_EQ(crypto_extractPublicKeys(firstAccount, count, keys, sizeof(keys)), zxerr_ok);
+
+    for (uint8_t i = 0; i < count; i++) {
+        setAccount(firstAccount + i);
+        uint8_t publicKey[PK_LEN_25519];
+        ASSERT_EQ(crypto_extractPublicKey(publicKey, sizeof(publicKey)), zxerr_ok);
+        EXPECT_EQ(toHex(keys + i * PK_LEN_25519, PK_LEN_25519), toHex(publicKey, sizeof(publicKey))) << "account " << firstAccount + i;
+    }
+    EXPECT_EQ(toHex(keys + 3 * PK_LEN_25519, PK_LEN_25519),
+              "0dfdbcdb8eebed628cfb4ef70207b86fd0deddca78e90e8c59d6f441e383b377");
+}
+
+TEST(CryptoHost, BulkPublicKeysRejectsBadRanges) {
+    uint8_t keys[2 * PK_LEN_25519];
+    EXPECT_EQ(crypto_extractPublicKeys(0, 0, keys, sizeof(keys)), zxerr_invalid_crypto_settings);
+    EXPECT_EQ(crypto_extractPublicKeys(0, 3, keys, sizeof(keys)), zxerr_invalid_crypto_settings);
+    EXPECT_EQ(crypto_extractPublicKeys(0x7FFFFFFF, 2, keys, sizeof(keys)), zxerr_invalid_crypto_settings);
+    EXPECT_EQ(crypto_extractPublicKeys(0x80000000, 1, keys, sizeof(keys)), zxerr_invalid_crypto_settings);
+    EXPECT_EQ(crypto_extractPublicKeys(0x7FFFFFFF, 1, keys, sizeof(keys)), zxerr_ok);
+}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include <zxformat.h>
+#include "coin.h"
+#include "crypto_utils.h"
+#include "crypto_sha256_shani.h"
+
+using namespace std;
+
+namespace {
+    struct sha256_vector_t {
+        string message;
+        string digest;
+    };
+
+    const vector<sha256_vector_t> vectors = {
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+         "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    };
+
+    string digestHex(const uint8_t *digest) {
+        char hex[2 * SHA256_DIGEST_SIZE + 1] = {0};
+        array_to_hexstr(hex, sizeof(hex), digest, SHA256_DIGEST_SIZE);
+        return string(hex);
+    }
+
+    vector<crypto_sha256_backend_e> availableBackends() {
+        vector<crypto_sha256_backend_e> backends = {crypto_sha256_backend_portable};
+        if (sha256_shani_supported()) {
+            backends.push_back(crypto_sha256_backend_shani);
+        }
+        return backends;
+    }
+}
+
+TEST(SHA256, KnownVectors) {
+    const crypto_sha256_backend_e initial = crypto_sha256_get_backend();
+
+    for (const auto backend : availableBackends()) {
+        ASSERT_EQ(crypto_sha256_set_backend(backend), zxerr_ok);
+        for (const auto &tc : vectors) {
+            uint8_t digest[SHA256_DIGEST_SIZE] = {0};
+            ASSERT_EQ(crypto_sha256((const uint8_t *) tc.message.data(), (uint16_t) tc.message.size(),
+                                    digest, sizeof(digest)), zxerr_ok);
+            EXPECT_EQ(digestHex(digest), tc.digest) << "backend " << backend << " message '" << tc.message << "'";
+        }
+    }
+
+    crypto_sha256_set_backend(initial);
+}
+
+TEST(SHA256, StreamingMatchesOneShot) {
+    const crypto_sha256_backend_e initial = crypto_sha256_get_backend();
+
+    vector<uint8_t> message(3000);
+    for (size_t i = 0; i < message.size(); i++) {
+        message[i] = (uint8_t) (i * 31 + 7);
+    }
+
+    ASSERT_EQ(crypto_sha256_set_backend(crypto_sha256_backend_portable), zxerr_ok);
+
+    // Every length around the block and padding boundaries, hashed in uneven pieces
+    for (size_t len = 0; len < 300; len++) {
+        uint8_t expected[SHA256_DIGEST_SIZE] = {0};
+        ASSERT_EQ(crypto_sha256_set_backend(crypto_sha256_backend_portable), zxerr_ok);
+        ASSERT_EQ(crypto_sha256(message.data(), (uint16_t) len, expected, sizeof(expected)), zxerr_ok);
+
+        for (const auto backend : availableBackends()) {
+            ASSERT_EQ(crypto_sha256_set_backend(backend), zxerr_ok);
+            for (size_t step : {1, 3, 63, 64, 65}) {
+                crypto_sha256_ctx_t ctx;
+                ASSERT_EQ(crypto_sha256_init(&ctx), zxerr_ok);
+                for (size_t off = 0; off < len; off += step) {
+                    const size_t n = min(step, len - off);
+                    ASSERT_EQ(crypto_sha256_update(&ctx, message.data() + off, (uint32_t) n), zxerr_ok);
+                }
+                uint8_t digest[SHA256_DIGEST_SIZE] = {0};
+                ASSERT_EQ(crypto_sha256_final(&ctx, digest, sizeof(digest)), zxerr_ok);
+                EXPECT_EQ(digestHex(digest), digestHex(expected)) << "backend " << backend << " len " << len << " step " << step;
+            }
+        }
+    }
+
+    crypto_sha256_set_backend(initial);
+}
+
+TEST(SHA256, RejectsShortDigestBuffer) {
+    crypto_sha256_ctx_t ctx;
+    uint8_t digest[SHA256_DIGEST_SIZE - 1] = {0};
+    ASSERT_EQ(crypto_sha256_init(&ctx), zxerr_ok);
+    EXPECT_EQ(crypto_sha256_final(&ctx, digest, sizeof(digest)), zxerr_unknown);
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include "delta.h"
+
+using namespace std;
+
+namespace {
+    typedef vector<uint8_t> bytes;
+
+    bytes rebuilt;
+    size_t sinkCapacity = SIZE_MAX;
+
+    uint32_t sink(unsigned char *buffer, uint32_t length) {
+        const uint32_t take = (uint32_t) min<size_t>(length, sinkCapacity - rebuilt.size());
+        rebuilt.insert(rebuilt.end(), buffer, buffer + take);
+        return take;
+    }
+
+    void copyOp(bytes &ops, uint16_t offset, uint16_t length) {
+        ops.insert(ops.end(), {DELTA_OP_COPY, (uint8_t) (offset >> 8), (uint8_t) offset,
+                               (uint8_t) (length >> 8), (uint8_t) length});
+    }
+
+    void insertOp(bytes &ops, const string &literal) {
+        ops.insert(ops.end(), {DELTA_OP_INSERT, (uint8_t) (literal.size() >> 8), (uint8_t) literal.size()});
+        ops.insert(ops.end(), literal.begin(), literal.end());
+    }
+
+    zxerr_t run(const string &reference, const bytes &ops, size_t split) {
+        delta_state_t state;
+        rebuilt.clear();
+        delta_init(&state, (const uint8_t *) reference.data(), (uint16_t) reference.size());
+        CHECK_ZXERR(delta_apply(&state, ops.data(), (uint32_t) split, sink))
+        CHECK_ZXERR(delta_apply(&state, ops.data() + split, (uint32_t) (ops.size() - split), sink))
+        return delta_finish(&state);
+    }
+}
+
+TEST(Delta, RebuildsAcrossChunkBoundaries) {
+    const string reference = "amt:1000;fv:500;lv:1500;rcv:AAAA;snd:BBBB";
+    const string expected = "amt:2500;fv:500;lv:1500;rcv:CCCC;snd:BBBB";
+
+    bytes ops;
+    copyOp(ops, 0, 4);
+    insertOp(ops, "2500");
+    copyOp(ops, 8, 20);
+    insertOp(ops, "CCCC");
+    copyOp(ops, 32, 9);
+
+    for (size_t split = 0; split <= ops.size(); split++) {
+        ASSERT_EQ(run(reference, ops, split), zxerr_ok) << "split " << split;
+        EXPECT_EQ(string(rebuilt.begin(), rebuilt.end()), expected) << "split " << split;
+    }
+}
+
+TEST(Delta, RejectsMalformedOperations) {
+    const string reference = "0123456789";
+    bytes ops;
+
+    copyOp(ops, 6, 5);
+    EXPECT_EQ(run(reference, ops, 0), zxerr_out_of_bounds);
+
+    ops.clear();
+    copyOp(ops, 0, 0);
+    EXPECT_EQ(run(reference, ops, 0), zxerr_out_of_bounds);
+
+    ops = {DELTA_OP_INSERT, 0x00, 0x00};
+    EXPECT_EQ(run(reference, ops, 0), zxerr_out_of_bounds);
+
+    ops = {0x02, 0x00, 0x01};
+    EXPECT_EQ(run(reference, ops, 0), zxerr_unknown);
+
+    // Operations cut short are only detected once the last chunk is in
+    ops.clear();
+    insertOp(ops, "abc");
+    ops.pop_back();
+    EXPECT_EQ(run(reference, ops, 0), zxerr_unknown);
+    ops.clear();
+    copyOp(ops, 0, 2);
+    ops.pop_back();
+    EXPECT_EQ(run(reference, ops, 0), zxerr_unknown);
+
+    ops.clear();
+    copyOp(ops, 0, 8);
+    sinkCapacity = 4;
+    EXPECT_EQ(run(reference, ops, 0), zxerr_buffer_too_small);
+    sinkCapacity = SIZE_MAX;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <cstring>
+#include "coin.h"
+#include "crypto.h"
+#include "key_cache.h"
+
+namespace {
+    void makePath(uint32_t path[HDPATH_LEN_DEFAULT], uint32_t account) {
+        path[0] = HDPATH_0_DEFAULT;
+        path[1] = HDPATH_1_DEFAULT;
+        path[2] = HDPATH_2_DEFAULT | account;
+        path[3] = HDPATH_3_DEFAULT;
+        path[4] = HDPATH_4_DEFAULT;
+    }
+
+    class KeyCache : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            key_cache_reset();
+            key_cache_clear_stats();
+        }
+
+        void TearDown() override {
+            key_cache_reset();
+        }
+    };
+}
+
+TEST_F(KeyCache, StoresAndEvictsLeastRecentlyUsed) {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    uint8_t seed[SCALAR_LEN_ED25519];
+    uint8_t publicKey[PK_LEN_25519];
+
+    for (uint32_t account = 0; account < KEY_CACHE_ENTRIES; account++) {
+        makePath(path, account);
+        memset(seed, (int) account, sizeof(seed));
+        memset(publicKey, (int) (0x80 | account), sizeof(publicKey));
+        key_cache_store(path, seed, publicKey);
+    }
+
+    // Touch account 0 so account 1 becomes the oldest entry
+    makePath(path, 0);
+    ASSERT_TRUE(key_cache_lookup(path, seed, publicKey));
+    EXPECT_EQ(seed[0], 0);
+    EXPECT_EQ(publicKey[0], 0x80);
+
+    makePath(path, 1000);
+    key_cache_store(path, seed, publicKey);
+
+    makePath(path, 0);
+    EXPECT_TRUE(key_cache_lookup(path, nullptr, nullptr));
+    makePath(path, KEY_CACHE_ENTRIES > 1 ? 1 : 0);
+    EXPECT_FALSE(key_cache_lookup(path, nullptr, nullptr));
+
+    key_cache_stats_t stats;
+    key_cache_get_stats(&stats);
+    EXPECT_EQ(stats.evictions, 1u);
+}
+
+TEST_F(KeyCache, ResetWipesEntries) {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    uint8_t seed[SCALAR_LEN_ED25519] = {1};
+    uint8_t publicKey[PK_LEN_25519] = {2};
+
+    makePath(path, 7);
+    key_cache_store(path, seed, publicKey);
+    ASSERT_TRUE(key_cache_lookup(path, nullptr, nullptr));
+
+    key_cache_reset();
+    EXPECT_FALSE(key_cache_lookup(path, nullptr, nullptr));
+
+    key_cache_stats_t stats;
+    key_cache_get_stats(&stats);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.resets, 1u);
+}
+
+TEST_F(KeyCache, CryptoReusesDerivedKeys) {
+    makePath(hdPath, 0);
+
+    uint8_t first[PK_LEN_25519];
+    uint8_t second[PK_LEN_25519];
+    ASSERT_EQ(crypto_extractPublicKey(first, sizeof(first)), zxerr_ok);
+    ASSERT_EQ(crypto_extractPublicKey(second, sizeof(second)), zxerr_ok);
+    EXPECT_EQ(memcmp(first, second, sizeof(first)), 0);
+
+    const uint8_t message[] = {'T', 'X', 0x80};
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    ASSERT_EQ(crypto_sign(signature, sizeof(signature), message, sizeof(message)), zxerr_ok);
+
+    key_cache_stats_t stats;
+    key_cache_get_stats(&stats);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 2u);
+
+    // A cached key must sign exactly like a freshly derived one
+    uint8_t cachedSignature[ED25519_SIGNATURE_SIZE];
+    memcpy(cachedSignature, signature, sizeof(signature));
+    key_cache_reset();
+    ASSERT_EQ(crypto_sign(signature, sizeof(signature), message, sizeof(message)), zxerr_ok);
+    EXPECT_EQ(memcmp(signature, cachedSignature, sizeof(signature)), 0);
+}
@@ -0,0 +1,163 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include <base64.h>
+#include <zxformat.h>
+#include "common/parser.h"
+#include "crypto.h"
+#include "crypto_utils.h"
+#include "parser_encoding.h"
+
+namespace {
+    // Concatenation of every page, checking each one against pageString over `expected`
+    template<typename Render>
+    std::string renderPages(const std::string &expected, uint16_t outLen, Render render) {
+        std::vector<char> page(outLen);
+        std::vector<char> reference(outLen);
+        std::string joined;
+        uint8_t pageCount = 0;
+        uint8_t referenceCount = 0;
+        for (uint8_t idx = 0; idx == 0 || idx < pageCount; idx++) {
+            render(page.data(), outLen, idx, &pageCount);
+            pageString(reference.data(), outLen, expected.c_str(), idx, &referenceCount);
+            EXPECT_EQ(pageCount, referenceCount) << "page " << (int) idx;
+            EXPECT_STREQ(page.data(), reference.data()) << "page " << (int) idx;
+            joined += page.data();
+        }
+
+        // Past the last page, nothing is written
+        render(page.data(), outLen, pageCount, &pageCount);
+        EXPECT_STREQ(page.data(), "");
+        return joined;
+    }
+}
+
+TEST(Paging, Base64MatchesFullEncoding) {
+    std::vector<uint8_t> data(255);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    for (const uint16_t len : {1, 2, 3, 4, 5, 31, 32, 33, 64, 254, 255}) {
+        char full[400] = {0};
+        ASSERT_NE(base64_encode(full, sizeof(full), data.data(), len), 0);
+        for (const uint16_t outLen : {3, 4, 5, 17, 20, 38, 100, 400}) {
+            const std::string joined = renderPages(full, outLen, [&](char *out, uint16_t outSize, uint8_t idx, uint8_t *count) {
+                pageBase64(out, outSize, data.data(), len, idx, count);
+            });
+            EXPECT_EQ(joined, full) << len << " bytes, pages of " << outLen;
+        }
+    }
+}
+
+TEST(Paging, JsonStringDropsBackslashes) {
+    const std::string value = R"(quoted \"text\" and a \\ backslash, long enough to need a few pages)";
+    std::string shown;
+    for (const char c : value) {
+        if (c != '\\') {
+            shown += c;
+        }
+    }
+
+    for (const uint16_t outLen : {2, 5, 17, 38, 200}) {
+        const std::string joined = renderPages(shown, outLen, [&](char *out, uint16_t outSize, uint8_t idx, uint8_t *count) {
+            EXPECT_EQ(pageJsonString(out, outSize, value.data(), static_cast<uint16_t>(value.size()), idx, count), parser_ok);
+        });
+        EXPECT_EQ(joined, shown);
+    }
+
+    char out[10];
+    uint8_t pageCount = 1;
+    EXPECT_EQ(pageJsonString(out, sizeof(out), "\\\\", 2, 0, &pageCount), parser_ok);
+    EXPECT_EQ(pageCount, 0);
+    EXPECT_STREQ(out, "");
+
+    // 255 pages at most
+    const std::string longValue(255 * 9 + 1, 'x');
+    EXPECT_EQ(pageJsonString(out, sizeof(out), longValue.data(), 255 * 9, 254, &pageCount), parser_ok);
+    EXPECT_EQ(pageCount, 255);
+    EXPECT_EQ(pageJsonString(out, sizeof(out), longValue.data(), static_cast<uint16_t>(longValue.size()), 0, &pageCount),
+              parser_unexpected_buffer_end);
+}
+
+TEST(Paging, JsonValuesLongerThan200Bytes) {
+    const std::string statement(600, 's');
+    const std::string json = R"({"statement":")" + statement + R"(","type":"arc60.create"})";
+    const std::string domain = "arc60.io";
+
+    const uint32_t path[HDPATH_LEN_DEFAULT] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT, HDPATH_2_DEFAULT, 0, 0};
+    std::vector<uint8_t> request((const uint8_t *) path, (const uint8_t *) path + sizeof(path));
+    memcpy(hdPath, path, sizeof(path));
+    std::vector<uint8_t> signer(PK_LEN_25519);
+    ASSERT_EQ(crypto_extractPublicKey(signer.data(), (uint16_t) signer.size()), zxerr_ok);
+    request.insert(request.end(), signer.begin(), signer.end());
+    request.push_back(0x01);    // AUTH scope
+    request.push_back(0x01);    // Base64 encoding
+
+    std::vector<uint8_t> auth(SHA256_DIGEST_SIZE);
+    crypto_sha256((const uint8_t *) domain.data(), (uint16_t) domain.size(), auth.data(), (uint16_t) auth.size());
+    const std::string authData(auth.begin(), auth.end());
+    for (const std::string &field : {json, domain, std::string(), authData}) {
+        request.push_back((uint8_t) (field.size() >> 8));
+        request.push_back((uint8_t) field.size());
+        request.insert(request.end(), field.begin(), field.end());
+    }
+
+    parser_context_t ctx;
+    parser_arbitrary_data_t obj;
+    memset(&obj, 0, sizeof(obj));
+    ASSERT_EQ(parser_parse(&ctx, request.data(), request.size(), &obj, ArbitraryData), parser_ok);
+    ASSERT_EQ(parser_validate(&ctx), parser_ok);
+
+    char key[40];
+    char value[38];
+    uint8_t pageCount = 0;
+    std::string joined;
+    for (uint8_t page = 0; page == 0 || page < pageCount; page++) {
+        ASSERT_EQ(parser_getItem(&ctx, 0, key, sizeof(key), value, sizeof(value), page, &pageCount), parser_ok);
+        joined += value;
+    }
+    EXPECT_STREQ(key, "statement");
+    EXPECT_EQ(pageCount, 17);
+    EXPECT_EQ(joined, statement);
+}
+
+TEST(Paging, Base64HashFollowsTheData) {
+    uint8_t program[] = {0x06, 0x81, 0x01};
+    char first[BASE64_HASH_LEN + 1];
+    char again[BASE64_HASH_LEN + 1];
+    char changed[BASE64_HASH_LEN + 1];
+
+    b64hash_reset();
+    ASSERT_EQ(b64hash_data(program, sizeof(program), first, sizeof(first)), parser_ok);
+    EXPECT_STREQ(first, "CLN+8epcM9Y3A2R0SyyowQnaWhp3rsDud5taKmt4okA=");
+    ASSERT_EQ(b64hash_data(program, sizeof(program), again, sizeof(again)), parser_ok);
+    EXPECT_STREQ(again, first);
+
+    // New bytes at the same address only show up once a parse has reset the last digest
+    program[2] = 0x00;
+    b64hash_reset();
+    ASSERT_EQ(b64hash_data(program, sizeof(program), changed, sizeof(changed)), parser_ok);
+    EXPECT_STRNE(changed, first);
+    ASSERT_EQ(b64hash_data(program, 2, again, sizeof(again)), parser_ok);
+    EXPECT_STRNE(again, changed);
+
+    EXPECT_EQ(b64hash_data(program, sizeof(program), again, BASE64_HASH_LEN), parser_unexpected_buffer_end);
+}
@@ -0,0 +1,166 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include <hexutils.h>
+#include "common/parser.h"
+#include "crypto.h"
+#include "crypto_utils.h"
+#include "coin.h"
+
+using namespace std;
+
+namespace {
+    typedef vector<uint8_t> bytes;
+
+    const string domain = "arc60.io";
+
+    void appendU16(bytes &out, uint16_t v) {
+        out.push_back((uint8_t) (v >> 8));
+        out.push_back((uint8_t) v);
+    }
+
+    void appendString(bytes &out, const string &s) {
+        appendU16(out, (uint16_t) s.size());
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    bytes authData() {
+        bytes out(SHA256_DIGEST_SIZE);
+        crypto_sha256((const uint8_t *) domain.data(), (uint16_t) domain.size(), out.data(), (uint16_t) out.size());
+        return out;
+    }
+
+    bytes header(uint8_t count) {
+        const uint32_t path[HDPATH_LEN_DEFAULT] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT, HDPATH_2_DEFAULT, 0, 0};
+        bytes out((const uint8_t *) path, (const uint8_t *) path + sizeof(path));
+
+        bytes signer(PK_LEN_25519);
+        hdPath[0] = path[0]; hdPath[1] = path[1]; hdPath[2] = path[2]; hdPath[3] = 0; hdPath[4] = 0;
+        EXPECT_EQ(crypto_extractPublicKey(signer.data(), (uint16_t) signer.size()), zxerr_ok);
+        out.insert(out.end(), signer.begin(), signer.end());
+
+        out.push_back(0x01);    // AUTH scope
+        out.push_back(0x01);    // Base64 encoding
+        appendString(out, domain);
+        out.push_back(count);
+        return out;
+    }
+
+    void appendChallenge(bytes &out, const string &json, const string &requestId, const bytes &auth) {
+        appendString(out, json);
+        appendString(out, requestId);
+        appendU16(out, (uint16_t) auth.size());
+        out.insert(out.end(), auth.begin(), auth.end());
+    }
+
+    string challenge(uint8_t i) {
+        return "{\"challenge\":\"c" + to_string(i) + "\",\"type\":\"arc60.create\"}";
+    }
+
+    bytes buildBatch(uint8_t count) {
+        bytes out = header(count);
+        for (uint8_t i = 0; i < count; i++) {
+            appendChallenge(out, challenge(i), i % 2 ? "req" : "", authData());
+        }
+        return out;
+    }
+}
+
+TEST(ArbitraryBatch, ParsesAllChallenges) {
+    const bytes buffer = buildBatch(3);
+    parser_context_t ctx;
+    parser_arbitrary_batch_t batch;
+    memset(&batch, 0, sizeof(batch));
+
+    ASSERT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_ok);
+    ASSERT_EQ(parser_validate(&ctx), parser_ok);
+    EXPECT_EQ(batch.itemCount, 3);
+    EXPECT_EQ(string((const char *) batch.domainBuffer, batch.domainLen), domain);
+
+    for (uint8_t i = 0; i < batch.itemCount; i++) {
+        EXPECT_EQ(string((const char *) batch.items[i].dataBuffer, batch.items[i].dataLen), challenge(i));
+        EXPECT_EQ(batch.items[i].requestIdLen, i % 2 ? 3 : 0);
+        EXPECT_EQ(bytes(batch.items[i].authDataBuffer, batch.items[i].authDataBuffer + batch.items[i].authDataLen), authData());
+
+        // Signing uses the digests taken while parsing
+        uint8_t digest[SHA256_DIGEST_SIZE];
+        const string json = challenge(i);
+        ASSERT_EQ(crypto_sha256((const uint8_t *) json.data(), (uint16_t) json.size(), digest, sizeof(digest)), zxerr_ok);
+        EXPECT_EQ(bytes(batch.items[i].dataDigest, batch.items[i].dataDigest + SHA256_DIGEST_SIZE), bytes(digest, digest + sizeof(digest)));
+        const bytes auth = authData();
+        ASSERT_EQ(crypto_sha256(auth.data(), (uint16_t) auth.size(), digest, sizeof(digest)), zxerr_ok);
+        EXPECT_EQ(bytes(batch.items[i].authDataDigest, batch.items[i].authDataDigest + SHA256_DIGEST_SIZE), bytes(digest, digest + sizeof(digest)));
+    }
+
+    uint8_t numItems = 0;
+    ASSERT_EQ(parser_getNumItems(&numItems), parser_ok);
+    ASSERT_EQ(numItems, ARBITRARY_BATCH_NUM_ITEMS);
+
+    char key[40];
+    char value[100];
+    uint8_t pageCount = 0;
+    ASSERT_EQ(parser_getItem(&ctx, 1, key, sizeof(key), value, sizeof(value), 0, &pageCount), parser_ok);
+    EXPECT_STREQ(key, "Domain");
+    EXPECT_STREQ(value, "arc60.io");
+    ASSERT_EQ(parser_getItem(&ctx, 2, key, sizeof(key), value, sizeof(value), 0, &pageCount), parser_ok);
+    EXPECT_STREQ(key, "Challenges");
+    EXPECT_STREQ(value, "3");
+    ASSERT_EQ(parser_getItem(&ctx, 3, key, sizeof(key), value, sizeof(value), 0, &pageCount), parser_ok);
+    EXPECT_STREQ(value, "m/44'/283'/0'/0/0");
+}
+
+TEST(ArbitraryBatch, RejectsInvalidBatches) {
+    parser_context_t ctx;
+    parser_arbitrary_batch_t batch;
+
+    bytes buffer = header(0);
+    EXPECT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_unexpected_number_items);
+
+    buffer = buildBatch(ARBITRARY_BATCH_MAX_ITEMS + 1);
+    EXPECT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_unexpected_number_items);
+
+    // Fewer challenges than announced
+    buffer = header(2);
+    appendChallenge(buffer, challenge(0), "", authData());
+    EXPECT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_unexpected_buffer_end);
+
+    // More bytes than announced challenges
+    buffer = buildBatch(1);
+    buffer.push_back(0);
+    EXPECT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_unexpected_characters);
+
+    // Every challenge is checked, not only the first one
+    buffer = header(2);
+    appendChallenge(buffer, challenge(0), "", authData());
+    appendChallenge(buffer, "{\"b\":1,\"a\":2}", "", authData());
+    EXPECT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_bad_json);
+
+    bytes wrongDomain = authData();
+    wrongDomain[0] ^= 0x01;
+    buffer = header(2);
+    appendChallenge(buffer, challenge(0), "", authData());
+    appendChallenge(buffer, challenge(1), "", wrongDomain);
+    EXPECT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_failed_domain_auth);
+
+    // Signer must be the key of the hdPath
+    buffer = buildBatch(1);
+    buffer[HDPATH_LEN_DEFAULT * sizeof(uint32_t)] ^= 0x01;
+    EXPECT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &batch, ArbitraryDataBatch), parser_invalid_signer);
+}
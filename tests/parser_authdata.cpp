@@ -0,0 +1,232 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include "common/parser.h"
+#include "parser_cbor.h"
+#include "crypto.h"
+#include "crypto_utils.h"
+#include "coin.h"
+
+using namespace std;
+
+namespace {
+    typedef vector<uint8_t> bytes;
+
+    const string domain = "arc60.io";
+
+    const uint8_t FLAG_AT = 0x40;
+    const uint8_t FLAG_ED = 0x80;
+
+    // COSE_Key {1: 1, -1: 6, 3: -8, -2: h'00..'}, an Ed25519 credential public key.
+    // crv has to come before alg, which is checked against it.
+    const bytes eddsaKey = {0xA4, 0x01, 0x01, 0x20, 0x06, 0x03, 0x27, 0x21, 0x58, 0x20,
+                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    // {"credProtect": 2}
+    const bytes extensions = {0xA1, 0x6B, 'c', 'r', 'e', 'd', 'P', 'r', 'o', 't', 'e', 'c', 't', 0x02};
+
+    void appendU16(bytes &out, uint16_t v) {
+        out.push_back((uint8_t) (v >> 8));
+        out.push_back((uint8_t) v);
+    }
+
+    bytes authData(uint8_t flags, const bytes &credentialId, const bytes &cbor) {
+        bytes out(SHA256_DIGEST_SIZE);
+        crypto_sha256((const uint8_t *) domain.data(), (uint16_t) domain.size(), out.data(), (uint16_t) out.size());
+        out.push_back(flags);
+        out.insert(out.end(), {0, 0, 0, 1});    // signCount
+        if (flags & FLAG_AT) {
+            out.insert(out.end(), 16, 0xAA);    // AAGUID
+            appendU16(out, (uint16_t) credentialId.size());
+            out.insert(out.end(), credentialId.begin(), credentialId.end());
+        }
+        out.insert(out.end(), cbor.begin(), cbor.end());
+        return out;
+    }
+
+    bytes request(const bytes &auth) {
+        const uint32_t path[HDPATH_LEN_DEFAULT] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT, HDPATH_2_DEFAULT, 0, 0};
+        bytes out((const uint8_t *) path, (const uint8_t *) path + sizeof(path));
+        memcpy(hdPath, path, sizeof(path));
+
+        bytes signer(PK_LEN_25519);
+        EXPECT_EQ(crypto_extractPublicKey(signer.data(), (uint16_t) signer.size()), zxerr_ok);
+        out.insert(out.end(), signer.begin(), signer.end());
+        out.push_back(0x01);    // AUTH scope
+        out.push_back(0x01);    // Base64 encoding
+
+        const string json = R"({"challenge":"c0","type":"arc60.create"})";
+        const string authString(auth.begin(), auth.end());
+        for (const string &field : {json, domain, string(), authString}) {
+            appendU16(out, (uint16_t) field.size());
+            out.insert(out.end(), field.begin(), field.end());
+        }
+        return out;
+    }
+
+    parser_error_t parse(const bytes &auth) {
+        const bytes buffer = request(auth);
+        parser_context_t ctx;
+        parser_arbitrary_data_t obj;
+        memset(&obj, 0, sizeof(obj));
+        return parser_parse(&ctx, buffer.data(), buffer.size(), &obj, ArbitraryData);
+    }
+
+    // COSE_Key {1: 2, 3: -7, 4: [ops], -1: 1}, a P-256 credential public key
+    bytes es256Key(const bytes &ops) {
+        bytes out = {0xA4, 0x01, 0x02, 0x03, 0x26, 0x04};
+        if (ops.size() < 24) {
+            out.push_back((uint8_t) (0x80 | ops.size()));
+        } else {
+            out.push_back(0x98);
+            out.push_back((uint8_t) ops.size());
+        }
+        out.insert(out.end(), ops.begin(), ops.end());
+        out.insert(out.end(), {0x20, 0x01});
+        return out;
+    }
+}
+
+TEST(AuthData, DomainHashOnly) {
+    bytes auth(SHA256_DIGEST_SIZE);
+    crypto_sha256((const uint8_t *) domain.data(), (uint16_t) domain.size(), auth.data(), (uint16_t) auth.size());
+    EXPECT_EQ(parse(auth), parser_ok);
+    EXPECT_EQ(parse(authData(0x05, {}, {})), parser_ok);
+
+    auth[0] ^= 0x01;
+    EXPECT_EQ(parse(auth), parser_failed_domain_auth);
+}
+
+TEST(AuthData, CredentialPublicKey) {
+    EXPECT_EQ(parse(authData(FLAG_AT, bytes(16, 0x11), eddsaKey)), parser_ok);
+    EXPECT_EQ(parse(authData(FLAG_AT, bytes(16, 0x11), es256Key({0x01, 0x02}))), parser_ok);
+
+    // Credential IDs are skipped, not copied, whatever their length
+    EXPECT_EQ(parse(authData(FLAG_AT, bytes(1000, 0x11), eddsaKey)), parser_ok);
+
+    // key_ops of any length are scanned in place
+    bytes ops(40, 0x05);
+    ops[17] = 0x01;
+    ops[39] = 0x02;
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, es256Key(ops))), parser_ok);
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, es256Key({0x01}))), parser_failed_domain_auth);
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, es256Key({0x01, 0x61, 'x'}))), parser_cbor_error_invalid_type);
+
+    // Text labels are ignored
+    bytes labelled = eddsaKey;
+    labelled[0]++;
+    labelled.insert(labelled.end(), {0x61, 'k', 0x82, 0x01, 0xC1, 0x02});
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, labelled)), parser_ok);
+}
+
+TEST(AuthData, InvalidCredentialPublicKey) {
+    // alg is mandatory
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0xA1, 0x01, 0x01})), parser_failed_domain_auth);
+    // EdDSA requires kty OKP
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0xA3, 0x01, 0x02, 0x20, 0x06, 0x03, 0x27})), parser_failed_domain_auth);
+    // EdDSA requires an Edwards curve seen before alg
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0xA3, 0x01, 0x01, 0x03, 0x27, 0x20, 0x06})), parser_failed_domain_auth);
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0xA3, 0x01, 0x01, 0x20, 0x01, 0x03, 0x27})), parser_failed_domain_auth);
+    // Unknown and non integer algorithms
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0xA1, 0x03, 0x00})), parser_failed_domain_auth);
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0xA1, 0x03, 0x61, 'a'})), parser_failed_domain_auth);
+    // kty must be an integer
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0xA1, 0x01, 0xF5})), parser_failed_domain_auth);
+    // Not a map
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, {0x81, 0x01})), parser_cbor_error_invalid_type);
+}
+
+TEST(AuthData, Extensions) {
+    EXPECT_EQ(parse(authData(FLAG_ED, {}, extensions)), parser_ok);
+
+    bytes both = eddsaKey;
+    both.insert(both.end(), extensions.begin(), extensions.end());
+    EXPECT_EQ(parse(authData(FLAG_AT | FLAG_ED, bytes(8, 0x22), both)), parser_ok);
+
+    // Extension identifiers are text strings
+    EXPECT_EQ(parse(authData(FLAG_ED, {}, {0xA1, 0x01, 0x02})), parser_failed_domain_auth);
+}
+
+TEST(AuthData, ItemsMustSpanAuthData) {
+    bytes auth = authData(FLAG_AT, {}, eddsaKey);
+    auth.pop_back();
+    EXPECT_EQ(parse(auth), parser_cbor_error_unexpected);
+
+    // Trailing bytes and missing items
+    bytes trailing = eddsaKey;
+    trailing.push_back(0x00);
+    EXPECT_EQ(parse(authData(FLAG_AT, {}, trailing)), parser_failed_domain_auth);
+    EXPECT_EQ(parse(authData(FLAG_AT | FLAG_ED, {}, eddsaKey)), parser_cbor_error_unexpected);
+
+    // Credential ID running past authData
+    auth = authData(FLAG_AT, {}, {});
+    auth[auth.size() - 1] = 0x10;
+    EXPECT_EQ(parse(auth), parser_unexpected_buffer_end);
+
+    // Indefinite lengths are not canonical CBOR
+    EXPECT_EQ(parse(authData(FLAG_ED, {}, {0xBF, 0x61, 'a', 0x01, 0xFF})), parser_cbor_error_unexpected);
+}
+
+TEST(CborReader, SkipsNestedItems) {
+    // [{"a": [1, h'0102', 1.5]}, 6(-1), "xyz", 0xFFFFFFFFFFFFFFFF, true], 0
+    const bytes cbor = {0x85, 0xA1, 0x61, 'a', 0x83, 0x01, 0x42, 0x01, 0x02, 0xF9, 0x3E, 0x00,
+                        0xC6, 0x20, 0x63, 'x', 'y', 'z',
+                        0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF5, 0x00};
+    cbor_reader_t reader;
+    cbor_reader_init(&reader, cbor.data(), cbor.size());
+    ASSERT_EQ(cbor_skip_item(&reader), parser_ok);
+    EXPECT_EQ(reader.ptr, cbor.data() + cbor.size() - 1);
+
+    int64_t value = -1;
+    ASSERT_EQ(cbor_read_int(&reader, &value), parser_ok);
+    EXPECT_EQ(value, 0);
+    EXPECT_EQ(cbor_skip_item(&reader), parser_cbor_error_unexpected);
+
+    // Lengths and counts larger than the buffer
+    for (const bytes &bad : {bytes{0x5A, 0xFF, 0xFF, 0xFF, 0xFF}, bytes{0x9B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+                             bytes{0xBA, 0x80, 0x00, 0x00, 0x00, 0x01, 0x01}, bytes{0xC1}, bytes{0x19, 0x01}, bytes{0x1C}}) {
+        cbor_reader_init(&reader, bad.data(), bad.size());
+        EXPECT_EQ(cbor_skip_item(&reader), parser_cbor_error_unexpected);
+    }
+
+    const bytes negative = {0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    cbor_reader_init(&reader, negative.data(), negative.size());
+    ASSERT_EQ(cbor_read_int(&reader, &value), parser_ok);
+    EXPECT_EQ(value, INT64_MIN);
+}
+
+TEST(AuthData, DigestsAreTakenWhileParsing) {
+    bytes auth = authData(FLAG_AT | FLAG_ED, bytes(8, 0x22), eddsaKey);
+    auth.insert(auth.end(), extensions.begin(), extensions.end());
+    const bytes buffer = request(auth);
+
+    parser_context_t ctx;
+    parser_arbitrary_data_t obj;
+    memset(&obj, 0, sizeof(obj));
+    ASSERT_EQ(parser_parse(&ctx, buffer.data(), buffer.size(), &obj, ArbitraryData), parser_ok);
+
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    ASSERT_EQ(crypto_sha256(obj.dataBuffer, obj.dataLen, digest, sizeof(digest)), zxerr_ok);
+    EXPECT_EQ(bytes(obj.dataDigest, obj.dataDigest + SHA256_DIGEST_SIZE), bytes(digest, digest + sizeof(digest)));
+    ASSERT_EQ(crypto_sha256(auth.data(), (uint16_t) auth.size(), digest, sizeof(digest)), zxerr_ok);
+    EXPECT_EQ(bytes(obj.authDataDigest, obj.authDataDigest + SHA256_DIGEST_SIZE), bytes(digest, digest + sizeof(digest)));
+    EXPECT_EQ(bytes(obj.domainDigest, obj.domainDigest + SHA256_DIGEST_SIZE), bytes(auth.begin(), auth.begin() + SHA256_DIGEST_SIZE));
+}
@@ -0,0 +1,293 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <hexutils.h>
+#include <app_mode.h>
+#include "parser_group.h"
+#include "common/parser.h"
+
+using namespace std;
+
+namespace {
+    typedef vector<uint8_t> bytes;
+
+    bytes fromHex(const string &hex) {
+        bytes out(hex.size() / 2);
+        parseHexString(out.data(), (uint16_t) out.size(), hex.c_str());
+        return out;
+    }
+
+    void append(bytes &out, const bytes &in) {
+        out.insert(out.end(), in.begin(), in.end());
+    }
+
+    bytes str(const string &s) {
+        bytes out = {(uint8_t) (0xa0 | s.size())};
+        out.insert(out.end(), s.begin(), s.end());
+        return out;
+    }
+
+    bytes bin32(const bytes &b) {
+        bytes out = {0xc4, 0x20};
+        append(out, b);
+        return out;
+    }
+
+    bytes u16(uint16_t v) {
+        return {0xcd, (uint8_t) (v >> 8), (uint8_t) v};
+    }
+
+    const bytes sender = fromHex("1eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8");
+    const bytes genesisHash = fromHex("4863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22");
+
+    // Canonical payment i of a test group: amount 1000 * (i + 1), receiver (i % 3 + 1) repeated.
+    // Lease and note are only encoded when given.
+    bytes payment(uint8_t i, const bytes &group, const bytes &gh = genesisHash,
+                  const bytes &lease = {}, const bytes &note = {}) {
+        bytes out = {(uint8_t) (0x89 + !lease.empty() + !note.empty())};
+        append(out, str("amt"));  append(out, u16((uint16_t) (1000 * (i + 1))));
+        append(out, str("fee"));  append(out, u16(1000));
+        append(out, str("fv"));   append(out, u16(1000));
+        append(out, str("gh"));   append(out, bin32(gh));
+        append(out, str("grp"));  append(out, bin32(group));
+        append(out, str("lv"));   append(out, u16(2000));
+        if (!lease.empty()) {
+            append(out, str("lx")); append(out, bin32(lease));
+        }
+        if (!note.empty()) {
+            append(out, str("note")); out.push_back(0xc4); out.push_back((uint8_t) note.size()); append(out, note);
+        }
+        append(out, str("rcv"));  append(out, bin32(bytes(32, (uint8_t) (i % 3 + 1))));
+        append(out, str("snd"));  append(out, bin32(sender));
+        append(out, str("type")); append(out, str("pay"));
+        return out;
+    }
+
+    // Asset transfer of 5 units of asset 1234 to 0x09 repeated
+    bytes assetTransfer(const bytes &group) {
+        bytes out = {0x8a};
+        append(out, str("aamt")); out.push_back(0x05);
+        append(out, str("arcv")); append(out, bin32(bytes(32, 0x09)));
+        append(out, str("fee"));  append(out, u16(1000));
+        append(out, str("fv"));   append(out, u16(1000));
+        append(out, str("gh"));   append(out, bin32(genesisHash));
+        append(out, str("grp"));  append(out, bin32(group));
+        append(out, str("lv"));   append(out, u16(2000));
+        append(out, str("snd"));  append(out, bin32(sender));
+        append(out, str("type")); append(out, str("axfer"));
+        append(out, str("xaid")); append(out, u16(1234));
+        return out;
+    }
+
+    void appendEntry(bytes &buffer, uint8_t flags, const bytes &msgpack) {
+        buffer.push_back(flags);
+        buffer.push_back((uint8_t) (msgpack.size() >> 8));
+        buffer.push_back((uint8_t) msgpack.size());
+        buffer.push_back('T');
+        buffer.push_back('X');
+        append(buffer, msgpack);
+    }
+
+    bytes buildGroup(uint8_t count, const bytes &group, uint8_t signMask = 0xFF) {
+        bytes buffer;
+        for (uint8_t i = 0; i < count; i++) {
+            appendEntry(buffer, (signMask >> (i % 8)) & 1 ? GROUP_ENTRY_FLAG_SIGN : 0, payment(i, group));
+        }
+        return buffer;
+    }
+
+    // Group IDs computed independently with hashlib's sha512_256
+    const bytes groupOf2 = fromHex("f898b0eecd17e3b0efbee99e7443f749af2a1a30f47063ff47b1e2e5f75da6ad");
+    const bytes groupOf16 = fromHex("3359255a2206ba2575538ce256f42cba0ba8efbddb6d6707a0988c367297bbfa");
+    // payment(0) followed by assetTransfer
+    const bytes groupMixed = fromHex("a7eafd1ffc70353cd236783e65c890d9e7c1867ca936929ec71baeb8a9d949a0");
+    // payment(0) followed by payment(1) on a genesis hash of 0x07 repeated
+    const bytes groupTwoNetworks = fromHex("04b78ae53d5e589d9cc37c67ad42501dc7ab21a3e12da193451293516e1a387a");
+    // payment(0) with the note "hi", then payment(1)
+    const bytes groupWithNote = fromHex("a7bd3e9c9c56d3ac1d73ef44edddf40b5891d1881fa6b0f70c04d9a672486935");
+    // payment(0), then payment(1) with a lease of 0x0c repeated
+    const bytes groupWithLease = fromHex("3e578823e5e18d97ed7026d698dbb25ea93e006ab4bb3ebc50a8e09fbf88c380");
+    const bytes otherSigner(32, 0x42);
+
+    vector<string> dumpGroup(const parser_group_t &group, parser_tx_t &tx) {
+        vector<string> out;
+        uint8_t numItems = 0;
+        EXPECT_EQ(parser_group_getNumItems(&group, &numItems), parser_ok);
+        for (uint8_t idx = 0; idx < numItems; idx++) {
+            char key[40];
+            char value[200];
+            uint8_t pageCount = 0;
+            EXPECT_EQ(parser_group_getItem(&group, &tx, idx, key, sizeof(key), value, sizeof(value), 0, &pageCount), parser_ok);
+            out.push_back(string(key) + " : " + value);
+        }
+        return out;
+    }
+}
+
+TEST(Group, AcceptsValidGroup) {
+    app_mode_set_expert(false);
+    const bytes buffer = buildGroup(2, groupOf2);
+    parser_group_t group;
+    parser_tx_t tx;
+
+    ASSERT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, sender.data(), &group, &tx), parser_ok);
+    EXPECT_EQ(group.txnCount, 2);
+    EXPECT_EQ(group.signCount, 2);
+    EXPECT_EQ(group.totalAmount, 3000u);
+    EXPECT_EQ(group.totalFees, 2000u);
+
+    EXPECT_THAT(dumpGroup(group, tx), testing::ElementsAre(
+        "Group txns : 2",
+        "To sign : 2",
+        "Group ID : +Jiw7s0X47DvvumedEP3Sa8qGjD0cGP/R7Hi5fddpq0=",
+        "Network : TestNet",
+        "Txn types : 2 Payment",
+        "Total amount : ALGO 0.003",
+        "Total fees : ALGO 0.002",
+        "Receiver : AEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEA5RCDXMI",
+        "Receiver : AIBAEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBMXPWWNQ"));
+}
+
+TEST(Group, ListsSendersOtherThanTheSigner) {
+    app_mode_set_expert(false);
+    const bytes buffer = buildGroup(2, groupOf2);
+    parser_group_t group;
+    parser_tx_t tx;
+
+    ASSERT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, otherSigner.data(), &group, &tx), parser_ok);
+    const vector<string> items = dumpGroup(group, tx);
+    // Both payments share the sender, listed once
+    EXPECT_EQ(count(items.begin(), items.end(),
+                    "Other sender : D3GP2HWALZASL6XGSDHMFJ3YHGU2GYRV3VXC5L52PHFCLQG2MD4KIPKKAA"), 1);
+}
+
+TEST(Group, ListsTransactionsOtherThanPayments) {
+    app_mode_set_expert(false);
+    bytes buffer;
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(0, groupMixed));
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, assetTransfer(groupMixed));
+    parser_group_t group;
+    parser_tx_t tx;
+
+    ASSERT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, sender.data(), &group, &tx), parser_ok);
+    ASSERT_EQ(group.detailCount, 1);
+
+    const vector<string> items = dumpGroup(group, tx);
+    ASSERT_EQ(items.size(), 9u + group.details[0].numItems);
+    EXPECT_EQ(items[5], "Total amount : ALGO 0.001");
+    EXPECT_EQ(items[7], "Receiver : AEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEAQCAIBAEA5RCDXMI");
+    EXPECT_EQ(items[8], "Asset dst : BEEQSCIJBEEQSCIJBEEQSCIJBEEQSCIJBEEQSCIJBEEQSCIJBEEURVP5F4");
+    EXPECT_EQ(items[9], "Txn 2: Txn type : Asset xfer");
+    EXPECT_THAT(items, testing::Contains("Txn 2: Asset ID : #1234"));
+    EXPECT_THAT(items, testing::Contains("Txn 2: Amount : Base unit 5"));
+}
+
+TEST(Group, ListsPaymentsWithNoteOrLease) {
+    app_mode_set_expert(false);
+    parser_group_t group;
+    parser_tx_t tx;
+
+    bytes buffer;
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(0, groupWithNote, genesisHash, {}, {'h', 'i'}));
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(1, groupWithNote));
+    ASSERT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, sender.data(), &group, &tx), parser_ok);
+    ASSERT_EQ(group.detailCount, 1);
+    EXPECT_EQ(group.details[0].groupIdx, 0);
+    // Still part of the totals
+    EXPECT_EQ(group.totalAmount, 3000u);
+    EXPECT_THAT(dumpGroup(group, tx), testing::Contains("Txn 1: Note : 2 bytes"));
+
+    buffer.clear();
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(0, groupWithLease));
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(1, groupWithLease, genesisHash, bytes(32, 0x0c)));
+    ASSERT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, sender.data(), &group, &tx), parser_ok);
+    ASSERT_EQ(group.detailCount, 1);
+    EXPECT_EQ(group.details[0].groupIdx, 1);
+    EXPECT_THAT(dumpGroup(group, tx), testing::Contains("Txn 2: Lease : DAwMDAwMDAwMDAwMDAwMDAwMDAwMDAwMDAwMDAwMDAw="));
+}
+
+TEST(Group, AcceptsFullGroupAndPartialSigning) {
+    app_mode_set_expert(false);
+    // Sign every other transaction
+    const bytes buffer = buildGroup(GROUP_MAX_TXNS, groupOf16, 0x55);
+    parser_group_t group;
+    parser_tx_t tx;
+
+    ASSERT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), GROUP_MAX_TXNS, sender.data(), &group, &tx), parser_ok);
+    EXPECT_EQ(group.txnCount, GROUP_MAX_TXNS);
+    EXPECT_EQ(group.signCount, GROUP_MAX_TXNS / 2);
+    // Receivers 1, 2 and 3, each listed once
+    EXPECT_EQ(group.addressCount, 3);
+
+    // Third transaction to sign is payment #4
+    const uint8_t *message = nullptr;
+    uint16_t messageLen = 0;
+    ASSERT_EQ(parser_group_getSignable(buffer.data(), (uint16_t) buffer.size(), 2, &message, &messageLen), parser_ok);
+    bytes expected = {'T', 'X'};
+    append(expected, payment(4, groupOf16));
+    EXPECT_EQ(bytes(message, message + messageLen), expected);
+
+    EXPECT_EQ(parser_group_getSignable(buffer.data(), (uint16_t) buffer.size(), 8, &message, &messageLen), parser_no_data);
+}
+
+TEST(Group, RejectsWrongGroupHash) {
+    parser_group_t group;
+    parser_tx_t tx;
+
+    // Claims the group of 2 but only contains one of its members
+    bytes buffer = buildGroup(1, groupOf2);
+    EXPECT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 1, sender.data(), &group, &tx), parser_invalid_group);
+
+    // A member was modified after the group ID was computed
+    buffer.clear();
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(0, groupOf2));
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(2, groupOf2));
+    EXPECT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, sender.data(), &group, &tx), parser_invalid_group);
+
+    // Members do not share the same grp
+    buffer.clear();
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(0, groupOf2));
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(1, groupOf16));
+    EXPECT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, sender.data(), &group, &tx), parser_invalid_group);
+
+    // Members are not all on the same network, even though grp matches them
+    buffer.clear();
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(0, groupTwoNetworks));
+    appendEntry(buffer, GROUP_ENTRY_FLAG_SIGN, payment(1, groupTwoNetworks, bytes(32, 0x07)));
+    EXPECT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 2, sender.data(), &group, &tx), parser_invalid_group);
+}
+
+TEST(Group, RejectsMalformedBuffers) {
+    parser_group_t group;
+    parser_tx_t tx;
+    const bytes buffer = buildGroup(2, groupOf2);
+
+    EXPECT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 3, sender.data(), &group, &tx), parser_unexpected_number_items);
+    EXPECT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size(), 1, sender.data(), &group, &tx), parser_unexpected_number_items);
+    EXPECT_EQ(parser_group_parse(buffer.data(), (uint16_t) buffer.size() - 1, 2, sender.data(), &group, &tx), parser_unexpected_buffer_end);
+
+    const bytes nothingToSign = buildGroup(2, groupOf2, 0);
+    EXPECT_EQ(parser_group_parse(nothingToSign.data(), (uint16_t) nothingToSign.size(), 2, sender.data(), &group, &tx), parser_unexpected_number_items);
+
+    bytes badFlags = buffer;
+    badFlags[0] = 0x80;
+    EXPECT_EQ(parser_group_parse(badFlags.data(), (uint16_t) badFlags.size(), 2, sender.data(), &group, &tx), parser_unexpected_value);
+}
@@ -16,6 +16,9 @@
 
 #include "gmock/gmock.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string>
 #include <vector>
 #include <iostream>
 #include <hexutils.h>
@@ -403,6 +406,24 @@ TEST(Transactions, Payment) {
     EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
 }
 
+TEST(Transactions, ErrorOffset) {
+    parser_context_t ctx;
+    parser_tx_t parser_obj;
+    uint8_t buffer[300];
+
+    // Payment whose "fee" (at offset 8) holds the string "abc" (at offset 12) instead of an integer
+    const uint16_t bufferLen = parseHexString(buffer, sizeof(buffer),
+        "88a3616d74cd03e8a3666565a3616263a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f0"
+        "59a7ac20dec62f7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd"
+        "6e2eafba79ca25c0da60f8a3736e64c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0"
+        "da60f8a474797065a3706179");
+
+    // INS_VALIDATE_MSGPACK reports where the parser stopped: inside the offending value
+    EXPECT_EQ(parser_parse(&ctx, buffer, bufferLen, &parser_obj, MsgPack), parser_msgpack_int_type_expected);
+    EXPECT_GE(ctx.offset, 12);
+    EXPECT_LT(ctx.offset, 16);
+}
+
 TEST(Transactions, Application) {
     parser_context_t ctx;
     parser_error_t err;
@@ -434,3 +455,173 @@ TEST(Transactions, ApplicationLongBoxes) {
     // Try to parse transaction with Box: n = 65 bytes. It should be rejected with value out of range
     EXPECT_EQ(err, parser_value_out_of_range) << parser_getErrorDescription(err);
 }
+
+namespace {
+    struct parsed_tx_t {
+        parser_error_t err;
+        parser_tx_t tx;
+        std::vector<std::string> items;
+    };
+
+    // Fills the transaction with 0xFF first, so fields left unset stand out
+    parsed_tx_t parseItems(const std::string &hex) {
+        std::vector<uint8_t> blob(hex.size() / 2);
+        EXPECT_EQ(parseHexString(blob.data(), blob.size(), hex.c_str()), blob.size());
+
+        parsed_tx_t out;
+        parser_context_t ctx;
+        memset(&out.tx, 0xFF, sizeof(out.tx));
+        out.err = parser_parse(&ctx, blob.data(), blob.size(), &out.tx, MsgPack);
+        if (out.err != parser_ok) {
+            return out;
+        }
+
+        uint8_t numItems = 0;
+        EXPECT_EQ(parser_getNumItems(&numItems), parser_ok);
+        for (uint8_t idx = 0; idx < numItems; idx++) {
+            char key[40];
+            char value[40];
+            uint8_t pageCount = 1;
+            for (uint8_t page = 0; page < pageCount; page++) {
+                EXPECT_EQ(parser_getItem(&ctx, idx, key, sizeof(key), value, sizeof(value), page, &pageCount), parser_ok);
+                out.items.push_back(std::string(key) + " = " + value);
+            }
+        }
+        return out;
+    }
+
+    bool isZero(const uint8_t *buf, size_t len) {
+        return std::all_of(buf, buf + len, [](uint8_t b) { return b == 0; });
+    }
+}
+
+TEST(Transactions, SchemaFields) {
+    // Payment from the Zemu account 0 to itself
+    const std::string payment =
+        "88a3616d74cd03e8a3666565cd03e8a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f"
+        "7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a373"
+        "6e64c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a474797065a3706179";
+    const parsed_tx_t plain = parseItems(payment);
+    ASSERT_EQ(plain.err, parser_ok) << parser_getErrorDescription(plain.err);
+    EXPECT_EQ(plain.tx.payment.amount, 1000u);
+    EXPECT_TRUE(isZero(plain.tx.payment.close, sizeof(plain.tx.payment.close)));
+    EXPECT_TRUE(isZero(plain.tx.lease, sizeof(plain.tx.lease)));
+    EXPECT_TRUE(isZero(plain.tx.groupID, sizeof(plain.tx.groupID)));
+    EXPECT_EQ(plain.tx.note_len, 0u);
+
+    // Keys that belong to other transaction types are ignored
+    std::string withAssetId = payment + "a47861696405";
+    withAssetId.replace(0, 2, "89");
+    const parsed_tx_t extra = parseItems(withAssetId);
+    ASSERT_EQ(extra.err, parser_ok) << parser_getErrorDescription(extra.err);
+    EXPECT_EQ(extra.items, plain.items);
+
+    // A required field is missing
+    std::string noReceiver = payment;
+    noReceiver.erase(noReceiver.find("a3726376"), 2 * (4 + 34));
+    noReceiver.replace(0, 2, "87");
+    EXPECT_EQ(parseItems(noReceiver).err, parser_no_data);
+
+    // Asset opt-in: no amount, no close-to, no clawback source
+    const parsed_tx_t optIn = parseItems(
+        "88a461726376c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a3666565cd0910a26676cd03"
+        "e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3736e64c4205695"
+        "782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a474797065a56178666572a478616964cd04d2");
+    ASSERT_EQ(optIn.err, parser_ok) << parser_getErrorDescription(optIn.err);
+    EXPECT_EQ(optIn.tx.type, TX_ASSET_XFER);
+    EXPECT_EQ(optIn.tx.asset_xfer.id, 1234u);
+    EXPECT_EQ(optIn.tx.asset_xfer.amount, 0u);
+    EXPECT_TRUE(isZero(optIn.tx.asset_xfer.sender, sizeof(optIn.tx.asset_xfer.sender)));
+    EXPECT_TRUE(isZero(optIn.tx.asset_xfer.close, sizeof(optIn.tx.asset_xfer.close)));
+
+    // Key registration: the vote range is displayed as a pair
+    const std::string keyreg =
+        "8ca3666565cd0e42a26676cd03e7a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a2"
+        "6c76cd0d80a673656c6b6579c420f66af5dd18bcac57a9c4dde084852b64dba2e8baaa339844cc1e3946b8b99645a3736e64c420"
+        "bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfa7737072666b6579c44099847419510e6cc4d235"
+        "db0a33a470632c0760fa950ea837138245cf164eade1fd354f01fad2b351a9f263c010d78e21113812317edf5d6c2305d1f3e805"
+        "a4f7a474797065a66b6579726567a7766f746566737401a6766f74656b640aa7766f74656b6579c420f66af5dd18bcac57a9c4dd"
+        "e084852b64dba2e8baaa339844cc1e3946b8b99645a7766f74656c7374cd07d0";
+    const parsed_tx_t reg = parseItems(keyreg);
+    ASSERT_EQ(reg.err, parser_ok) << parser_getErrorDescription(reg.err);
+    EXPECT_EQ(reg.tx.keyreg.voteFirst, 1u);
+    EXPECT_EQ(reg.tx.keyreg.voteLast, 2000u);
+    EXPECT_EQ(reg.tx.keyreg.keyDilution, 10u);
+    EXPECT_EQ(reg.tx.keyreg.nonpartFlag, 0u);
+
+    std::string noVoteLast = keyreg.substr(0, keyreg.size() - 2 * 11);
+    noVoteLast.replace(0, 2, "8b");
+    EXPECT_EQ(parseItems(noVoteLast).err, parser_no_data);
+}
+
+TEST(Transactions, NonCanonicalEncodings) {
+    // Payment from the Zemu account 0 to itself: {"amt": 1000, "fee": 1000, "fv": 1000, ...}
+    const std::string payment =
+        "88a3616d74cd03e8a3666565cd03e8a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f"
+        "7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a373"
+        "6e64c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a474797065a3706179";
+
+    const struct {
+        const char *from;
+        const char *to;
+        parser_error_t err;
+        uint16_t offset;
+    } cases[] = {
+        // Map of 8 entries with a map16 header
+        {"88a3616d74", "de0008a3616d74", parser_msgpack_non_minimal_encoding, 0},
+        // "amt" key as str8
+        {"88a3616d74", "88d903616d74", parser_msgpack_non_minimal_encoding, 1},
+        // 100 as uint16
+        {"a3616d74cd03e8", "a3616d74cd0064", parser_msgpack_non_minimal_encoding, 5},
+        // 1000 as uint64
+        {"a3616d74cd03e8", "a3616d74cf00000000000003e8", parser_msgpack_non_minimal_encoding, 5},
+        // Zero fee, which canonical encoders omit
+        {"a3666565cd03e8", "a366656500", parser_msgpack_zero_value, 12},
+        // Zero amount
+        {"a3616d74cd03e8", "a3616d7400", parser_msgpack_zero_value, 5},
+        // "fee" before "amt"
+        {"a3616d74cd03e8a3666565cd03e8", "a3666565cd03e8a3616d74cd03e8", parser_msgpack_unsorted_keys, 8},
+        // "amt" twice
+        {"a3666565cd03e8", "a3616d74cd03e8", parser_msgpack_unsorted_keys, 8},
+    };
+
+    for (const auto &c : cases) {
+        std::string hex = payment;
+        hex.replace(hex.find(c.from), strlen(c.from), c.to);
+
+        std::vector<uint8_t> blob(hex.size() / 2);
+        ASSERT_EQ(parseHexString(blob.data(), blob.size(), hex.c_str()), blob.size());
+        parser_context_t ctx;
+        parser_tx_t tx;
+        EXPECT_EQ(parser_parse(&ctx, blob.data(), blob.size(), &tx, MsgPack), c.err) << c.to;
+        EXPECT_EQ(ctx.offset, c.offset) << c.to;
+    }
+}
+
+TEST(Transactions, EmptyKeyAtBufferEnd) {
+    // A map whose only key is empty, with nothing after it: the key is not looked up
+    const std::vector<uint8_t> blob = {0x81, 0xa0};
+    parser_context_t ctx;
+    parser_tx_t tx;
+    EXPECT_EQ(parser_parse(&ctx, blob.data(), blob.size(), &tx, MsgPack), parser_unexpected_buffer_end);
+    EXPECT_EQ(ctx.offset, blob.size());
+}
+
+TEST(Transactions, BoxNameCharacters) {
+    // Application call with a single box reference named "box" followed by one more byte
+    const std::string prefix = "88a4617062789181a16ec404626f78";
+    const std::string suffix =
+        "a4617069640aa3666565cd03e8a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f"
+        "7f70e5093a22a26c76cd07d0a3736e64c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8"
+        "a474797065a46170706c";
+
+    // Bytes from 0x80 up are shown as text, like printable ASCII
+    const parsed_tx_t high = parseItems(prefix + "e9" + suffix);
+    ASSERT_EQ(high.err, parser_ok) << parser_getErrorDescription(high.err);
+    EXPECT_THAT(high.items, testing::Contains("Box 0 = box\xe9"));
+
+    // Control characters switch the name to base64
+    const parsed_tx_t control = parseItems(prefix + "07" + suffix);
+    ASSERT_EQ(control.err, parser_ok) << parser_getErrorDescription(control.err);
+    EXPECT_THAT(control.items, testing::Contains("Box 0 = Ym94Bw=="));
+}
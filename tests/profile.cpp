@@ -0,0 +1,100 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "gmock/gmock.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <json/json.h>
+#include <hexutils.h>
+#include "common/parser.h"
+#include "parser_txdef.h"
+#include "profile.h"
+
+using std::string;
+
+namespace {
+    // Payment from the Zemu account 0 to itself
+    const string payment =
+            "88a3616d74cd03e8a3666565cd03e8a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20"
+            "dec62f7f70e5093a22a26c76cd07d0a3726376c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25"
+            "c0da60f8a3736e64c4201eccfd1ec05e4125fae690cec2a77839a9a36235dd6e2eafba79ca25c0da60f8a474797065a3706179";
+
+    Json::Value dumpProfile() {
+        char json[1024];
+        EXPECT_GT(profile_to_json(json, sizeof(json)), 0u);
+
+        Json::Value root;
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        string errors;
+        EXPECT_TRUE(reader->parse(json, json + strlen(json), &root, &errors)) << errors;
+        return root;
+    }
+}
+
+TEST(Profile, CountsOneTransaction) {
+    std::vector<uint8_t> blob(payment.size() / 2);
+    ASSERT_EQ(parseHexString(blob.data(), (uint16_t) blob.size(), payment.c_str()), blob.size());
+
+    profile_reset();
+    parser_context_t ctx;
+    parser_tx_t tx;
+    memset(&ctx, 0, sizeof(ctx));
+    memset(&tx, 0, sizeof(tx));
+    ASSERT_EQ(parser_parse(&ctx, blob.data(), blob.size(), &tx, MsgPack), parser_ok);
+    ASSERT_EQ(parser_validate(&ctx), parser_ok);
+
+    uint8_t numItems = 0;
+    ASSERT_EQ(parser_getNumItems(&numItems), parser_ok);
+    char key[40];
+    char value[40];
+    uint32_t renders = 0;
+    for (uint8_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageCount = 1;
+        for (uint8_t page = 0; page < pageCount; page++) {
+            ASSERT_EQ(parser_getItem(&ctx, idx, key, sizeof(key), value, sizeof(value), page, &pageCount), parser_ok);
+            renders++;
+        }
+    }
+
+    const Json::Value root = dumpProfile();
+    ASSERT_TRUE(root["counters"].isObject());
+    ASSERT_TRUE(root["stages"].isObject());
+#if !defined(APP_PROFILE)
+    EXPECT_FALSE(root["enabled"].asBool());
+    EXPECT_EQ(root["counters"]["find_key"].asUInt64(), 0u);
+    GTEST_SKIP() << "configure with -DENABLE_PROFILE=ON to count events";
+#else
+    EXPECT_TRUE(root["enabled"].asBool());
+    const Json::Value &counters = root["counters"];
+    // Transactions are decoded from one walk over the map, without key lookups
+    EXPECT_EQ(counters["find_key"].asUInt64(), 0u);
+    // Sender and receiver, rendered by parser_validate and again here
+    EXPECT_GE(counters["encode_pubkey"].asUInt64(), 4u);
+    EXPECT_GE(counters["page_string"].asUInt64(), 4u);
+
+    const Json::Value &stages = root["stages"];
+    EXPECT_EQ(stages["parse"]["calls"].asUInt(), 1u);
+    EXPECT_EQ(stages["validate"]["calls"].asUInt(), 1u);
+    // parser_validate renders the first page of every item
+    EXPECT_EQ(stages["get_item"]["calls"].asUInt(), numItems + renders);
+    EXPECT_GT(stages["parse"]["ns"].asUInt64(), 0u);
+
+    profile_reset();
+    EXPECT_EQ(dumpProfile()["counters"]["encode_pubkey"].asUInt64(), 0u);
+#endif
+}
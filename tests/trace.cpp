@@ -0,0 +1,105 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "gmock/gmock.h"
+
+#include <vector>
+#include "trace.h"
+
+namespace {
+    struct record_t {
+        uint32_t timestamp;
+        uint8_t event;
+        uint8_t exchange;
+        uint16_t arg;
+    };
+
+    // Drains one reply of at most replyLen bytes; returns the records and sets dropped
+    std::vector<record_t> drain(uint16_t replyLen, uint16_t &dropped) {
+        std::vector<uint8_t> reply(replyLen);
+        const uint16_t len = trace_drain(reply.data(), replyLen);
+        EXPECT_GE(len, TRACE_HEADER_LEN);
+        EXPECT_EQ(len, TRACE_HEADER_LEN + reply[0] * TRACE_RECORD_LEN);
+        dropped = static_cast<uint16_t>((reply[1] << 8) | reply[2]);
+
+        std::vector<record_t> records;
+        for (uint8_t i = 0; i < reply[0]; i++) {
+            const uint8_t *r = reply.data() + TRACE_HEADER_LEN + i * TRACE_RECORD_LEN;
+            records.push_back({static_cast<uint32_t>((r[0] << 24) | (r[1] << 16) | (r[2] << 8) | r[3]),
+                               r[4], r[5], static_cast<uint16_t>((r[6] << 8) | r[7])});
+        }
+        return records;
+    }
+}
+
+TEST(Trace, DrainsOldestFirstAcrossReplies) {
+    trace_reset();
+    trace_next_exchange();
+    trace_record(TRACE_APDU, 0x08);
+    trace_record(TRACE_CHUNK, 200);
+    trace_next_exchange();
+    trace_record(TRACE_PARSE_START, 0);
+    trace_record(TRACE_PARSE_END, 0);
+    trace_record(TRACE_SIGN_END, 3);
+
+    uint16_t dropped = 0;
+    // Room for two records per reply
+    auto records = drain(TRACE_HEADER_LEN + 2 * TRACE_RECORD_LEN + 1, dropped);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(dropped, 0);
+    EXPECT_EQ(records[0].event, TRACE_APDU);
+    EXPECT_EQ(records[0].arg, 0x08);
+    EXPECT_EQ(records[1].event, TRACE_CHUNK);
+    EXPECT_EQ(records[1].arg, 200);
+    EXPECT_EQ(records[0].exchange, 1);
+    EXPECT_EQ(records[1].exchange, 1);
+    EXPECT_LE(records[0].timestamp, records[1].timestamp);
+
+    records = drain(TRACE_HEADER_LEN + 2 * TRACE_RECORD_LEN, dropped);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].event, TRACE_PARSE_START);
+    EXPECT_EQ(records[0].exchange, 2);
+    EXPECT_EQ(records[1].exchange, 2);
+
+    records = drain(255, dropped);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].event, TRACE_SIGN_END);
+    EXPECT_EQ(records[0].arg, 3);
+
+    EXPECT_TRUE(drain(255, dropped).empty());
+}
+
+TEST(Trace, OverwritesOldestWhenFull) {
+    trace_reset();
+    for (uint16_t i = 0; i < TRACE_ENTRIES + 5; i++) {
+        trace_record(TRACE_CHUNK, i);
+    }
+
+    uint16_t dropped = 0;
+    std::vector<record_t> all;
+    for (auto records = drain(255, dropped); !records.empty(); records = drain(255, dropped)) {
+        if (all.empty()) {
+            EXPECT_EQ(dropped, 5);
+        } else {
+            EXPECT_EQ(dropped, 0);
+        }
+        all.insert(all.end(), records.begin(), records.end());
+    }
+
+    ASSERT_EQ(all.size(), static_cast<size_t>(TRACE_ENTRIES));
+    for (uint16_t i = 0; i < TRACE_ENTRIES; i++) {
+        EXPECT_EQ(all[i].arg, i + 5);
+    }
+}
@@ -121,6 +121,36 @@ describe('Standard', function () {
     }
   })
 
+  // INS_GET_PUBLIC_KEYS walks account'/0/0 in the app from the OS-derived 44'/283' node: it
+  // must return the keys the OS derives for each full path
+  test.concurrent.each(models)('get public keys matches single derivation', async function (m) {
+    const sim = new Zemu(m.path)
+    try {
+      await sim.start({ ...defaultOptions, model: m.name })
+      const app = new AlgorandApp(sim.getTransport())
+      const transport = sim.getTransport()
+
+      for (const firstAccount of [0, 120, 0x7ffffff8]) {
+        const payload = Buffer.alloc(5)
+        payload.writeUInt32BE(firstAccount)
+        payload.writeUInt8(8, 4)
+
+        const response = await transport.send(0x80, 0x12, 0x00, 0x00, payload)
+        expect(response.readUInt16BE(response.length - 2)).toEqual(0x9000)
+        expect(response[0]).toEqual(8)
+
+        for (let i = 0; i < 8; i++) {
+          const single = await app.getAddressAndPubKey(firstAccount + i)
+          expect(single.returnCode).toEqual(0x9000)
+          const key = response.subarray(1 + 32 * i, 1 + 32 * (i + 1))
+          expect(key.toString('hex')).toEqual(single.publicKey.toString('hex'))
+        }
+      }
+    } finally {
+      await sim.close()
+    }
+  })
+
   test.concurrent.each(models)('show address', async function (m) {
     const sim = new Zemu(m.path)
     try {
@@ -0,0 +1,239 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "device.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "os.h"
+#include "os_io_seproxyhal.h"
+#include "app_main.h"
+#include "view.h"
+#include "coin.h"
+#include "addr.h"
+#include "crypto.h"
+#include "common/parser.h"
+#include "zxformat.h"
+
+// Sized like one review screen; values longer than this are paged
+#define REVIEW_KEY_LEN      64
+#define REVIEW_VALUE_LEN    128
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static try_context_t *try_context = NULL;
+
+static uint8_t async_reply[IO_APDU_BUFFER_SIZE];
+static uint16_t async_replyLen = 0;
+
+static viewfunc_getItem_t review_getItem = NULL;
+static viewfunc_getNumItems_t review_getNumItems = NULL;
+static viewfunc_accept_t review_accept = NULL;
+static device_review_stats_t review_stats;
+
+static uint64_t stage_ns[DEVICE_STAGE_COUNT];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static void stage_add(device_stage_e stage, uint64_t start) {
+    stage_ns[stage] += now_ns() - start;
+}
+
+// The apdu_harness target links with --wrap for these symbols, so the calls made by tx.c,
+// actions.h and parser_group.c land here first
+parser_error_t __real_parser_parse(parser_context_t *ctx, const uint8_t *data, size_t dataLen,
+                                   void *tx_obj, txn_content_e content);
+parser_error_t __real_parser_validate(parser_context_t *ctx);
+zxerr_t __real_crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen);
+zxerr_t __real_crypto_signArbitraryData(uint8_t *signature, uint16_t signatureMaxlen,
+                                        const uint8_t *dataDigest, const uint8_t *authDataDigest);
+
+parser_error_t __wrap_parser_parse(parser_context_t *ctx, const uint8_t *data, size_t dataLen,
+                                   void *tx_obj, txn_content_e content) {
+    const uint64_t start = now_ns();
+    const parser_error_t err = __real_parser_parse(ctx, data, dataLen, tx_obj, content);
+    stage_add(DEVICE_STAGE_PARSE, start);
+    return err;
+}
+
+parser_error_t __wrap_parser_validate(parser_context_t *ctx) {
+    const uint64_t start = now_ns();
+    const parser_error_t err = __real_parser_validate(ctx);
+    stage_add(DEVICE_STAGE_VALIDATE, start);
+    return err;
+}
+
+zxerr_t __wrap_crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen) {
+    const uint64_t start = now_ns();
+    const zxerr_t err = __real_crypto_sign(signature, signatureMaxlen, message, messageLen);
+    stage_add(DEVICE_STAGE_SIGN, start);
+    return err;
+}
+
+zxerr_t __wrap_crypto_signArbitraryData(uint8_t *signature, uint16_t signatureMaxlen,
+                                        const uint8_t *dataDigest, const uint8_t *authDataDigest) {
+    const uint64_t start = now_ns();
+    const zxerr_t err = __real_crypto_signArbitraryData(signature, signatureMaxlen, dataDigest, authDataDigest);
+    stage_add(DEVICE_STAGE_SIGN, start);
+    return err;
+}
+
+try_context_t *try_context_get(void) {
+    return try_context;
+}
+
+try_context_t *try_context_set(try_context_t *context) {
+    try_context_t *previous = try_context;
+    try_context = context;
+    return previous;
+}
+
+void os_longjmp(unsigned int exception) {
+    if (try_context == NULL) {
+        fprintf(stderr, "uncaught exception 0x%04x\n", exception);
+        abort();
+    }
+    longjmp(try_context->jmp_buf, (int) exception);
+}
+
+uint8_t os_global_pin_is_validated(void) {
+    return BOLOS_UX_OK;
+}
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len) {
+    (void) channel_and_flags;
+    if (tx_len > sizeof(async_reply)) {
+        tx_len = sizeof(async_reply);
+    }
+    memcpy(async_reply, G_io_apdu_buffer, tx_len);
+    async_replyLen = tx_len;
+    return 0;
+}
+
+void view_review_init(viewfunc_getItem_t viewfuncGetItem,
+                      viewfunc_getNumItems_t viewfuncGetNumItems,
+                      viewfunc_accept_t viewfuncAccept) {
+    review_getItem = viewfuncGetItem;
+    review_getNumItems = viewfuncGetNumItems;
+    review_accept = viewfuncAccept;
+}
+
+void view_review_show(review_type_e reviewKind) {
+    (void) reviewKind;
+    char key[REVIEW_KEY_LEN];
+    char value[REVIEW_VALUE_LEN];
+    uint8_t numItems = 0;
+
+    const uint64_t start = now_ns();
+    review_stats.reviews++;
+    if (review_getNumItems(&numItems) != zxerr_ok) {
+        review_stats.errors++;
+        stage_add(DEVICE_STAGE_RENDER, start);
+        return;
+    }
+
+    for (uint8_t item = 0; item < numItems; item++) {
+        uint8_t pageCount = 1;
+        for (uint8_t page = 0; page < pageCount; page++) {
+            const zxerr_t err = review_getItem((int8_t) item, key, sizeof(key), value, sizeof(value), page, &pageCount);
+            if (err == zxerr_no_data) {
+                break;
+            }
+            if (err != zxerr_ok) {
+                // The device would show an error screen and never sign
+                review_stats.errors++;
+                stage_add(DEVICE_STAGE_RENDER, start);
+                return;
+            }
+            review_stats.pages++;
+        }
+        review_stats.items++;
+    }
+    stage_add(DEVICE_STAGE_RENDER, start);
+
+    review_accept();
+}
+
+// addr.c only builds the address review on device
+zxerr_t addr_getNumItems(uint8_t *num_items) {
+    *num_items = 1;
+    return zxerr_ok;
+}
+
+zxerr_t addr_getItem(int8_t displayIdx,
+                     char *outKey, uint16_t outKeyLen,
+                     char *outVal, uint16_t outValLen,
+                     uint8_t pageIdx, uint8_t *pageCount) {
+    if (displayIdx != 0) {
+        return zxerr_no_data;
+    }
+    snprintf(outKey, outKeyLen, "Address");
+    pageString(outVal, outValLen, (char *) (G_io_apdu_buffer + PK_LEN_25519), pageIdx, pageCount);
+    return zxerr_ok;
+}
+
+uint16_t device_exchange(const uint8_t *command, uint16_t commandLen, uint8_t *reply, uint16_t replyMax,
+                         device_timing_t *timing) {
+    volatile uint32_t flags = 0;
+    volatile uint32_t tx = 0;
+
+    if (commandLen > IO_APDU_BUFFER_SIZE) {
+        return 0;
+    }
+    memcpy(G_io_apdu_buffer, command, commandLen);
+    async_replyLen = 0;
+    memset(stage_ns, 0, sizeof(stage_ns));
+
+    const uint64_t start = now_ns();
+    handleApdu(&flags, &tx, commandLen);
+    const uint64_t totalNs = now_ns() - start;
+
+    if (timing != NULL) {
+        uint64_t covered = 0;
+        for (uint8_t stage = DEVICE_STAGE_PARSE; stage < DEVICE_STAGE_COUNT; stage++) {
+            covered += stage_ns[stage];
+        }
+        memcpy(timing->stageNs, stage_ns, sizeof(stage_ns));
+        timing->stageNs[DEVICE_STAGE_BUFFERING] = totalNs > covered ? totalNs - covered : 0;
+        timing->totalNs = totalNs;
+    }
+
+    const uint8_t *data = G_io_apdu_buffer;
+    uint16_t length = (uint16_t) tx;
+    if (flags & IO_ASYNCH_REPLY) {
+        data = async_reply;
+        length = async_replyLen;
+    }
+    if (length > replyMax) {
+        length = replyMax;
+    }
+    memcpy(reply, data, length);
+    return length;
+}
+
+void device_get_review_stats(device_review_stats_t *stats) {
+    *stats = review_stats;
+}
+
+const char *device_stage_name(device_stage_e stage) {
+    static const char *const names[DEVICE_STAGE_COUNT] = {"buffering", "parse", "validate", "render", "sign"};
+    return stage < DEVICE_STAGE_COUNT ? names[stage] : "?";
+}
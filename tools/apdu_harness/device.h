@@ -0,0 +1,59 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// "buffering" is the rest of the command path: APDU dispatch, chunk handling, buffering and hashing
+typedef enum {
+    DEVICE_STAGE_BUFFERING = 0,
+    DEVICE_STAGE_PARSE,
+    DEVICE_STAGE_VALIDATE,
+    DEVICE_STAGE_RENDER,
+    DEVICE_STAGE_SIGN,
+    DEVICE_STAGE_COUNT,
+} device_stage_e;
+
+typedef struct {
+    uint64_t totalNs;
+    uint64_t stageNs[DEVICE_STAGE_COUNT];
+} device_timing_t;
+
+typedef struct {
+    uint32_t reviews;
+    uint32_t items;
+    uint32_t pages;
+    uint32_t errors;
+} device_review_stats_t;
+
+/// Runs one command APDU through handleApdu, approving any review it opens.
+/// Copies the reply (data + status word) to reply and returns its length, 0 if there was none.
+/// timing (optional) receives how long the exchange took and how that splits across stages.
+uint16_t device_exchange(const uint8_t *command, uint16_t commandLen, uint8_t *reply, uint16_t replyMax,
+                         device_timing_t *timing);
+
+const char *device_stage_name(device_stage_e stage);
+
+void device_get_review_stats(device_review_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
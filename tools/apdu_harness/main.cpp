@@ -0,0 +1,245 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+// Replays APDU sessions through handleApdu on the host and reports latency percentiles, per
+// instruction, per transaction and per stage of the command path.
+//
+//   apdu_harness [options] session [...]
+//     --iterations N     replays of each session (default 100)
+//     --cold             clear the derived key cache before each transaction
+//     --record FILE      write the first replay of the sessions as a trace
+//     --json FILE        write the percentiles as JSON
+//     --compare FILE     flag metrics slower than in a previous --json run
+//     --threshold PCT    slowdown tolerated by --compare (default 10)
+//
+// See session.h for the session formats.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+#include "device.h"
+#include "key_cache.h"
+#include "report.h"
+#include "session.h"
+
+using namespace harness;
+
+namespace {
+    struct options_t {
+        unsigned iterations = 100;
+        bool cold = false;
+        double thresholdPct = 10;
+        std::string recordPath;
+        std::string jsonPath;
+        std::string comparePath;
+        std::vector<std::string> sessions;
+    };
+
+    void usage() {
+        fprintf(stderr, "usage: apdu_harness [--iterations N] [--cold] [--record FILE] [--json FILE]\n"
+                        "                    [--compare FILE] [--threshold PCT] session [...]\n");
+    }
+
+    bool parseOptions(int argc, char **argv, options_t &options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--iterations" && hasValue) {
+                options.iterations = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--cold") {
+                options.cold = true;
+            } else if (arg == "--record" && hasValue) {
+                options.recordPath = argv[++i];
+            } else if (arg == "--json" && hasValue) {
+                options.jsonPath = argv[++i];
+            } else if (arg == "--compare" && hasValue) {
+                options.comparePath = argv[++i];
+            } else if (arg == "--threshold" && hasValue) {
+                options.thresholdPct = strtod(argv[++i], nullptr);
+            } else if (arg[0] == '-') {
+                return false;
+            } else {
+                options.sessions.push_back(arg);
+            }
+        }
+        return !options.sessions.empty() && options.iterations > 0;
+    }
+
+    uint64_t elapsedUs(const std::chrono::steady_clock::time_point &since) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - since).count());
+    }
+
+    // Replays the session, adding its samples to report; returns the number of reply mismatches
+    unsigned replay(const session_t &session, const options_t &options, TraceWriter *trace, Report &report) {
+        const auto started = std::chrono::steady_clock::now();
+        unsigned mismatches = 0;
+
+        for (unsigned iteration = 0; iteration < options.iterations; iteration++) {
+            for (const auto &transaction : session.transactions) {
+                // Derived keys do not survive a lock on device
+                if (options.cold) {
+                    key_cache_reset();
+                }
+
+                double transactionUs = 0;
+                double recordedUs = 0;
+                bool recorded = true;
+                double stageUs[DEVICE_STAGE_COUNT] = {};
+
+                for (const auto &exchange : transaction) {
+                    uint8_t reply[512];
+                    device_timing_t timing;
+                    if (trace != nullptr) {
+                        trace->command(exchange.command, elapsedUs(started));
+                    }
+                    const uint16_t replyLen = device_exchange(exchange.command.data(),
+                                                              static_cast<uint16_t>(exchange.command.size()),
+                                                              reply, sizeof(reply), &timing);
+                    if (trace != nullptr) {
+                        trace->reply(bytes(reply, reply + replyLen), elapsedUs(started));
+                    }
+
+                    const double us = static_cast<double>(timing.totalNs) / 1000;
+                    char ins[16];
+                    snprintf(ins, sizeof(ins), "INS 0x%02x", exchange.command.size() > 1 ? exchange.command[1] : 0);
+                    report.add(ins, us);
+                    report.add("all APDUs", us);
+                    transactionUs += us;
+                    for (uint8_t stage = 0; stage < DEVICE_STAGE_COUNT; stage++) {
+                        stageUs[stage] += static_cast<double>(timing.stageNs[stage]) / 1000;
+                    }
+                    if (exchange.recordedUs >= 0) {
+                        recordedUs += exchange.recordedUs;
+                    } else {
+                        recorded = false;
+                    }
+
+                    if (exchange.checkReply && bytes(reply, reply + replyLen) != exchange.expected) {
+                        if (mismatches++ == 0) {
+                            fprintf(stderr, "%s:%u: reply mismatch\n  expected %s\n  got      %s\n",
+                                    session.path.c_str(), exchange.line,
+                                    toHex(exchange.expected.data(), exchange.expected.size()).c_str(),
+                                    toHex(reply, replyLen).c_str());
+                        }
+                    }
+                }
+
+                report.add("transactions", transactionUs);
+                for (uint8_t stage = 0; stage < DEVICE_STAGE_COUNT; stage++) {
+                    report.add(std::string("stage ") + device_stage_name(static_cast<device_stage_e>(stage)),
+                               stageUs[stage]);
+                }
+                if (recorded && iteration == 0) {
+                    report.add("recorded transactions", recordedUs);
+                }
+                if (trace != nullptr) {
+                    trace->endTransaction(elapsedUs(started));
+                }
+            }
+            // Only the first replay is recorded
+            trace = nullptr;
+        }
+        return mismatches;
+    }
+
+    bool writeJson(const std::string &path, const Json::Value &value) {
+        std::ofstream out(path);
+        if (!out) {
+            fprintf(stderr, "%s: cannot create\n", path.c_str());
+            return false;
+        }
+        out << value << "\n";
+        return true;
+    }
+
+    bool readJson(const std::string &path, Json::Value &value) {
+        std::ifstream in(path);
+        Json::CharReaderBuilder builder;
+        std::string errors;
+        if (!in || !Json::parseFromStream(builder, in, &value, &errors)) {
+            fprintf(stderr, "%s: cannot read %s\n", path.c_str(), errors.c_str());
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    options_t options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    std::vector<session_t> sessions(options.sessions.size());
+    for (size_t i = 0; i < options.sessions.size(); i++) {
+        if (!loadSession(options.sessions[i], sessions[i])) {
+            return 2;
+        }
+    }
+
+    TraceWriter trace;
+    if (!options.recordPath.empty() && !trace.open(options.recordPath)) {
+        return 2;
+    }
+
+    unsigned mismatches = 0;
+    Json::Value results(Json::objectValue);
+    for (const auto &session : sessions) {
+        Report report;
+        mismatches += replay(session, options, options.recordPath.empty() ? nullptr : &trace, report);
+
+        size_t apdus = 0;
+        for (const auto &transaction : session.transactions) {
+            apdus += transaction.size();
+        }
+        char title[512];
+        snprintf(title, sizeof(title), "%s: %zu transactions, %zu APDUs x %u iterations", session.path.c_str(),
+                 session.transactions.size(), apdus, options.iterations);
+        report.print(title);
+        results[session.path] = report.toJson();
+    }
+
+    device_review_stats_t stats;
+    device_get_review_stats(&stats);
+    printf("reviews %u, items %u, pages %u, errors %u\n", stats.reviews, stats.items, stats.pages, stats.errors);
+
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results)) {
+        return 2;
+    }
+
+    unsigned regressions = 0;
+    if (!options.comparePath.empty()) {
+        Json::Value baseline;
+        if (!readJson(options.comparePath, baseline)) {
+            return 2;
+        }
+        regressions = compareRuns(baseline, results, options.thresholdPct);
+        printf("%u regressions over %.0f%% against %s\n", regressions, options.thresholdPct,
+               options.comparePath.c_str());
+    }
+
+    if (mismatches > 0 || stats.errors > 0) {
+        fprintf(stderr, "%u reply mismatches, %u review errors\n", mismatches, stats.errors);
+        return 1;
+    }
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "report.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace harness {
+    namespace {
+        // Differences below this are timer noise, whatever the relative change
+        constexpr double MIN_REGRESSION_US = 1.0;
+
+        double percentile(const std::vector<double> &sorted, double p) {
+            if (sorted.empty()) {
+                return 0;
+            }
+            const size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[rank];
+        }
+    }
+
+    void Report::add(const std::string &metric, double us) {
+        auto &samples = samples_[metric];
+        if (samples.empty()) {
+            order_.push_back(metric);
+        }
+        samples.push_back(us);
+    }
+
+    void Report::print(const std::string &title) const {
+        printf("%s\n", title.c_str());
+        printf("  %-24s %8s %10s %10s %10s %10s\n", "latency (us)", "count", "p50", "p90", "p99", "max");
+        const Json::Value summary = toJson();
+        for (const auto &metric : order_) {
+            const Json::Value &row = summary[metric];
+            printf("  %-24s %8u %10.1f %10.1f %10.1f %10.1f\n", metric.c_str(), row["count"].asUInt(),
+                   row["p50"].asDouble(), row["p90"].asDouble(), row["p99"].asDouble(), row["max"].asDouble());
+        }
+    }
+
+    Json::Value Report::toJson() const {
+        Json::Value out(Json::objectValue);
+        for (const auto &entry : samples_) {
+            std::vector<double> sorted = entry.second;
+            std::sort(sorted.begin(), sorted.end());
+
+            Json::Value row(Json::objectValue);
+            row["count"] = static_cast<Json::UInt>(sorted.size());
+            row["p50"] = percentile(sorted, 50);
+            row["p90"] = percentile(sorted, 90);
+            row["p99"] = percentile(sorted, 99);
+            row["max"] = percentile(sorted, 100);
+            out[entry.first] = row;
+        }
+        return out;
+    }
+
+    unsigned compareRuns(const Json::Value &baseline, const Json::Value &current, double thresholdPct) {
+        unsigned regressions = 0;
+        for (const auto &session : current.getMemberNames()) {
+            if (!baseline.isMember(session)) {
+                printf("%s: not in the baseline\n", session.c_str());
+                continue;
+            }
+            for (const auto &metric : current[session].getMemberNames()) {
+                if (!baseline[session].isMember(metric)) {
+                    continue;
+                }
+                for (const char *stat : {"p50", "p90"}) {
+                    const double before = baseline[session][metric][stat].asDouble();
+                    const double after = current[session][metric][stat].asDouble();
+                    if (after - before < MIN_REGRESSION_US || after <= before * (1 + thresholdPct / 100)) {
+                        continue;
+                    }
+                    printf("REGRESSION %s: %s %s %.1f -> %.1f us (+%.0f%%)\n", session.c_str(), metric.c_str(),
+                           stat, before, after, before > 0 ? (after / before - 1) * 100 : 100.0);
+                    regressions++;
+                }
+            }
+        }
+        return regressions;
+    }
+}
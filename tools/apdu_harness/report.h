@@ -0,0 +1,42 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+namespace harness {
+    // Latency samples in microseconds, per metric ("INS 0x08", "transactions", "stage parse", ...)
+    class Report {
+    public:
+        void add(const std::string &metric, double us);
+
+        void print(const std::string &title) const;
+
+        /// { metric: { count, p50, p90, p99, max } }
+        Json::Value toJson() const;
+
+    private:
+        std::map<std::string, std::vector<double>> samples_;
+        std::vector<std::string> order_;
+    };
+
+    /// Prints the metrics of current whose p50 or p90 grew by more than thresholdPct over baseline.
+    /// Both hold { session: Report::toJson() }. Returns the number of regressions.
+    unsigned compareRuns(const Json::Value &baseline, const Json::Value &current, double thresholdPct);
+}
@@ -0,0 +1,236 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include "session.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace harness {
+    namespace {
+        const char TRACE_MAGIC[] = "APDUTRC1";
+        const size_t TRACE_MAGIC_LEN = sizeof(TRACE_MAGIC) - 1;
+        const size_t TRACE_RECORD_HEADER_LEN = 1 + 8 + 2;
+
+        bool parseHex(const std::string &text, bytes &out) {
+            std::string digits;
+            for (char c : text) {
+                if (!isspace(static_cast<unsigned char>(c))) {
+                    digits.push_back(c);
+                }
+            }
+            if (digits.size() % 2 != 0) {
+                return false;
+            }
+            out.clear();
+            for (size_t i = 0; i < digits.size(); i += 2) {
+                if (!isxdigit(static_cast<unsigned char>(digits[i])) ||
+                    !isxdigit(static_cast<unsigned char>(digits[i + 1]))) {
+                    return false;
+                }
+                out.push_back(static_cast<uint8_t>(strtoul(digits.substr(i, 2).c_str(), nullptr, 16)));
+            }
+            return true;
+        }
+
+        bool loadText(const std::string &path, const std::string &content, session_t &session) {
+            transaction_t current;
+            size_t pos = 0;
+            unsigned lineNo = 0;
+            while (pos <= content.size()) {
+                size_t end = content.find('\n', pos);
+                if (end == std::string::npos) {
+                    end = content.size();
+                }
+                std::string line = content.substr(pos, end - pos);
+                pos = end + 1;
+                lineNo++;
+
+                const size_t start = line.find_first_not_of(" \t\r");
+                if (start == std::string::npos) {
+                    if (!current.empty()) {
+                        session.transactions.push_back(current);
+                        current.clear();
+                    }
+                    continue;
+                }
+                line = line.substr(start);
+                if (line[0] == '#') {
+                    continue;
+                }
+
+                const std::string marker = line.substr(0, 2);
+                bytes data;
+                if ((marker != "=>" && marker != "<=") || !parseHex(line.substr(2), data)) {
+                    fprintf(stderr, "%s:%u: expected '=> hex' or '<= hex'\n", path.c_str(), lineNo);
+                    return false;
+                }
+                if (marker == "=>") {
+                    exchange_t exchange;
+                    exchange.command = data;
+                    exchange.line = lineNo;
+                    current.push_back(exchange);
+                } else if (current.empty() || current.back().checkReply) {
+                    fprintf(stderr, "%s:%u: reply without a command\n", path.c_str(), lineNo);
+                    return false;
+                } else {
+                    current.back().expected = data;
+                    current.back().checkReply = true;
+                }
+            }
+            if (!current.empty()) {
+                session.transactions.push_back(current);
+            }
+            return true;
+        }
+
+        uint64_t readBE(const uint8_t *data, size_t len) {
+            uint64_t value = 0;
+            for (size_t i = 0; i < len; i++) {
+                value = (value << 8) | data[i];
+            }
+            return value;
+        }
+
+        bool loadTrace(const std::string &path, const std::string &content, session_t &session) {
+            const auto *data = reinterpret_cast<const uint8_t *>(content.data());
+            size_t pos = TRACE_MAGIC_LEN;
+            transaction_t current;
+            uint64_t commandTimestamp = 0;
+            unsigned index = 0;
+
+            while (pos < content.size()) {
+                if (content.size() - pos < TRACE_RECORD_HEADER_LEN) {
+                    fprintf(stderr, "%s: truncated record %u\n", path.c_str(), index);
+                    return false;
+                }
+                const char type = static_cast<char>(data[pos]);
+                const uint64_t timestamp = readBE(data + pos + 1, 8);
+                const size_t length = readBE(data + pos + 9, 2);
+                pos += TRACE_RECORD_HEADER_LEN;
+                if (content.size() - pos < length) {
+                    fprintf(stderr, "%s: truncated record %u\n", path.c_str(), index);
+                    return false;
+                }
+                const bytes payload(data + pos, data + pos + length);
+                pos += length;
+
+                if (type == 'C') {
+                    exchange_t exchange;
+                    exchange.command = payload;
+                    exchange.line = index;
+                    current.push_back(exchange);
+                    commandTimestamp = timestamp;
+                } else if (type == 'R') {
+                    if (current.empty() || current.back().checkReply) {
+                        fprintf(stderr, "%s: record %u: reply without a command\n", path.c_str(), index);
+                        return false;
+                    }
+                    current.back().expected = payload;
+                    current.back().checkReply = true;
+                    current.back().recordedUs = static_cast<double>(timestamp - commandTimestamp);
+                } else if (type == 'E') {
+                    if (!current.empty()) {
+                        session.transactions.push_back(current);
+                        current.clear();
+                    }
+                } else {
+                    fprintf(stderr, "%s: record %u: unknown type 0x%02x\n", path.c_str(), index,
+                            static_cast<uint8_t>(type));
+                    return false;
+                }
+                index++;
+            }
+            if (!current.empty()) {
+                session.transactions.push_back(current);
+            }
+            return true;
+        }
+    }
+
+    std::string toHex(const uint8_t *data, size_t len) {
+        static const char digits[] = "0123456789abcdef";
+        std::string out;
+        for (size_t i = 0; i < len; i++) {
+            out.push_back(digits[data[i] >> 4]);
+            out.push_back(digits[data[i] & 0x0F]);
+        }
+        return out;
+    }
+
+    bool loadSession(const std::string &path, session_t &session) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            fprintf(stderr, "%s: cannot open\n", path.c_str());
+            return false;
+        }
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        session.path = path;
+        session.transactions.clear();
+        if (content.compare(0, TRACE_MAGIC_LEN, TRACE_MAGIC) == 0) {
+            return loadTrace(path, content, session);
+        }
+        return loadText(path, content, session);
+    }
+
+    TraceWriter::~TraceWriter() {
+        if (file_ != nullptr) {
+            fclose(file_);
+        }
+    }
+
+    bool TraceWriter::open(const std::string &path) {
+        file_ = fopen(path.c_str(), "wb");
+        if (file_ == nullptr) {
+            fprintf(stderr, "%s: cannot create\n", path.c_str());
+            return false;
+        }
+        fwrite(TRACE_MAGIC, 1, TRACE_MAGIC_LEN, file_);
+        return true;
+    }
+
+    void TraceWriter::command(const bytes &data, uint64_t timestampUs) {
+        record('C', data.data(), static_cast<uint16_t>(data.size()), timestampUs);
+    }
+
+    void TraceWriter::reply(const bytes &data, uint64_t timestampUs) {
+        record('R', data.data(), static_cast<uint16_t>(data.size()), timestampUs);
+    }
+
+    void TraceWriter::endTransaction(uint64_t timestampUs) {
+        record('E', nullptr, 0, timestampUs);
+    }
+
+    void TraceWriter::record(char type, const uint8_t *data, uint16_t length, uint64_t timestampUs) {
+        if (file_ == nullptr) {
+            return;
+        }
+        uint8_t header[TRACE_RECORD_HEADER_LEN];
+        header[0] = static_cast<uint8_t>(type);
+        for (uint8_t i = 0; i < 8; i++) {
+            header[1 + i] = static_cast<uint8_t>(timestampUs >> (56 - 8 * i));
+        }
+        header[9] = static_cast<uint8_t>(length >> 8);
+        header[10] = static_cast<uint8_t>(length);
+        fwrite(header, 1, sizeof(header), file_);
+        if (length > 0) {
+            fwrite(data, 1, length, file_);
+        }
+    }
+}
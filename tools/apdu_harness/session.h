@@ -0,0 +1,73 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Sessions come in two formats, told apart by the trace magic:
+//
+// Text, one exchange per line in the usual APDU log notation; a blank line ends a transaction
+// and lines starting with '#' are comments:
+//   => 8008000000...     command
+//   <= ...9000           expected reply (optional, checked on every iteration)
+//
+// Trace, as written by the recorders (apdu_harness --record, cli/apdu_trace.py):
+//   "APDUTRC1"
+//   records: type (1) | timestamp (8, big endian, us since the recording started) | length (2, big endian) | data
+//   type 'C' is a command, 'R' the reply to the previous command and 'E' ends a transaction (no data).
+//   Recorded replies are checked like expected replies, and the recorded command to reply times
+//   are reported next to the replayed ones.
+
+namespace harness {
+    typedef std::vector<uint8_t> bytes;
+
+    struct exchange_t {
+        bytes command;
+        bytes expected;
+        bool checkReply = false;
+        unsigned line = 0;              // line (text) or record index (trace)
+        double recordedUs = -1;         // command to reply time in the recording, < 0 if unknown
+    };
+
+    typedef std::vector<exchange_t> transaction_t;
+
+    struct session_t {
+        std::string path;
+        std::vector<transaction_t> transactions;
+    };
+
+    bool loadSession(const std::string &path, session_t &session);
+
+    std::string toHex(const uint8_t *data, size_t len);
+
+    class TraceWriter {
+    public:
+        ~TraceWriter();
+
+        bool open(const std::string &path);
+        void command(const bytes &data, uint64_t timestampUs);
+        void reply(const bytes &data, uint64_t timestampUs);
+        void endTransaction(uint64_t timestampUs);
+
+    private:
+        void record(char type, const uint8_t *data, uint16_t length, uint64_t timestampUs);
+
+        FILE *file_ = nullptr;
+    };
+}
@@ -0,0 +1,57 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "os.h"
+#include "apdu_codes.h"
+
+#define OFFSET_CLA              0
+#define OFFSET_INS              1
+#define OFFSET_P1               2
+#define OFFSET_P2               3
+#define OFFSET_DATA_LEN         4
+#define OFFSET_DATA             5
+#define OFFSET_PAYLOAD_TYPE     OFFSET_P1
+
+#define P1_INIT                 0
+#define P1_ADD                  1
+#define P1_LAST                 2
+
+#define MAJOR_VERSION           LEDGER_MAJOR_VERSION
+#define MINOR_VERSION           LEDGER_MINOR_VERSION
+#define PATCH_VERSION           0
+#define TARGET_ID               0
+
+#define U4BE(buf, off) ((uint32_t) (((uint32_t) (buf)[(off)] << 24) | ((uint32_t) (buf)[(off) + 1] << 16) | \
+                                    ((uint32_t) (buf)[(off) + 2] << 8) | (uint32_t) (buf)[(off) + 3]))
+
+#ifndef CHECK_PIN_VALIDATED
+#define CHECK_PIN_VALIDATED()                                               \
+    if (os_global_pin_is_validated() != BOLOS_UX_OK) {                      \
+        THROW(APDU_CODE_COMMAND_NOT_ALLOWED);                               \
+    }
+#endif
+
+void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx);
+
+#ifdef __cplusplus
+}
+#endif
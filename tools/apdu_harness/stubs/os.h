@@ -0,0 +1,95 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// Stand-in for the parts of the BOLOS SDK used by the command path, so apdu_handler.c can run on
+// the host. Exceptions follow the SDK: THROW longjmps to the innermost TRY context.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define IO_APDU_BUFFER_SIZE     (5 + 255)
+#define IO_ASYNCH_REPLY         0x10
+#define IO_RETURN_AFTER_TX      0x20
+#define CHANNEL_APDU            0
+
+#define BOLOS_UX_OK             0xAA
+#define EXCEPTION_IO_RESET      0x10
+
+extern unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+typedef unsigned short exception_t;
+
+typedef struct try_context_s {
+    jmp_buf jmp_buf;
+    struct try_context_s *previous;
+    exception_t ex;
+} try_context_t;
+
+try_context_t *try_context_get(void);
+try_context_t *try_context_set(try_context_t *context);
+void os_longjmp(unsigned int exception) __attribute__((noreturn));
+
+#define THROW(x) os_longjmp(x)
+
+#define BEGIN_TRY                                                           \
+    {                                                                       \
+        try_context_t __try_context;                                        \
+        __try_context.previous = try_context_get();
+
+#define TRY                                                                 \
+        __try_context.ex = (exception_t) setjmp(__try_context.jmp_buf);     \
+        if (__try_context.ex == 0) {                                        \
+            try_context_set(&__try_context);
+
+#define CATCH(x)                                                            \
+            goto __try_finally;                                             \
+        } else if (__try_context.ex == (x)) {                               \
+            __try_context.ex = 0;                                           \
+            try_context_set(__try_context.previous);
+
+#define CATCH_OTHER(e)                                                      \
+            goto __try_finally;                                             \
+        } else {                                                            \
+            exception_t e = __try_context.ex;                               \
+            __try_context.ex = 0;                                           \
+            try_context_set(__try_context.previous);
+
+#define FINALLY                                                             \
+            goto __try_finally;                                             \
+        }                                                                   \
+    __try_finally:                                                          \
+        if (try_context_get() == &__try_context) {                          \
+            try_context_set(__try_context.previous);                        \
+        }
+
+#define END_TRY                                                             \
+        if (__try_context.ex != 0) {                                        \
+            THROW(__try_context.ex);                                        \
+        }                                                                   \
+    }
+
+uint8_t os_global_pin_is_validated(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,29 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#include "os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Captures the asynchronous reply sent once the user approves a review
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Builds an apdu_harness session from the transaction vectors of the Zemu tests.
+
+The Zemu snapshots only keep screenshots, so the APDUs are rebuilt from the `export const tx...`
+vectors in tests_zemu/tests/common.ts and chunked the way the JS client sends them: account id (4)
+in the first chunk, 250 bytes per chunk. Replies are not known ahead and are left unchecked.
+
+    zemu_to_session.py [--account N] [common.ts] > zemu.apdu
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+CLA = 0x80
+INS_SIGN_MSGPACK = 0x08
+P1_FIRST_ACCOUNT_ID = 0x01
+P1_MORE = 0x80
+P2_LAST = 0x00
+P2_MORE = 0x80
+CHUNK_SIZE = 250
+
+DEFAULT_VECTORS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               '..', '..', 'tests_zemu', 'tests', 'common.ts')
+
+ARRAY_RE = re.compile(r'export const (tx\w+)\s*=\s*\[([^\]]*)\]', re.S)
+HEX_RE = re.compile(r"export const (tx\w+)\s*=\s*'([0-9a-fA-F]*)'", re.S)
+
+
+def load_vectors(source):
+    vectors = []
+    for match in ARRAY_RE.finditer(source):
+        values = [int(v) for v in re.findall(r'\d+', match.group(2))]
+        vectors.append((match.start(), match.group(1), bytes(values)))
+    for match in HEX_RE.finditer(source):
+        vectors.append((match.start(), match.group(1), bytes.fromhex(match.group(2))))
+    return [(name, blob) for _, name, blob in sorted(vectors)]
+
+
+def sign_apdus(account, blob):
+    payload = struct.pack('>I', account) + blob
+    chunks = [payload[i:i + CHUNK_SIZE] for i in range(0, len(payload), CHUNK_SIZE)]
+    for idx, chunk in enumerate(chunks):
+        p1 = P1_FIRST_ACCOUNT_ID if idx == 0 else P1_MORE
+        p2 = P2_MORE if idx + 1 < len(chunks) else P2_LAST
+        yield bytes([CLA, INS_SIGN_MSGPACK, p1, p2, len(chunk)]) + chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('vectors', nargs='?', default=DEFAULT_VECTORS)
+    parser.add_argument('--account', type=int, default=0)
+    args = parser.parse_args()
+
+    with open(args.vectors) as f:
+        vectors = load_vectors(f.read())
+    if not vectors:
+        sys.exit('%s: no transaction vectors found' % args.vectors)
+
+    print('# Generated by zemu_to_session.py from %s' % os.path.basename(args.vectors))
+    for name, blob in vectors:
+        print()
+        print('# %s, %d bytes' % (name, len(blob)))
+        for apdu in sign_apdus(args.account, blob):
+            print('=> ' + apdu.hex())
+
+
+if __name__ == '__main__':
+    main()
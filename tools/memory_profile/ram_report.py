@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Reports the static RAM (.data and .bss) each module reserves.
+
+Sizes come from `nm` on the given objects or static libraries, grouped by object file. For a
+device build pass the objects of build/<device>/obj with `--nm arm-none-eabi-nm`; the host
+library (build/libapp_lib.a) gives the same breakdown with host alignment. Constants and NVM
+storage live in flash and are not counted.
+
+    ram_report.py [--nm NM] [--top N] [--json out.json] [--baseline old.json] FILE...
+
+With --baseline, exits with an error when a module grew by more than --tolerance bytes.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+DATA_TYPES = 'dDgG'
+BSS_TYPES = 'bBsSC'
+
+
+def read_symbols(nm, path):
+    out = subprocess.run([nm, '--print-size', '--size-sort', path],
+                         check=True, capture_output=True, text=True).stdout
+    module = os.path.basename(path)
+    for line in out.splitlines():
+        if line.endswith(':'):
+            # Archive member header, e.g. "parser_impl.c.o:"
+            module = line[:-1]
+            continue
+        fields = line.split()
+        if len(fields) != 4:
+            continue
+        size, kind, name = int(fields[1], 16), fields[2], fields[3]
+        yield module, kind, name, size
+
+
+def collect(nm, paths):
+    modules = {}
+    for path in paths:
+        for module, kind, name, size in read_symbols(nm, path):
+            if kind in DATA_TYPES:
+                section = 'data'
+            elif kind in BSS_TYPES:
+                section = 'bss'
+            else:
+                continue
+            entry = modules.setdefault(module, {'data': 0, 'bss': 0, 'symbols': {}})
+            entry[section] += size
+            entry['symbols'][name] = size
+    for entry in modules.values():
+        entry['total'] = entry['data'] + entry['bss']
+    return modules
+
+
+def print_report(modules, top):
+    width = max([len('module')] + [len(m) for m in modules])
+    row = '%-' + str(width) + 's %8s %8s %8s  %s'
+    print(row % ('module', 'data', 'bss', 'total', 'largest'))
+    for module, entry in sorted(modules.items(), key=lambda m: -m[1]['total']):
+        largest = sorted(entry['symbols'].items(), key=lambda s: -s[1])[:top]
+        print(row % (module, entry['data'], entry['bss'], entry['total'],
+                     ', '.join('%s %d' % s for s in largest)))
+    print(row % ('total',
+                 sum(e['data'] for e in modules.values()),
+                 sum(e['bss'] for e in modules.values()),
+                 sum(e['total'] for e in modules.values()), ''))
+
+
+def compare(modules, baseline, tolerance):
+    regressions = 0
+    for module, entry in sorted(modules.items()):
+        before = baseline.get(module, {}).get('total', 0)
+        if entry['total'] > before + tolerance:
+            print('REGRESSION %s: %d -> %d bytes' % (module, before, entry['total']))
+            regressions += 1
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('files', nargs='+', help='object files or static libraries')
+    parser.add_argument('--nm', default='nm')
+    parser.add_argument('--top', type=int, default=3, help='largest symbols listed per module')
+    parser.add_argument('--json', help='write the report as JSON')
+    parser.add_argument('--baseline', help='JSON report to compare against')
+    parser.add_argument('--tolerance', type=int, default=0, help='bytes a module may grow by')
+    args = parser.parse_args()
+
+    modules = collect(args.nm, args.files)
+    print_report(modules, args.top)
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(modules, f, indent=2, sort_keys=True)
+            f.write('\n')
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            regressions = compare(modules, json.load(f), args.tolerance)
+        print('%d regressions over %d bytes against %s' % (regressions, args.tolerance, args.baseline))
+        sys.exit(1 if regressions else 0)
+
+
+if __name__ == '__main__':
+    main()
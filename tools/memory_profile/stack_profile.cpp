@@ -0,0 +1,261 @@
+/*******************************************************************************
+*   (c) 2018 - 2025 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+// Measures the peak stack depth of the parser and signing entry points over test vectors.
+// Every call runs on its own stack, painted beforehand; the deepest byte that lost the paint
+// gives the peak. Figures are for the host ABI: use them to track changes, not as device sizes.
+//
+//   stack_profile [options] [vectors.json ...]
+//     --arbitrary FILE    vectors in FILE are arbitrary sign requests
+//     --json FILE         write the peaks as JSON
+//     --baseline FILE     fail when a peak grew by more than --tolerance percent over FILE
+//     --tolerance PCT     default 5
+//
+// Vector files use the tests/testcases layout ([{"name", "blob"}, ...]); a vector with
+// "content": "arbitrary" is an arbitrary sign request, otherwise it is msgpack.
+
+#include <ucontext.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <json/json.h>
+#include <hexutils.h>
+
+#include "common/parser.h"
+#include "parser_txdef.h"
+#include "crypto.h"
+#include "key_cache.h"
+
+namespace {
+    constexpr size_t STACK_SIZE = 1u << 20;
+    constexpr uint8_t PAINT = 0xA5;
+
+    struct vector_t {
+        std::string name;
+        std::vector<uint8_t> blob;
+        txn_content_e content;
+    };
+
+    struct peak_t {
+        size_t bytes = 0;
+        std::string vector;
+    };
+
+    alignas(16) uint8_t entry_stack[STACK_SIZE];
+    ucontext_t caller_context;
+    ucontext_t entry_context;
+    const std::function<void()> *entry_body = nullptr;
+
+    // Parser state lives here rather than on the measured stack
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    parser_arbitrary_data_t arbitrary_obj;
+
+    void trampoline() {
+        (*entry_body)();
+    }
+
+    size_t measure(const std::function<void()> &body) {
+        memset(entry_stack, PAINT, sizeof(entry_stack));
+        getcontext(&entry_context);
+        entry_context.uc_stack.ss_sp = entry_stack;
+        entry_context.uc_stack.ss_size = sizeof(entry_stack);
+        entry_context.uc_link = &caller_context;
+        entry_body = &body;
+        makecontext(&entry_context, trampoline, 0);
+        swapcontext(&caller_context, &entry_context);
+
+        // The stack grows down: everything above the first repainted byte was used
+        size_t untouched = 0;
+        while (untouched < sizeof(entry_stack) && entry_stack[untouched] == PAINT) {
+            untouched++;
+        }
+        return sizeof(entry_stack) - untouched;
+    }
+
+    void record(std::map<std::string, peak_t> &peaks, const std::string &entry, size_t bytes,
+                const std::string &vector) {
+        peak_t &peak = peaks[entry];
+        if (bytes > peak.bytes) {
+            peak.bytes = bytes;
+            peak.vector = vector;
+        }
+    }
+
+    bool loadVectors(const std::string &path, bool arbitrary, std::vector<vector_t> &vectors) {
+        std::ifstream in(path);
+        Json::Value root;
+        Json::CharReaderBuilder builder;
+        std::string errors;
+        if (!in || !Json::parseFromStream(builder, in, &root, &errors) || !root.isArray()) {
+            fprintf(stderr, "%s: cannot read %s\n", path.c_str(), errors.c_str());
+            return false;
+        }
+
+        for (const auto &entry : root) {
+            // Vectors that are expected to fail are still parsed as far as they go
+            const std::string hex = entry["blob"].asString();
+            vector_t vector;
+            vector.name = entry["name"].asString();
+            vector.blob.resize(hex.size() / 2);
+            if (parseHexString(vector.blob.data(), (uint16_t) vector.blob.size(), hex.c_str()) != vector.blob.size()) {
+                fprintf(stderr, "%s: %s: bad blob\n", path.c_str(), vector.name.c_str());
+                return false;
+            }
+            vector.content = arbitrary || entry["content"].asString() == "arbitrary" ? ArbitraryData : MsgPack;
+            vectors.push_back(std::move(vector));
+        }
+        return true;
+    }
+
+    void profileVector(const vector_t &vector, std::map<std::string, peak_t> &peaks) {
+        parser_error_t err = parser_unexpected_error;
+        void *obj = vector.content == MsgPack ? static_cast<void *>(&tx_obj) : static_cast<void *>(&arbitrary_obj);
+
+        // Signer checks derive the key, so every vector starts from an empty cache
+        key_cache_reset();
+        memset(&ctx, 0, sizeof(ctx));
+        memset(&tx_obj, 0, sizeof(tx_obj));
+        memset(&arbitrary_obj, 0, sizeof(arbitrary_obj));
+        record(peaks, "parser_parse", measure([&] {
+            err = parser_parse(&ctx, vector.blob.data(), vector.blob.size(), obj, vector.content);
+        }), vector.name);
+        if (err != parser_ok) {
+            printf("%s: %s\n", vector.name.c_str(), parser_getErrorDescription(err));
+            return;
+        }
+
+        record(peaks, "parser_validate", measure([&] { err = parser_validate(&ctx); }), vector.name);
+        if (err != parser_ok) {
+            printf("%s: %s\n", vector.name.c_str(), parser_getErrorDescription(err));
+            return;
+        }
+
+        uint8_t numItems = 0;
+        parser_getNumItems(&numItems);
+        for (uint8_t idx = 0; idx < numItems; idx++) {
+            uint8_t pageCount = 1;
+            for (uint8_t page = 0; page < pageCount; page++) {
+                char key[40];
+                char value[40];
+                record(peaks, "parser_getItem", measure([&] {
+                    parser_getItem(&ctx, idx, key, sizeof(key), value, sizeof(value), page, &pageCount);
+                }), vector.name);
+            }
+        }
+
+        if (vector.content == ArbitraryData) {
+            // What app_sign_arbitrary runs after approval, with the key derived from scratch
+            key_cache_reset();
+            record(peaks, "app_sign_arbitrary", measure([&] {
+                uint8_t signature[ED25519_SIGNATURE_SIZE];
+                crypto_signArbitraryData(signature, sizeof(signature),
+                                         arbitrary_obj.dataDigest, arbitrary_obj.authDataDigest);
+            }), vector.name);
+        }
+    }
+
+    unsigned compareBaseline(const std::string &path, const std::map<std::string, peak_t> &peaks, double tolerancePct) {
+        std::ifstream in(path);
+        Json::Value baseline;
+        Json::CharReaderBuilder builder;
+        std::string errors;
+        if (!in || !Json::parseFromStream(builder, in, &baseline, &errors)) {
+            fprintf(stderr, "%s: cannot read %s\n", path.c_str(), errors.c_str());
+            return 1;
+        }
+
+        unsigned regressions = 0;
+        for (const auto &peak : peaks) {
+            if (!baseline.isMember(peak.first)) {
+                continue;
+            }
+            const double before = baseline[peak.first]["bytes"].asDouble();
+            if (static_cast<double>(peak.second.bytes) > before * (1 + tolerancePct / 100)) {
+                printf("REGRESSION %s: %.0f -> %zu bytes (%s)\n", peak.first.c_str(), before, peak.second.bytes,
+                       peak.second.vector.c_str());
+                regressions++;
+            }
+        }
+        return regressions;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::vector<vector_t> vectors;
+    std::string jsonPath;
+    std::string baselinePath;
+    double tolerancePct = 5;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--arbitrary" && hasValue) {
+            if (!loadVectors(argv[++i], true, vectors)) {
+                return 2;
+            }
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            tolerancePct = strtod(argv[++i], nullptr);
+        } else if (arg[0] == '-') {
+            fprintf(stderr, "usage: stack_profile [--arbitrary FILE] [--json FILE] [--baseline FILE] "
+                            "[--tolerance PCT] [vectors.json ...]\n");
+            return 2;
+        } else if (!loadVectors(arg, false, vectors)) {
+            return 2;
+        }
+    }
+    if (vectors.empty()) {
+        fprintf(stderr, "no vectors\n");
+        return 2;
+    }
+
+    std::map<std::string, peak_t> peaks;
+    for (const auto &vector : vectors) {
+        profileVector(vector, peaks);
+    }
+
+    Json::Value results(Json::objectValue);
+    printf("%-20s %10s  %s\n", "peak stack", "bytes", "vector");
+    for (const auto &peak : peaks) {
+        printf("%-20s %10zu  %s\n", peak.first.c_str(), peak.second.bytes, peak.second.vector.c_str());
+        results[peak.first]["bytes"] = static_cast<Json::UInt64>(peak.second.bytes);
+        results[peak.first]["vector"] = peak.second.vector;
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        if (!out) {
+            fprintf(stderr, "%s: cannot create\n", jsonPath.c_str());
+            return 2;
+        }
+        out << results << "\n";
+    }
+
+    if (!baselinePath.empty()) {
+        const unsigned regressions = compareBaseline(baselinePath, peaks, tolerancePct);
+        printf("%u regressions over %.0f%% against %s\n", regressions, tolerancePct, baselinePath.c_str());
+        return regressions > 0 ? 1 : 0;
+    }
+    return 0;
+}